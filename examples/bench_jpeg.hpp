@@ -0,0 +1,137 @@
+#pragma once
+
+// JPEG files of the host bench. Encoded by Pillow at quality 85 with
+// optimized Huffman tables; the references are Pillow's decode of the
+// same files truncated to RGB565.
+
+#include <cstdint>
+
+// 16x16 gradient with a checker, 4:2:0
+static const uint8_t jpeg_420[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+    0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43, 0x00, 0x05, 0x03, 0x04, 0x04, 0x04, 0x03, 0x05,
+    0x04, 0x04, 0x04, 0x05, 0x05, 0x05, 0x06, 0x07, 0x0C, 0x08, 0x07, 0x07, 0x07, 0x07, 0x0F, 0x0B,
+    0x0B, 0x09, 0x0C, 0x11, 0x0F, 0x12, 0x12, 0x11, 0x0F, 0x11, 0x11, 0x13, 0x16, 0x1C, 0x17, 0x13,
+    0x14, 0x1A, 0x15, 0x11, 0x11, 0x18, 0x21, 0x18, 0x1A, 0x1D, 0x1D, 0x1F, 0x1F, 0x1F, 0x13, 0x17,
+    0x22, 0x24, 0x22, 0x1E, 0x24, 0x1C, 0x1E, 0x1F, 0x1E, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x05, 0x05,
+    0x05, 0x07, 0x06, 0x07, 0x0E, 0x08, 0x08, 0x0E, 0x1E, 0x14, 0x11, 0x14, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0xFF, 0xC0,
+    0x00, 0x11, 0x08, 0x00, 0x10, 0x00, 0x10, 0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11,
+    0x01, 0xFF, 0xC4, 0x00, 0x15, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x07, 0xFF, 0xC4, 0x00, 0x24, 0x10, 0x00, 0x00, 0x03,
+    0x06, 0x07, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x11, 0x13,
+    0x00, 0x01, 0x12, 0x14, 0x31, 0x61, 0x02, 0x06, 0x07, 0x15, 0x17, 0x22, 0x92, 0x83, 0xFF, 0xC4,
+    0x00, 0x15, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x03, 0x05, 0xFF, 0xC4, 0x00, 0x1A, 0x11, 0x00, 0x02, 0x02, 0x03, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x04, 0x05, 0x21, 0x32,
+    0x61, 0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0x9C,
+    0x85, 0x00, 0x3F, 0x4F, 0x9E, 0xE3, 0xC1, 0xB9, 0xCF, 0xFC, 0x93, 0x4F, 0xD1, 0x9C, 0x76, 0xA3,
+    0x2E, 0x0A, 0x00, 0x7E, 0x9F, 0x42, 0x78, 0x1E, 0x27, 0x3F, 0xF2, 0x4D, 0x3F, 0x46, 0x71, 0xDA,
+    0x8C, 0xB0, 0x2B, 0x2F, 0xF1, 0xF1, 0x74, 0xDC, 0xA7, 0xEC, 0x8A, 0x69, 0xFA, 0x33, 0x8E, 0xD4,
+    0x65, 0xA1, 0x39, 0x7F, 0x8F, 0x4B, 0xA6, 0xE5, 0x3F, 0x64, 0x53, 0x4F, 0xD1, 0x9C, 0x76, 0xA3,
+    0x5E, 0x9D, 0x7B, 0xD0, 0x94, 0xD9, 0x75, 0xC9, 0xFF, 0xD9
+};
+
+static const uint16_t jpeg_420_ref[16 * 16] = {
+    0x000E, 0x000E, 0x080F, 0x180F, 0x7258, 0x8258, 0x8A58, 0x9278, 0x580F, 0x600F, 0x700F, 0x782F,
+    0xD258, 0xE258, 0xEA58, 0xF279, 0x002E, 0x002E, 0x082E, 0x100E, 0x7AD9, 0x82B9, 0x9299, 0x9AB9,
+    0x500E, 0x602F, 0x682E, 0x700E, 0xDAD9, 0xE2B9, 0xF299, 0xFAB9, 0x006E, 0x08AF, 0x10AF, 0x186E,
+    0x7B19, 0x82D8, 0x92F9, 0xA319, 0x506E, 0x60AF, 0x70AF, 0x786E, 0xDB19, 0xE2F8, 0xEAD8, 0xFB1A,
+    0x010F, 0x00CE, 0x08AE, 0x2110, 0x7318, 0x8B9A, 0x9379, 0x9B38, 0x590F, 0x60CE, 0x68CE, 0x8130,
+    0xD318, 0xEB99, 0xFB79, 0xF359, 0x4B97, 0x53D9, 0x63F9, 0x6377, 0x316F, 0x310E, 0x412E, 0x514F,
+    0xA398, 0xB3D9, 0xC3F9, 0xC397, 0x916F, 0x910E, 0xA12F, 0xA970, 0x5438, 0x4C18, 0x5C18, 0x6C39,
+    0x216E, 0x39AF, 0x41CF, 0x498E, 0xAC39, 0xAC18, 0xBC18, 0xCC39, 0x816E, 0x99AF, 0xA1AF, 0xA18F,
+    0x5498, 0x5498, 0x6499, 0x74B9, 0x21CE, 0x31EE, 0x420F, 0x49EE, 0xAC99, 0xB498, 0xC4B9, 0xD4D9,
+    0x81CE, 0x91EE, 0xA20F, 0xA1EF, 0x4CF8, 0x54F8, 0x5CD8, 0x64D8, 0x2A6F, 0x326F, 0x426F, 0x4A4E,
+    0xACF9, 0xB4F8, 0xBCF8, 0xCCD8, 0x8A6F, 0x926F, 0xA26F, 0xA26F, 0x02AE, 0x02CE, 0x12CF, 0x22EF,
+    0x7538, 0x8539, 0x9539, 0x9D59, 0x52AE, 0x62CE, 0x72CE, 0x7ACF, 0xD538, 0xE539, 0xF559, 0xFD7A,
+    0x032E, 0x034F, 0x0B2F, 0x1B0E, 0x7DD9, 0x85B9, 0x8D98, 0x9D99, 0x5B2F, 0x632F, 0x6B2E, 0x730E,
+    0xDDD9, 0xE5B9, 0xED99, 0xF5B9, 0x036E, 0x03AF, 0x13AF, 0x136E, 0x7E39, 0x85F8, 0x8DD8, 0x9E19,
+    0x536E, 0x63AF, 0x738F, 0x736E, 0xDE19, 0xE5F8, 0xEDD8, 0xFE19, 0x03EE, 0x03CD, 0x0BAE, 0x242F,
+    0x6E38, 0x8E99, 0x9699, 0x9658, 0x5BEF, 0x5BCE, 0x63AD, 0x842F, 0xCE38, 0xEE99, 0xF699, 0xF659,
+    0x4ED8, 0x56F9, 0x6719, 0x66B8, 0x2C90, 0x2C0E, 0x3C2E, 0x4C6F, 0xA6D8, 0xB6F9, 0xC719, 0xC6B7,
+    0x8C8F, 0x8C0E, 0x9C2E, 0xAC6F, 0x4F38, 0x4F18, 0x5F38, 0x6F59, 0x248E, 0x3CCF, 0x44CF, 0x4C8E,
+    0xAF59, 0xAF18, 0xBF18, 0xCF59, 0x848E, 0x9CAF, 0xA4CF, 0xA48F, 0x4F78, 0x5778, 0x5F99, 0x77B9,
+    0x24CE, 0x34EF, 0x450F, 0x4CEE, 0xA778, 0xB778, 0xC799, 0xD7B9, 0x84CE, 0x94EE, 0xA50F, 0xAD0F,
+    0x57D9, 0x5FD9, 0x67D9, 0x6FB9, 0x3570, 0x3D4F, 0x4D4F, 0x4D2F, 0xB7F9, 0xB7D9, 0xC7D9, 0xCFB9,
+    0x954F, 0x9D4F, 0xA52F, 0xAD2F
+};
+
+// Same picture at 4:4:4 with a restart marker after every MCU
+static const uint8_t jpeg_444_dri[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+    0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43, 0x00, 0x05, 0x03, 0x04, 0x04, 0x04, 0x03, 0x05,
+    0x04, 0x04, 0x04, 0x05, 0x05, 0x05, 0x06, 0x07, 0x0C, 0x08, 0x07, 0x07, 0x07, 0x07, 0x0F, 0x0B,
+    0x0B, 0x09, 0x0C, 0x11, 0x0F, 0x12, 0x12, 0x11, 0x0F, 0x11, 0x11, 0x13, 0x16, 0x1C, 0x17, 0x13,
+    0x14, 0x1A, 0x15, 0x11, 0x11, 0x18, 0x21, 0x18, 0x1A, 0x1D, 0x1D, 0x1F, 0x1F, 0x1F, 0x13, 0x17,
+    0x22, 0x24, 0x22, 0x1E, 0x24, 0x1C, 0x1E, 0x1F, 0x1E, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x05, 0x05,
+    0x05, 0x07, 0x06, 0x07, 0x0E, 0x08, 0x08, 0x0E, 0x1E, 0x14, 0x11, 0x14, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E,
+    0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0xFF, 0xC0,
+    0x00, 0x11, 0x08, 0x00, 0x10, 0x00, 0x10, 0x03, 0x01, 0x11, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11,
+    0x01, 0xFF, 0xC4, 0x00, 0x15, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x07, 0xFF, 0xC4, 0x00, 0x24, 0x10, 0x00, 0x00, 0x03,
+    0x06, 0x07, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x11, 0x13,
+    0x00, 0x01, 0x12, 0x14, 0x31, 0x61, 0x02, 0x06, 0x07, 0x15, 0x17, 0x22, 0x92, 0x83, 0xFF, 0xC4,
+    0x00, 0x18, 0x01, 0x00, 0x02, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x04, 0x07, 0x01, 0x05, 0x06, 0xFF, 0xC4, 0x00, 0x1A, 0x11, 0x00, 0x02, 0x03,
+    0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x03,
+    0x04, 0x31, 0x21, 0x61, 0xFF, 0xDD, 0x00, 0x04, 0x00, 0x01, 0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01,
+    0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3F, 0x00, 0x9C, 0x85, 0x00, 0x3F, 0x4F, 0x9E, 0xE3, 0xC1,
+    0xB9, 0xCF, 0xFC, 0x93, 0x4F, 0xD1, 0x9C, 0x76, 0xA3, 0x31, 0x27, 0xBC, 0x08, 0xA5, 0x9E, 0x1F,
+    0xFF, 0xD0, 0x1C, 0x28, 0x01, 0xFA, 0x7D, 0x09, 0xE0, 0x78, 0x9C, 0xFF, 0x00, 0xC9, 0x34, 0xFD,
+    0x19, 0xC7, 0x6A, 0x36, 0xAE, 0x7B, 0xC3, 0x05, 0x4B, 0x2C, 0x3F, 0xFF, 0xD1, 0x50, 0x2B, 0x2F,
+    0xF1, 0xF1, 0x74, 0xDC, 0xA7, 0xEC, 0x8A, 0x69, 0xFA, 0x33, 0x8E, 0xD4, 0x6B, 0x29, 0xEF, 0x7A,
+    0x2C, 0xD5, 0x33, 0xCE, 0x9F, 0xFF, 0xD2, 0xA0, 0x84, 0xE5, 0xFE, 0x3D, 0x2E, 0x9B, 0x94, 0xFD,
+    0x91, 0x4D, 0x3F, 0x46, 0x71, 0xDA, 0x8C, 0x3C, 0xF7, 0xFD, 0x25, 0x4B, 0x2C, 0xE9, 0xFF, 0xD9
+};
+
+static const uint16_t jpeg_444_dri_ref[16 * 16] = {
+    0x000F, 0x080F, 0x100F, 0x200F, 0x7258, 0x8258, 0x8A58, 0x9A58, 0x580F, 0x600F, 0x700F, 0x800F,
+    0xD258, 0xE258, 0xEA58, 0xFA79, 0x002E, 0x002F, 0x100E, 0x180E, 0x7AD9, 0x82B9, 0x9299, 0x9AB9,
+    0x500E, 0x602F, 0x680F, 0x780E, 0xDAD9, 0xE2B9, 0xF299, 0xFAB9, 0x006E, 0x088F, 0x108F, 0x184E,
+    0x7B19, 0x82F8, 0x92F8, 0xA319, 0x506E, 0x688F, 0x708F, 0x784E, 0xDB19, 0xE2F8, 0xEAD8, 0xFB19,
+    0x010F, 0x00CE, 0x08AE, 0x2110, 0x7338, 0x8B99, 0x9379, 0x9B38, 0x590F, 0x60CE, 0x68AE, 0x8130,
+    0xCB38, 0xEB99, 0xF399, 0xFB59, 0x43B8, 0x53D9, 0x63F9, 0x6377, 0x298F, 0x292E, 0x392E, 0x496F,
+    0xA3B8, 0xB3D9, 0xC3F9, 0xC398, 0x898F, 0x892E, 0x992E, 0xB16F, 0x4C58, 0x4C18, 0x5C18, 0x6C59,
+    0x218E, 0x31CE, 0x41CF, 0x418E, 0xA438, 0xAC18, 0xBC18, 0xCC59, 0x818E, 0x91CF, 0xA1CF, 0xA18E,
+    0x4CB9, 0x5498, 0x6499, 0x74B9, 0x21EE, 0x320E, 0x420F, 0x49EE, 0xACB9, 0xB499, 0xC4B9, 0xD4B9,
+    0x81CE, 0x89EE, 0xA20E, 0xA9EF, 0x4CF9, 0x54D9, 0x64D9, 0x6CB8, 0x2A6F, 0x326F, 0x426F, 0x4A4F,
+    0xACD9, 0xB4D9, 0xC4D9, 0xCCB9, 0x8A6F, 0x926F, 0xA24F, 0xAA4F, 0x02AE, 0x02CF, 0x12AF, 0x22CF,
+    0x7538, 0x8538, 0x9559, 0x9D59, 0x52AE, 0x62AF, 0x72AF, 0x7ACF, 0xD538, 0xE539, 0xF559, 0xFD59,
+    0x032F, 0x0B2F, 0x130F, 0x1AEE, 0x7DD9, 0x85B9, 0x8D98, 0x9D99, 0x5B2F, 0x632F, 0x730F, 0x7AEE,
+    0xDDD9, 0xE5B9, 0xED98, 0xFD99, 0x038E, 0x03AF, 0x13AF, 0x1B6E, 0x7E39, 0x7DF8, 0x8DF8, 0x9E19,
+    0x536E, 0x63AF, 0x738F, 0x7B6E, 0xDE39, 0xDE18, 0xEDF8, 0xFE19, 0x040E, 0x03CE, 0x0BAE, 0x242F,
+    0x6E37, 0x86B9, 0x9699, 0x9658, 0x5C0E, 0x5BCE, 0x6BAE, 0x840F, 0xCE37, 0xE699, 0xF699, 0xF658,
+    0x4EB8, 0x5EF9, 0x6EFA, 0x6698, 0x3490, 0x2C2E, 0x3C2E, 0x4C4F, 0xA6B8, 0xB6D9, 0xCEFA, 0xC698,
+    0x8C90, 0x8C0E, 0x9C0E, 0xAC4F, 0x4F39, 0x56F8, 0x6719, 0x7739, 0x248F, 0x34CF, 0x44D0, 0x4C8F,
+    0xAF39, 0xB6F8, 0xBEF9, 0xD739, 0x848E, 0x9CAF, 0xA4AF, 0xAC8F, 0x4798, 0x4F78, 0x6799, 0x77B9,
+    0x1CEE, 0x350E, 0x452F, 0x4D0F, 0xA798, 0xAF78, 0xC799, 0xD7B9, 0x84EE, 0x94EE, 0xA50F, 0xACEE,
+    0x4FF9, 0x57F9, 0x5FF9, 0x6FD8, 0x2D8F, 0x356F, 0x3D6F, 0x454E, 0xAFF8, 0xB7F8, 0xC7D8, 0xCFD8,
+    0x8D8F, 0x956E, 0xA54E, 0xAD4E
+};
+
+// 8x8 grey, progressive
+static const uint8_t jpeg_progressive[] = {
+    0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x10, 0x4A, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+    0x00, 0x01, 0x00, 0x00, 0xFF, 0xDB, 0x00, 0x43, 0x00, 0x05, 0x03, 0x04, 0x04, 0x04, 0x03, 0x05,
+    0x04, 0x04, 0x04, 0x05, 0x05, 0x05, 0x06, 0x07, 0x0C, 0x08, 0x07, 0x07, 0x07, 0x07, 0x0F, 0x0B,
+    0x0B, 0x09, 0x0C, 0x11, 0x0F, 0x12, 0x12, 0x11, 0x0F, 0x11, 0x11, 0x13, 0x16, 0x1C, 0x17, 0x13,
+    0x14, 0x1A, 0x15, 0x11, 0x11, 0x18, 0x21, 0x18, 0x1A, 0x1D, 0x1D, 0x1F, 0x1F, 0x1F, 0x13, 0x17,
+    0x22, 0x24, 0x22, 0x1E, 0x24, 0x1C, 0x1E, 0x1F, 0x1E, 0xFF, 0xC2, 0x00, 0x0B, 0x08, 0x00, 0x08,
+    0x00, 0x08, 0x01, 0x01, 0x11, 0x00, 0xFF, 0xC4, 0x00, 0x14, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0xFF, 0xDA, 0x00, 0x08,
+    0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x23, 0xFF, 0xC4, 0x00, 0x14, 0x10, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xDA, 0x00,
+    0x08, 0x01, 0x01, 0x00, 0x01, 0x05, 0x02, 0x7F, 0xFF, 0xC4, 0x00, 0x14, 0x10, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xDA,
+    0x00, 0x08, 0x01, 0x01, 0x00, 0x06, 0x3F, 0x02, 0x7F, 0xFF, 0xC4, 0x00, 0x14, 0x10, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
+    0xDA, 0x00, 0x08, 0x01, 0x01, 0x00, 0x01, 0x3F, 0x21, 0x7F, 0xFF, 0xDA, 0x00, 0x08, 0x01, 0x01,
+    0x00, 0x00, 0x00, 0x10, 0xFF, 0x00, 0xFF, 0xC4, 0x00, 0x14, 0x10, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xDA, 0x00, 0x08,
+    0x01, 0x01, 0x00, 0x01, 0x3F, 0x10, 0x7F, 0xFF, 0xD9
+};
@@ -0,0 +1,443 @@
+// Host benchmark - runs the drawing primitives against the emulated panel
+// and reports the SPI traffic each one generates. Exits non-zero when a
+// primitive's traffic differs from its expected row, so ctest catches
+// regressions; update the row when a change is meant to alter traffic.
+//
+// Usage: host_bench [snapshot.ppm]
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include "st7789.hpp"
+#include "st7789_core.hpp"
+#include "bench_jpeg.hpp"
+
+using st7789::BusStats;
+
+// Counts that depend on thread timing are not checked
+static const uint32_t ANY = 0xFFFFFFFF;
+
+// Bus traffic a case must produce
+struct Traffic {
+    uint32_t bytes;
+    uint32_t cs;
+    uint32_t dc;
+    uint32_t commands;
+    uint32_t pixels;
+    uint32_t dma;
+};
+
+static bool matches(uint32_t got, uint32_t expected) {
+    return expected == ANY || got == expected;
+}
+
+struct BenchCase {
+    const char* name;
+    Traffic expected;
+    void (*run)(st7789::ST7789& lcd);
+};
+
+static const uint16_t test_image[16 * 16] = {
+#define ROW(c) c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c
+    ROW(0xF800), ROW(0xF800), ROW(0xF800), ROW(0xF800),
+    ROW(0x07E0), ROW(0x07E0), ROW(0x07E0), ROW(0x07E0),
+    ROW(0x001F), ROW(0x001F), ROW(0x001F), ROW(0x001F),
+    ROW(0xFFFF), ROW(0xFFFF), ROW(0xFFFF), ROW(0xFFFF)
+#undef ROW
+};
+
+// 64x32 badge as an RLE blob, red over blue in runs of 128 pixels
+static const uint8_t badge_rle[] = {
+    'S', 'I', 1, 0, 64, 0, 32, 0,
+#define RUN(lo, hi) 0xFF, lo, hi
+    RUN(0x00, 0xF8), RUN(0x00, 0xF8), RUN(0x00, 0xF8), RUN(0x00, 0xF8),
+    RUN(0x00, 0xF8), RUN(0x00, 0xF8), RUN(0x00, 0xF8), RUN(0x00, 0xF8),
+    RUN(0x1F, 0x00), RUN(0x1F, 0x00), RUN(0x1F, 0x00), RUN(0x1F, 0x00),
+    RUN(0x1F, 0x00), RUN(0x1F, 0x00), RUN(0x1F, 0x00), RUN(0x1F, 0x00)
+#undef RUN
+};
+
+// 16-color palette of the indexed framebuffer case
+static const uint16_t ui_palette[16] = {
+    0x0000, 0xF800, 0x07E0, 0x001F, 0xFFE0, 0x07FF, 0xF81F, 0xFFFF,
+    0x8410, 0x4208, 0xFD20, 0x0010, 0x0400, 0x8000, 0xC618, 0x2104
+};
+
+// Tiles of the last display list update, reported after the table
+static uint16_t dlist_sent;
+static uint16_t dlist_skipped;
+
+// Queue statistics of the pipeline case
+static uint32_t pipe_pushed;
+static uint16_t pipe_max_depth;
+static uint32_t pipe_stalls;
+
+// Cells redrawn for the last terminal line
+static uint32_t term_cells;
+static uint32_t term_windows;
+
+// Pixels and windows of the last sprite move
+static uint32_t sprite_pixels;
+static uint32_t sprite_windows;
+
+// JPEG pixels off the reference by more than JPEG_TOLERANCE per channel,
+// in RGB565 steps. Replicated chroma and integer IDCT rounding stay within it.
+static const int JPEG_TOLERANCE = 2;
+static int jpeg_bad;
+
+// Count the pixels of a decoded 16x16 JPEG at x, y that miss the reference
+static void checkJpeg(st7789::ST7789& lcd, bool ok, int16_t x, int16_t y, const uint16_t* ref) {
+    if (!ok) {
+        jpeg_bad += 16 * 16;
+        return;
+    }
+    st7789::Emulator& emu = lcd.hal().emulator();
+    for (int i = 0; i < 16 * 16; i++) {
+        uint16_t got = emu.displayPixel(x + i % 16, y + i / 16);
+        int dr = abs((got >> 11) - (ref[i] >> 11));
+        int dg = abs(((got >> 5) & 0x3F) - ((ref[i] >> 5) & 0x3F));
+        int db = abs((got & 0x1F) - (ref[i] & 0x1F));
+        if (dr > JPEG_TOLERANCE || dg > JPEG_TOLERANCE || db > JPEG_TOLERANCE) {
+            jpeg_bad++;
+        }
+    }
+}
+
+// Gauge cluster recorded into a display list, raster heavy
+static void recordGauges(st7789::DisplayList& list) {
+    list.clear();
+    list.fillScreen(0x0008);
+    for (int i = 0; i < 6; i++) {
+        int16_t cx = 60 + (i % 2) * 120;
+        int16_t cy = 55 + (i / 2) * 105;
+        list.fillCircle(cx, cy, 50, 0x2104);
+        list.fillCircle(cx, cy, 42, 0x0008);
+        list.fillTriangle(cx, cy - 40, cx - 4, cy, cx + 4, cy, st7789::RED);
+        list.drawString(cx - 30, cy + 8, "88.8 km/h", st7789::font_sans_14, st7789::WHITE, 0x0008);
+        list.drawString(cx - 18, cy - 24, "RPM", st7789::WHITE, 0x0008, 2);
+    }
+}
+
+// Append a line to a log view scrolling in the bottom 80 rows
+static void appendLogLine(st7789::ST7789& lcd, int n) {
+    char text[32];
+    snprintf(text, sizeof(text), "log line %d", n);
+    lcd.scroll(8);
+    lcd.fillRect(0, 312, 240, 8, st7789::BLACK);
+    lcd.drawString(2, 312, text, st7789::GREEN, st7789::BLACK, 1);
+}
+
+// Average time of a full gauge frame, tiles rasterized per core
+static double timeGauges(st7789::ST7789& lcd, bool parallel, uint16_t tiles[2]) {
+    const int frames = 20;
+    st7789::DisplayList list(lcd);
+    list.begin(64, 256);
+    if (parallel) {
+        list.enableParallel(4);
+    }
+    recordGauges(list);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        list.invalidate();
+        list.render();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    tiles[0] = list.tilesRasterized(0);
+    tiles[1] = list.tilesRasterized(1);
+    return std::chrono::duration<double, std::micro>(elapsed).count() / frames;
+}
+
+// Average launch and join of an empty job on core 1
+static double timeLaunch() {
+    const int rounds = 1000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        st7789::SecondCore::launch([](void*) {}, nullptr);
+        st7789::SecondCore::join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / rounds;
+}
+
+// Layered scene for the banded renderer
+static void drawScene(st7789::Graphics& gfx, void* user) {
+    (void)user;
+    gfx.fillRect(20, 20, 200, 120, st7789::BLUE);
+    gfx.fillCircle(120, 80, 50, st7789::RED);
+    gfx.drawString(40, 74, "Banded", st7789::WHITE, st7789::RED, 2);
+    gfx.drawImage(112, 150, 16, 16, test_image);
+}
+
+static const BenchCase cases[] = {
+    { "fillScreen",   { 153600, 1, 1, 0, 76800, 1 }, [](st7789::ST7789& lcd) { lcd.fillScreen(st7789::BLUE); } },
+    { "drawPixel",    { 13, 0, 6, 3, 1, 0 }, [](st7789::ST7789& lcd) { lcd.drawPixel(10, 10, st7789::WHITE); } },
+    { "drawLine_h",   { 491, 1, 6, 3, 240, 1 }, [](st7789::ST7789& lcd) { lcd.drawLine(0, 20, 239, 20, st7789::RED); } },
+    { "drawLine_v",   { 651, 0, 6, 3, 320, 1 }, [](st7789::ST7789& lcd) { lcd.drawLine(20, 0, 20, 319, st7789::RED); } },
+    { "drawLine_d",   { 1151, 0, 366, 183, 240, 61 }, [](st7789::ST7789& lcd) { lcd.drawLine(0, 40, 239, 100, st7789::GREEN); } },
+    { "drawRect",     { 986, 0, 20, 10, 476, 4 }, [](st7789::ST7789& lcd) { lcd.drawRect(30, 120, 180, 60, st7789::YELLOW); } },
+    { "fillRect",     { 12811, 0, 6, 3, 6400, 1 }, [](st7789::ST7789& lcd) { lcd.fillRect(40, 130, 160, 40, st7789::CYAN); } },
+    { "fillRectDMA",  { 12806, 0, 4, 2, 6400, 1 }, [](st7789::ST7789& lcd) { lcd.fillRectDMA(40, 190, 160, 40, st7789::MAGENTA); } },
+    { "drawCircle",   { 1806, 171, 860, 430, 172, 0 }, [](st7789::ST7789& lcd) { lcd.drawCircle(60, 270, 30, st7789::WHITE); } },
+    { "fillCircle",   { 7405, 1, 422, 211, 3345, 85 }, [](st7789::ST7789& lcd) { lcd.fillCircle(160, 270, 30, st7789::RED); } },
+    { "drawTriangle", { 1054, 0, 376, 188, 183, 63 }, [](st7789::ST7789& lcd) { lcd.drawTriangle(120, 240, 90, 300, 150, 300, st7789::GREEN); } },
+    { "fillTriangle", { 2098, 0, 296, 148, 781, 51 }, [](st7789::ST7789& lcd) { lcd.fillTriangle(205, 60, 235, 80, 210, 110, st7789::YELLOW); } },
+    { "drawChar_1x",  { 107, 0, 6, 3, 48, 1 }, [](st7789::ST7789& lcd) { lcd.drawChar(4, 4, 'A', st7789::WHITE, st7789::BLACK, 1); } },
+    { "drawChar_2x",  { 395, 1, 6, 3, 192, 1 }, [](st7789::ST7789& lcd) { lcd.drawChar(12, 4, 'B', st7789::WHITE, st7789::BLACK, 2); } },
+    { "drawString",   { 2123, 1, 6, 3, 1056, 1 }, [](st7789::ST7789& lcd) { lcd.drawString(4, 300, "Hello World 0123456789", st7789::WHITE, st7789::BLACK, 1); } },
+    { "readout_cached", { 42460, 20, 120, 60, 21120, 20 }, [](st7789::ST7789& lcd) {
+        // Same digits redrawn each frame, expanded once
+        lcd.graphics().enableGlyphCache(16, 2);
+        for (int frame = 0; frame < 10; frame++) {
+            lcd.drawString(4, 200, "0123456789", st7789::GREEN, st7789::BLACK, 2);
+            lcd.drawChar(4, 220, '0' + frame, st7789::GREEN, st7789::BLACK, 2);
+        }
+    } },
+    { "drawString_aa", { 3241, 1, 6, 3, 1615, 1 }, [](st7789::ST7789& lcd) { lcd.drawString(4, 240, "Speed: 42 km/h", st7789::font_sans_14, st7789::WHITE, st7789::BLACK); } },
+    { "drawImage",    { 523, 1, 6, 3, 256, 1 }, [](st7789::ST7789& lcd) { lcd.drawImage(200, 4, 16, 16, test_image); } },
+    { "drawImageDMA", { 518, 1, 4, 2, 256, 1 }, [](st7789::ST7789& lcd) { lcd.drawImageDMA(220, 4, 16, 16, test_image); } },
+    { "drawImage_clip", { 267, 1, 6, 3, 128, 16 }, [](st7789::ST7789& lcd) { lcd.drawImage(232, 24, 16, 16, test_image); } },
+    { "drawImageRLE", { 4107, 1, 6, 3, 2048, 2 }, [](st7789::ST7789& lcd) { lcd.drawImageCompressed(160, 100, badge_rle, sizeof(badge_rle)); } },
+    { "jpeg_420",     { 523, 1, 6, 3, 256, 1 }, [](st7789::ST7789& lcd) {
+        checkJpeg(lcd, lcd.drawJpeg(200, 44, jpeg_420, sizeof(jpeg_420)), 200, 44, jpeg_420_ref);
+    } },
+    { "jpeg_444_dri", { 518, 1, 4, 2, 256, 1 }, [](st7789::ST7789& lcd) {
+        checkJpeg(lcd, lcd.drawJpeg(220, 44, jpeg_444_dri, sizeof(jpeg_444_dri)), 220, 44, jpeg_444_dri_ref);
+    } },
+    { "jpeg_prog",    { 0, 0, 0, 0, 0, 0 }, [](st7789::ST7789& lcd) {
+        // Refused before anything is sent
+        if (lcd.drawJpeg(200, 64, jpeg_progressive, sizeof(jpeg_progressive))) {
+            jpeg_bad++;
+        }
+    } },
+    { "fb_flushAll",  { 153611, 1, 6, 3, 76800, 1 }, [](st7789::ST7789& lcd) {
+        lcd.enableFrameBuffer();
+        lcd.fillScreen(st7789::BLACK);
+        lcd.flush();
+    } },
+    { "fb_labels",    { 13473, 1, 18, 9, 6720, 1 }, [](st7789::ST7789& lcd) {
+        lcd.drawString(4, 40, "Speed: 42 km/h", st7789::WHITE, st7789::BLACK, 2);
+        lcd.drawString(4, 80, "Temp: 21.5 C", st7789::WHITE, st7789::BLACK, 2);
+        lcd.drawString(4, 120, "Batt: 87%", st7789::WHITE, st7789::BLACK, 2);
+        lcd.flush();
+    } },
+    { "fb_regions",   { 1580, 1, 88, 44, 720, 1 }, [](st7789::ST7789& lcd) {
+        // 20 scattered indicators, one DMA chain for all of them
+        for (int i = 0; i < 20; i++) {
+            lcd.fillRect(4 + (i % 5) * 56, 150 + (i / 5) * 50, 6, 6, (i & 1) ? st7789::GREEN : st7789::RED);
+        }
+        lcd.flush();
+        lcd.disableFrameBuffer();
+    } },
+    { "fill_rgb444",  { 115213, 2, 8, 4, 76800, 1 }, [](st7789::ST7789& lcd) {
+        // 12 bits per pixel on the wire, same fill as fillScreen
+        lcd.setColorMode(st7789::COLOR_RGB444);
+        lcd.fillScreen(st7789::BLUE);
+    } },
+    { "band_rgb444",  { 115202, 1, 2, 1, 76800, 80 }, [](st7789::ST7789& lcd) {
+        // Bands converted to RGB444 in the DMA buffer
+        st7789::BandRenderer bands(lcd);
+        bands.begin(16);
+        bands.render(drawScene);
+        lcd.setColorMode(st7789::COLOR_RGB565);
+    } },
+    { "fb_indexed4",  { 153611, 1, 6, 3, 76800, 75 }, [](st7789::ST7789& lcd) {
+        // 4-bit framebuffer, indices expanded through the palette on flush
+        lcd.enableIndexedFrameBuffer(4, ui_palette);
+        lcd.fillScreen(0x2104);
+        lcd.fillRect(10, 10, 220, 60, st7789::BLUE);
+        lcd.drawString(20, 30, "Indexed 4bpp", st7789::WHITE, st7789::BLUE, 2);
+        lcd.flush();
+        lcd.disableFrameBuffer();
+    } },
+    { "band_render",  { 153600, 1, 0, 0, 76800, 20 }, [](st7789::ST7789& lcd) {
+        st7789::BandRenderer bands(lcd);
+        bands.begin(16);
+        bands.render(drawScene);
+    } },
+    { "dlist_frame",  { 153890, 1, 180, 90, 76800, 40 }, [](st7789::ST7789& lcd) {
+        static st7789::DisplayList list(lcd);
+        list.begin(64, 256);
+        list.fillScreen(0x000F);
+        list.fillRect(20, 20, 200, 120, st7789::BLUE);
+        list.fillCircle(120, 80, 50, st7789::RED);
+        list.drawString(40, 74, "Listed", st7789::WHITE, st7789::RED, 2);
+        list.drawImage(112, 150, 16, 16, test_image);
+        list.render();
+    } },
+    { "dlist_update", { 11543, 1, 14, 7, 5760, 3 }, [](st7789::ST7789& lcd) {
+        // Same scene with one label changed, only its tiles are sent
+        static st7789::DisplayList list(lcd);
+        list.begin(64, 256);
+        for (int frame = 0; frame < 2; frame++) {
+            list.clear();
+            list.fillScreen(0x000F);
+            list.fillRect(20, 20, 200, 120, st7789::BLUE);
+            list.fillCircle(120, 80, 50, st7789::RED);
+            list.drawString(40, 74, frame ? "Frame 1" : "Frame 0", st7789::WHITE, st7789::RED, 2);
+            list.drawImage(112, 150, 16, 16, test_image);
+            list.render();
+            if (frame == 0) {
+                lcd.hal().emulator().resetStats();  // Count the update only
+            }
+        }
+        dlist_sent = list.tilesSent();
+        dlist_skipped = list.tilesSkipped();
+    } },
+    { "dlist_parallel", { 153890, 1, 180, 90, 76800, 40 }, [](st7789::ST7789& lcd) {
+        // Same traffic as a serial render, tiles come from both cores
+        st7789::DisplayList list(lcd);
+        list.begin(64, 256);
+        list.enableParallel(4);
+        recordGauges(list);
+        list.render();
+    } },
+    { "pipeline",     { 16336, ANY, 72, 36, 8112, 17 }, [](st7789::ST7789& lcd) {
+        // Drawing runs on a second thread standing in for core 1. The bus
+        // is released whenever the queue runs dry, so CS follows timing.
+        st7789::RenderPipeline pipe(lcd);
+        pipe.begin(8);
+        pipe.start();
+        for (int i = 0; i < 16; i++) {
+            pipe.fillRect(4 + i * 14, 260, 12, 40, i & 1 ? st7789::CYAN : st7789::MAGENTA);
+        }
+        pipe.drawString(4, 304, "Pipelined", st7789::WHITE, st7789::BLACK, 1);
+        pipe.sync();
+        pipe_pushed = pipe.pushed();
+        pipe_max_depth = pipe.maxDepth();
+        pipe_stalls = pipe.stalls();
+        pipe.stop();
+    } },
+    { "scroll_line",  { 4916, 2, 12, 6, 2448, 2 }, [](st7789::ST7789& lcd) {
+        // Hardware scroll, one short command plus the new line
+        lcd.setScrollArea(240, 0);
+        for (int i = 0; i < 10; i++) {
+            appendLogLine(lcd, i);
+        }
+        lcd.hal().emulator().resetStats();  // Count the last line only
+        appendLogLine(lcd, 10);
+    } },
+    { "term_log",     { 4345, 0, 14, 7, 2160, 2 }, [](st7789::ST7789& lcd) {
+        // Console in the bottom 80 rows, a new line scrolls the panel
+        static st7789::Terminal term(lcd);
+        term.begin(1, 240, 80);
+        for (int i = 0; i < 12; i++) {
+            term.setColor(i & 1 ? st7789::Terminal::TERM_CYAN : st7789::Terminal::TERM_GREEN);
+            term.printf("boot step %d ok\n", i);
+            term.update();
+        }
+        lcd.hal().emulator().resetStats();  // Count the last line only
+        term.resetStats();
+        term.setColor(st7789::Terminal::TERM_YELLOW);
+        term.print("ready\n");
+        term.update();
+        term_cells = term.cellsDrawn();
+        term_windows = term.windowsDrawn();
+    } },
+    { "sprite_move",  { 731, 1, 6, 3, 360, 1 }, [](st7789::ST7789& lcd) {
+        // 16x16 marker with a color key stepping over a solid background
+        static st7789::SpriteLayer layer(lcd);
+        static uint16_t marker[16 * 16];
+        for (int i = 0; i < 16 * 16; i++) {
+            int dx = i % 16 - 8, dy = i / 16 - 8;
+            marker[i] = (dx * dx + dy * dy < 49) ? st7789::YELLOW : st7789::MAGENTA;
+        }
+        layer.begin(4);
+        layer.setBackground(0x0008);
+        int8_t id = layer.addSprite(marker, 16, 16);
+        layer.setColorKey(id, st7789::MAGENTA);
+        lcd.fillRect(0, 180, 240, 60, 0x0008);  // Screen matches the background
+        layer.moveTo(id, 20, 200);
+        layer.show(id);
+        layer.update();
+        for (int i = 1; i < 10; i++) {
+            layer.moveTo(id, 20 + i * 4, 200 + i * 2);
+            layer.update();
+        }
+        lcd.hal().emulator().resetStats();  // Count the last move only
+        layer.resetStats();
+        layer.moveTo(id, 60, 220);
+        layer.update();
+        sprite_pixels = layer.pixelsDrawn();
+        sprite_windows = layer.windowsDrawn();
+    } },
+};
+
+int main(int argc, char** argv) {
+    static st7789::ST7789 lcd;
+
+    st7789::Config config;
+    config.width = 240;
+    config.height = 320;
+    config.rotation = st7789::ROTATION_0;
+    config.dma.enabled = true;
+
+    if (!lcd.begin(config)) {
+        printf("LCD initialization failed!\n");
+        return 1;
+    }
+
+    st7789::Emulator& emu = lcd.hal().emulator();
+    const BusStats& init = emu.stats();
+    printf("%-14s %9s %7s %7s %7s %8s %6s %9s\n",
+           "primitive", "bytes", "cs", "dc", "cmds", "pixels", "dma", "wire_us");
+    printf("%-14s %9u %7u %7u %7u %8u %6u %9u\n", "begin",
+           init.totalBytes(), init.cs_toggles, init.dc_flips, init.commands,
+           init.pixels, init.dma_transfers, init.wireMicros(config.spi_speed_hz));
+
+    int failures = 0;
+    for (const BenchCase& c : cases) {
+        emu.resetStats();
+        c.run(lcd);
+        const BusStats& s = emu.stats();
+        printf("%-14s %9u %7u %7u %7u %8u %6u %9u\n", c.name,
+               s.totalBytes(), s.cs_toggles, s.dc_flips, s.commands,
+               s.pixels, s.dma_transfers, s.wireMicros(config.spi_speed_hz));
+        
+        const Traffic& e = c.expected;
+        if (!matches(s.totalBytes(), e.bytes) || !matches(s.cs_toggles, e.cs) ||
+            !matches(s.dc_flips, e.dc) || !matches(s.commands, e.commands) ||
+            !matches(s.pixels, e.pixels) || !matches(s.dma_transfers, e.dma)) {
+            printf("%-14s %9d %7d %7d %7d %8d %6d  <- expected\n", "",
+                   (int)e.bytes, (int)e.cs, (int)e.dc, (int)e.commands, (int)e.pixels, (int)e.dma);
+            failures++;
+        }
+    }
+
+    st7789::GlyphCache& cache = lcd.graphics().glyphCache();
+    printf("glyph cache: %u hits, %u misses\n", (unsigned)cache.hits(), (unsigned)cache.misses());
+    printf("display list update: %u tiles sent, %u skipped\n", (unsigned)dlist_sent, (unsigned)dlist_skipped);
+    printf("pipeline: %u commands, max depth %u, %u stalls\n",
+           (unsigned)pipe_pushed, (unsigned)pipe_max_depth, (unsigned)pipe_stalls);
+    printf("terminal line: %u cells in %u windows\n", (unsigned)term_cells, (unsigned)term_windows);
+    printf("sprite move: %u pixels in %u windows\n", (unsigned)sprite_pixels, (unsigned)sprite_windows);
+    printf("jpeg: %d pixels off the reference\n", jpeg_bad);
+    if (jpeg_bad > 0) {
+        failures++;
+    }
+
+    if (argc > 1) {
+        if (!emu.savePpm(argv[1])) {
+            return 1;
+        }
+        printf("Snapshot written to %s\n", argv[1]);
+    }
+
+    // Wall time after the snapshot, meaningful with at least two host CPUs
+    uint16_t serial_tiles[2];
+    uint16_t parallel_tiles[2];
+    double serial_us = timeGauges(lcd, false, serial_tiles);
+    double parallel_us = timeGauges(lcd, true, parallel_tiles);
+    printf("gauge frame: serial %.0f us (core 0 %u tiles, core 1 %u tiles)\n",
+           serial_us, (unsigned)serial_tiles[0], (unsigned)serial_tiles[1]);
+    printf("gauge frame: parallel %.0f us (core 0 %u tiles, core 1 %u tiles), %.2fx serial speed\n",
+           parallel_us, (unsigned)parallel_tiles[0], (unsigned)parallel_tiles[1],
+           parallel_us > 0 ? serial_us / parallel_us : 0.0);
+    printf("core 1 launch and join: %.1f us\n", timeLaunch());
+
+    if (failures > 0) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
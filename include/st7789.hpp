@@ -3,6 +3,13 @@
 #include "st7789_config.hpp"
 #include "st7789_hal.hpp"
 #include "st7789_gfx.hpp"
+#include "st7789_band.hpp"
+#include "st7789_display_list.hpp"
+#include "st7789_pipeline.hpp"
+#include "st7789_terminal.hpp"
+#include "st7789_image.hpp"
+#include "st7789_jpeg.hpp"
+#include "st7789_sprite.hpp"
 
 namespace st7789 {
 
@@ -11,11 +18,38 @@ class ST7789 {
 private:
     HAL _hal;                   // Hardware abstraction layer
     Graphics _gfx;              // Graphics functionality
+    FrameBuffer _fb;            // Optional full-screen framebuffer
     bool _initialized;          // Initialization flag
     
+    // Address window last sent to the panel, valid while no other command
+    // went out after our RAMWR
+    uint16_t _win_x0, _win_y0, _win_x1, _win_y1;
+    uint32_t _win_command_count;
+    bool _win_valid;
+    
+    // DMA chain of a flush: up to CASET, RASET and RAMWR with parameters
+    // plus the pixels for each dirty rectangle
+    BusSegment _chain[FrameBuffer::MAX_DIRTY_RECTS * 6];
+    uint8_t _chain_params[FrameBuffer::MAX_DIRTY_RECTS][8];
+    
+    // Hardware vertical scrolling, in screen rows
+    bool _scroll_enabled;
+    uint16_t _scroll_top;       // First row of the scroll area
+    uint16_t _scroll_height;    // Rows in the scroll area
+    uint16_t _scroll_offset;    // Memory row shown at the top of the area, relative to it
+    
+    // Part of a screen row range and the memory rows holding it
+    struct ScrollSpan {
+        int16_t screen_y;
+        int16_t memory_y;
+        int16_t rows;
+    };
+    
     // Internal functions
     void initializeDisplay();
     void setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+    // Split rows y..y+h-1 where the scroll area wraps, at most 4 spans
+    uint8_t scrollSpans(int16_t y, int16_t h, ScrollSpan* spans) const;
     
 public:
     ST7789();
@@ -34,6 +68,12 @@ public:
     void fillScreen(uint16_t color);
     void sleepDisplay(bool sleep);
     
+    // Pixel format on the bus. RGB444 sends 12 bits per pixel, 25% fewer
+    // bytes; drawing keeps taking RGB565 colors and images, which are
+    // converted on the way out. PIXEL_RGB444 images go out as they are.
+    void setColorMode(ColorMode mode);
+    ColorMode getColorMode() const { return _hal.getConfig().color_mode; }
+    
     // Screen clearing
     void clearScreen(uint16_t color = BLACK) { _gfx.clearScreen(_hal.getConfig().width, _hal.getConfig().height, color); }
     
@@ -42,9 +82,36 @@ public:
     bool isDmaBusy() const { return _hal.isDmaBusy(); }
     
     // Efficient drawing functions using DMA
-    bool drawImageDMA(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data);
+    bool drawImageDMA(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data,
+                      PixelOrder order = PIXEL_NATIVE);
     bool fillRectDMA(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
     
+    // Framebuffer mode - drawing goes to RAM until flush()
+    bool enableFrameBuffer(uint16_t* buffer = nullptr);
+    // Palette framebuffer of 1, 2, 4 or 8 bits per pixel, see FrameBuffer.
+    // Drawing maps RGB565 colors to the nearest palette entry.
+    bool enableIndexedFrameBuffer(uint8_t bpp, const uint16_t* palette, uint8_t* buffer = nullptr);
+    void disableFrameBuffer();
+    bool isFrameBufferEnabled() const { return _gfx.frameBuffer() != nullptr; }
+    FrameBuffer& frameBuffer() { return _fb; }
+    bool flush();
+    // Start the flush and return, the DMA streams every dirty rectangle on
+    // its own. Call hal().waitDmaIdle() before drawing into the framebuffer.
+    bool flushAsync();
+    
+    // Hardware vertical scrolling, ROTATION_0 and ROTATION_180 only. The
+    // rows between the fixed areas scroll; Graphics and the DMA helpers keep
+    // taking screen coordinates and are mapped onto panel memory. The
+    // framebuffer, band renderer and display list address memory rows.
+    bool setScrollArea(uint16_t top_fixed, uint16_t bottom_fixed);
+    void setScrollOffset(uint16_t offset);  // Content moves up by offset rows
+    void scroll(int16_t rows);              // Relative to the current offset
+    void resetScroll();
+    bool isScrolling() const { return _scroll_enabled; }
+    uint16_t scrollOffset() const { return _scroll_offset; }
+    int16_t screenToMemoryY(int16_t y) const;
+    int16_t memoryToScreenY(int16_t y) const;
+    
     // Hardware control
     void setBacklight(bool on);
     void setBrightness(uint8_t brightness);
@@ -57,20 +124,28 @@ public:
     // Convenient drawing functions (passed to graphics class)
     void drawPixel(int16_t x, int16_t y, uint16_t color) { _gfx.drawPixel(x, y, color); }
     void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) { _gfx.drawLine(x0, y0, x1, y1, color); }
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { _gfx.drawFastHLine(x, y, w, color); }
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { _gfx.drawFastVLine(x, y, h, color); }
     void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { _gfx.drawRect(x, y, w, h, color); }
     void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { _gfx.fillRect(x, y, w, h, color); }
     void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) { _gfx.drawCircle(x0, y0, r, color); }
     void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) { _gfx.fillCircle(x0, y0, r, color); }
     void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) { _gfx.drawTriangle(x0, y0, x1, y1, x2, y2, color); }
+    void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) { _gfx.fillTriangle(x0, y0, x1, y1, x2, y2, color); }
     void drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) { _gfx.drawChar(x, y, c, color, bg, size); }
     void drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) { _gfx.drawString(x, y, str, color, bg, size); }
-    void drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data) { _gfx.drawImage(x, y, w, h, data); }
+    void drawString(int16_t x, int16_t y, const char* str, const AAFont& font, uint16_t color, uint16_t bg) { _gfx.drawString(x, y, str, font, color, bg); }
+    void drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data, PixelOrder order = PIXEL_NATIVE) { _gfx.drawImage(x, y, w, h, data, order); }
+    bool drawImageCompressed(int16_t x, int16_t y, const uint8_t* data, size_t size) { return _gfx.drawImageCompressed(x, y, data, size); }
+    bool drawJpeg(int16_t x, int16_t y, const uint8_t* data, size_t size) { return _gfx.drawJpeg(x, y, data, size); }
     
     // Static helper functions
     static uint16_t color565(uint8_t r, uint8_t g, uint8_t b) { return Graphics::color565(r, g, b); }
     
     // Friend declarations
     friend class Graphics;
+    friend class BandRenderer;
+    friend class DisplayList;
 };
 
 } // namespace st7789 
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace st7789 {
+
+// Glyph of an anti-aliased proportional font
+struct AAGlyph {
+    uint32_t offset;        // Start of the coverage data in the font bitmap
+    uint8_t width;          // Bounding box size
+    uint8_t height;
+    uint8_t advance;        // Pen advance to the next glyph
+    int8_t x_offset;        // Bounding box position relative to the pen on the baseline
+    int8_t y_offset;
+};
+
+// Reads len bytes of coverage data at offset from external storage
+typedef bool (*FontReadFunc)(void* user, uint32_t offset, uint8_t* dst, size_t len);
+
+// Anti-aliased proportional font, generated by tools/font_convert.py.
+// Coverage is 2 or 4 bits per pixel, MSB first, glyph rows packed back to back.
+//
+// Small fonts cover the character range first..last. Large (e.g. CJK) fonts
+// list the sorted codepoint of every glyph and are searched in O(log n);
+// their bitmap may live outside memory-mapped flash and be read on demand.
+struct AAFont {
+    const uint8_t* bitmap;      // nullptr when the coverage is loaded through read
+    const AAGlyph* glyphs;
+    uint16_t first;             // Character range when codepoints is nullptr
+    uint16_t last;
+    uint8_t bpp;
+    uint8_t line_height;        // Distance between baselines
+    uint8_t ascent;             // Baseline position below the top of the line
+    const uint32_t* codepoints; // Sorted codepoint of each glyph, nullptr for a range font
+    uint32_t glyph_count;
+    FontReadFunc read;          // Coverage loader for fonts without bitmap
+    void* read_user;
+};
+
+// Index of the glyph for a codepoint, -1 if the font has none
+int32_t findGlyph(const AAFont& font, uint32_t codepoint);
+
+// Size of a glyph's coverage data in bytes
+inline size_t glyphBytes(const AAFont& font, const AAGlyph& glyph) {
+    return ((size_t)glyph.width * glyph.height * font.bpp + 7) / 8;
+}
+
+// Decode one UTF-8 sequence and advance str past it, U+FFFD if malformed
+uint32_t decodeUtf8(const char*& str);
+
+// Built-in fonts
+extern const AAFont font_sans_14;
+
+} // namespace st7789
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include "st7789_config.hpp"
+#include "st7789_framebuffer.hpp"
+
+namespace st7789 {
+
+// Forward declarations
+class ST7789;
+class Graphics;
+
+// Draw callback replayed once per band, must draw the whole frame
+typedef void (*BandDrawFunc)(Graphics& gfx, void* user);
+
+// Banded (strip) renderer - full-frame composition through two N-line buffers.
+// Band N is sent by DMA while band N+1 is rasterized.
+class BandRenderer {
+private:
+    ST7789* _lcd;
+    FrameBuffer _bands[2];      // Ping-pong band buffers
+    uint16_t _band_height;
+
+    bool allocate();
+
+public:
+    BandRenderer(ST7789& lcd);
+    virtual ~BandRenderer();
+
+    // Memory use is 2 * width * band_height * 2 bytes
+    bool begin(uint16_t band_height = 16);
+    void end();
+    uint16_t bandHeight() const { return _band_height; }
+
+    // Clear each band to bg, replay draw into it and send it
+    bool render(BandDrawFunc draw, void* user = nullptr, uint16_t bg = BLACK);
+};
+
+} // namespace st7789
@@ -1,8 +1,13 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
+#ifdef ST7789_HOST_BUILD
+#include "st7789_host.hpp"
+#else
 #include "hardware/spi.h"
 #include "hardware/dma.h"
+#endif
 
 namespace st7789 {
 
@@ -26,17 +31,45 @@ enum Rotation {
     ROTATION_270 = 3
 };
 
+// Memory layout of pixel sources
+enum PixelOrder {
+    PIXEL_NATIVE = 0,   // RGB565 uint16_t values in CPU byte order
+    PIXEL_PANEL  = 1,   // RGB565, high byte first in memory, exactly as sent to the panel
+    PIXEL_RGB444 = 2    // uint16_t values holding 4-bit red, green and blue in the low 12 bits
+};
+
+// Interface pixel format, the value is the COLMOD parameter
+enum ColorMode {
+    COLOR_RGB565 = 0x55,    // 16 bits/pixel
+    COLOR_RGB444 = 0x53     // 12 bits/pixel, two pixels in three bytes on the wire
+};
+
+// RGB565 to RGB444 drops the low bits of each channel
+inline uint16_t rgb565To444(uint16_t c) {
+    return ((c >> 4) & 0xF00) | ((c >> 3) & 0x0F0) | ((c >> 1) & 0x00F);
+}
+
+// RGB444 to RGB565 repeats the high bits of each channel below
+inline uint16_t rgb444To565(uint16_t c) {
+    uint16_t r = (c >> 8) & 0xF;
+    uint16_t g = (c >> 4) & 0xF;
+    uint16_t b = c & 0xF;
+    return (((r << 1) | (r >> 3)) << 11) | (((g << 2) | (g >> 2)) << 5) | ((b << 1) | (b >> 3));
+}
+
 // DMA configuration
 struct DmaConfig {
     bool enabled;           // Whether DMA is enabled
     uint dma_tx_channel;    // DMA transmit channel
-    size_t buffer_size;     // DMA buffer size
+    size_t buffer_size;     // DMA buffer size in bytes, split into two ping-pong halves
+    size_t chain_blocks;    // Control blocks for chained transfers, 16 bytes each, 0 disables
     
     // Constructor with default values
     DmaConfig() :
         enabled(true),      // Enable DMA by default
         dma_tx_channel(0),  // Use channel 0, will be automatically assigned during initialization
-        buffer_size(4096)   // Default 4KB buffer
+        buffer_size(4096),  // Default 4KB buffer
+        chain_blocks(256)   // Default 4KB of control blocks
     {}
 };
 
@@ -55,6 +88,7 @@ struct Config {
     uint16_t width;           // Width
     uint16_t height;          // Height
     Rotation rotation;        // Rotation direction
+    ColorMode color_mode;     // Pixel format on the bus
     
     // DMA configuration
     DmaConfig dma;
@@ -72,6 +106,7 @@ struct Config {
         width(240),
         height(320),
         rotation(ROTATION_0),  // Default rotation is 0 degrees
+        color_mode(COLOR_RGB565),
         dma() {}
 };
 
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+namespace st7789 {
+
+// Core 1 of the RP2040 as a worker for core 0. On the host build a thread
+// stands in for it, so the same code runs with two threads on Linux.
+// Core 1 is started by the first launch and sleeps between jobs, so a
+// launch per frame costs a wake-up rather than a core reset.
+class SecondCore {
+public:
+    typedef void (*Entry)(void* user);
+
+    // Run entry(user) on core 1, false if core 1 is already in use
+    static bool launch(Entry entry, void* user);
+    // Wait for entry to return, core 1 then sleeps until the next launch
+    static void join();
+    // Join and stop core 1, e.g. before launching other code on it
+    static void release();
+    static bool isBusy();
+
+    // Sleep until the other core signals (WFE/SEV), yield on the host
+    static void wait();
+    static void signal();
+};
+
+} // namespace st7789
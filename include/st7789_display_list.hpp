@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include "st7789_config.hpp"
+#include "st7789_framebuffer.hpp"
+#include "st7789_gfx.hpp"
+#include "st7789_aa_font.hpp"
+
+namespace st7789 {
+
+// Forward declaration
+class ST7789;
+
+// Display list - drawing calls are recorded as compact commands, binned into
+// screen tiles by bounding box and rasterized tile by tile into a small
+// buffer that is sent with one window and one DMA burst. Overdraw stays in
+// RAM, commands hidden behind an opaque fill are skipped per tile, and
+// tiles whose commands did not change since the last render are not sent.
+// With enableParallel() both cores rasterize tiles while core 0 sends them.
+class DisplayList {
+public:
+    static const uint8_t MAX_TILE_SLOTS = 8;  // Raster buffers in flight
+
+    // Recorded command types
+    enum CommandType : uint8_t {
+        CMD_FILL_RECT,
+        CMD_DRAW_RECT,
+        CMD_LINE,
+        CMD_CIRCLE,
+        CMD_FILL_CIRCLE,
+        CMD_TRIANGLE,
+        CMD_FILL_TRIANGLE,
+        CMD_TEXT,
+        CMD_TEXT_AA,
+        CMD_IMAGE
+    };
+
+private:
+    struct Command {
+        uint8_t type;
+        uint8_t size;           // Text scale or image pixel order
+        uint16_t color;
+        uint16_t bg;
+        int16_t args[6];        // Coordinates, meaning depends on the type
+        const void* data;       // Text in the arena or image pixels
+        const AAFont* font;
+        Rect bounds;            // Screen area touched, clipped to the screen
+    };
+
+    ST7789* _lcd;
+    Command* _commands;
+    uint16_t _max_commands;
+    uint16_t _command_count;
+    char* _text;                // Arena holding copies of recorded strings
+    size_t _text_size;
+    size_t _text_used;
+    bool _overflow;
+
+    // A tile to rasterize and send
+    struct TileJob {
+        Rect tile;
+        uint16_t first;         // Range in _bin_refs, occluded commands skipped
+        uint16_t last;
+        bool covered;           // First command paints the whole tile
+    };
+
+    // Tiles
+    uint16_t _tile_width;
+    uint16_t _tile_height;
+    uint16_t* _tile_pixels;     // Raster slots of tile_width * tile_height pixels
+    uint8_t _tile_slots;
+    uint16_t _tile_cols;
+    uint16_t _tile_rows;
+    uint16_t* _bin_start;       // Per tile first index into _bin_refs, one extra at the end
+    uint16_t* _bin_refs;        // Command indices grouped by tile, in recording order
+    size_t _bin_capacity;
+    uint32_t* _signatures;      // Per tile hash of what was last sent
+    bool _signatures_valid;
+    TileJob* _jobs;             // Tiles to send this render, in screen order
+    uint16_t _job_count;
+    uint16_t _bg;
+
+    // Parallel rasterization, tile j goes to slot j % _tile_slots
+    bool _parallel;
+    Graphics _worker_gfx;                   // Raster state of core 1
+    std::atomic<uint16_t> _next_job;        // Next tile to claim, either core
+    std::atomic<uint16_t> _released;        // Tiles before this one are off the wire
+    std::atomic<int32_t> _slot_ready[MAX_TILE_SLOTS];  // Tile rasterized in each slot
+    uint16_t _tiles_by_core[2];
+
+    // Statistics of the last render
+    uint16_t _tiles_sent;
+    uint16_t _tiles_skipped;
+    uint32_t _commands_drawn;
+    uint32_t _commands_culled;
+
+    Command* record(uint8_t type, const Rect& bounds, uint16_t color);
+    const char* storeText(const char* str);
+    bool allocateTiles(uint16_t width, uint16_t height);
+    bool binCommands();
+    uint32_t signature(uint16_t first, uint16_t last, bool covered, uint16_t bg) const;
+    void planTiles();
+    void execute(Graphics& gfx, const Command& cmd) const;
+    uint16_t* rasterTile(Graphics& gfx, uint16_t job);
+    bool sendTile(uint16_t job, const uint16_t* pixels);
+    bool renderSerial();
+    bool renderParallel();
+    bool claimJob(uint16_t& job);
+    static void workerEntry(void* user);
+
+public:
+    DisplayList(ST7789& lcd);
+    virtual ~DisplayList();
+
+    // Memory use is max_commands * sizeof(Command) + text_bytes
+    // + 2 * tile_width * tile_height * 2 bytes for the tile buffers,
+    // one buffer per slot with enableParallel()
+    bool begin(uint16_t max_commands = 128, size_t text_bytes = 1024,
+               uint16_t tile_width = 60, uint16_t tile_height = 32);
+    void end();
+    bool isValid() const { return _commands != nullptr; }
+
+    // Start recording a new frame, the previous commands are dropped
+    void clear();
+
+    // Recording, same arguments as Graphics. Strings are copied, image
+    // data must stay valid until the list is rendered.
+    void fillScreen(uint16_t color);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { fillRect(x, y, w, 1, color); }
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { fillRect(x, y, 1, h, color); }
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+    void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+    void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+    void drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size);
+    void drawString(int16_t x, int16_t y, const char* str, const AAFont& font, uint16_t color, uint16_t bg);
+    void drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data,
+                   PixelOrder order = PIXEL_NATIVE);
+
+    uint16_t commandCount() const { return _command_count; }
+    // A command or string did not fit, the frame is incomplete
+    bool overflowed() const { return _overflow; }
+
+    // Rasterize and send the tiles that changed since the last render,
+    // the recorded list stays and can be rendered again
+    bool render(uint16_t bg = BLACK);
+    // Send every tile on the next render, e.g. after drawing around the list
+    void invalidate() { _signatures_valid = false; }
+
+    // Split rasterization between both cores, core 0 keeps sending tiles
+    // in order. tile_slots raster buffers bound how far ahead they run.
+    bool enableParallel(uint8_t tile_slots = 4);
+    void disableParallel();
+    bool isParallel() const { return _parallel; }
+
+    uint16_t tileWidth() const { return _tile_width; }
+    uint16_t tileHeight() const { return _tile_height; }
+    uint16_t tilesSent() const { return _tiles_sent; }
+    uint16_t tilesSkipped() const { return _tiles_skipped; }
+    uint32_t commandsDrawn() const { return _commands_drawn; }
+    uint32_t commandsCulled() const { return _commands_culled; }
+    uint16_t tilesRasterized(uint8_t core) const { return core < 2 ? _tiles_by_core[core] : 0; }
+};
+
+} // namespace st7789
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace st7789 {
+
+// Bus traffic counters collected by the emulator
+struct BusStats {
+    uint32_t command_bytes;   // Bytes sent with DC low
+    uint32_t data_bytes;      // Bytes sent with DC high
+    uint32_t cs_toggles;      // Number of CS assertions (high -> low)
+    uint32_t dc_flips;        // Number of DC level changes
+    uint32_t commands;        // Commands decoded
+    uint32_t pixels;          // Pixels written into GRAM
+    uint32_t dma_transfers;   // DMA transfers started by the HAL
+    uint32_t delay_ms;        // Time requested through HAL::delay
+
+    BusStats() { clear(); }
+
+    void clear() {
+        command_bytes = 0;
+        data_bytes = 0;
+        cs_toggles = 0;
+        dc_flips = 0;
+        commands = 0;
+        pixels = 0;
+        dma_transfers = 0;
+        delay_ms = 0;
+    }
+
+    uint32_t totalBytes() const { return command_bytes + data_bytes; }
+
+    // Time the bytes occupy the wire at the given SPI clock
+    uint32_t wireMicros(uint32_t spi_speed_hz) const {
+        return (uint32_t)((uint64_t)totalBytes() * 8 * 1000000 / spi_speed_hz);
+    }
+};
+
+// ST7789 panel emulator - decodes the SPI command stream into a 240x320 GRAM
+class Emulator {
+public:
+    static const uint16_t GRAM_WIDTH = 240;
+    static const uint16_t GRAM_HEIGHT = 320;
+
+private:
+    uint16_t _gram[GRAM_WIDTH * GRAM_HEIGHT];  // RGB565, native panel orientation
+
+    // Interface state
+    bool _cs;                   // CS level
+    bool _dc;                   // DC level
+    uint8_t _cmd;               // Command currently receiving parameters
+    uint8_t _params[6];         // Parameter bytes of the current command
+    uint8_t _param_count;       // Parameter bytes received so far
+
+    // Controller registers
+    uint16_t _xs, _xe;          // Column window (CASET)
+    uint16_t _ys, _ye;          // Row window (RASET)
+    uint16_t _cur_x, _cur_y;    // Memory write pointer
+    uint8_t _madctl;            // Memory data access control
+    uint8_t _colmod;            // Interface pixel format
+    uint16_t _tfa, _vsa, _bfa;  // Vertical scroll areas (VSCRDEF)
+    uint16_t _vsp;              // First memory line of the scroll area (VSCSAD)
+    bool _sleeping;
+    bool _display_on;
+    bool _inverted;
+
+    BusStats _stats;
+
+    void handleCommand(uint8_t cmd);
+    void handleData(uint8_t data);
+    void writePixel(uint16_t color);
+    uint16_t displayLine(uint16_t line) const;
+
+public:
+    Emulator();
+
+    // Hardware reset line, clears controller registers but keeps GRAM
+    void reset();
+
+    // SPI bus signals
+    void setCs(bool level);
+    void setDc(bool level);
+    void write(const uint8_t* data, size_t len);
+
+    // Statistics
+    const BusStats& stats() const { return _stats; }
+    BusStats& stats() { return _stats; }
+    void resetStats() { _stats.clear(); }
+
+    // GRAM access in native panel coordinates
+    uint16_t pixel(uint16_t x, uint16_t y) const;
+    void clearGram(uint16_t color = 0);
+    
+    // What the glass shows in native coordinates, GRAM with vertical scroll applied
+    uint16_t displayPixel(uint16_t x, uint16_t y) const;
+
+    // Controller state
+    uint8_t madctl() const { return _madctl; }
+    uint8_t colmod() const { return _colmod; }
+    uint16_t scrollStart() const { return _vsp; }
+    bool isSleeping() const { return _sleeping; }
+    bool isDisplayOn() const { return _display_on; }
+    bool isInverted() const { return _inverted; }
+
+    // Write the displayed image as a binary PPM (P6) image
+    bool savePpm(const char* path) const;
+};
+
+} // namespace st7789
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "st7789_aa_font.hpp"
+
+namespace st7789 {
+
+// LRU cache of glyph coverage for fonts read from external storage
+class FontCache {
+private:
+    struct Entry {
+        const AAFont* font;     // nullptr marks an unused slot
+        uint32_t index;         // Glyph index in the font
+        uint32_t last_use;      // Tick of the last lookup, smallest is evicted
+    };
+
+    Entry* _entries;
+    uint8_t* _data;             // slot_bytes of coverage per entry
+    uint8_t _count;
+    uint16_t _slot_bytes;
+    uint32_t _tick;
+    uint32_t _hits;
+    uint32_t _misses;
+
+public:
+    FontCache();
+    virtual ~FontCache();
+
+    // Slots must hold the largest glyph, 288 bytes is 24x24 at 4 bpp
+    bool begin(uint8_t entries = 16, uint16_t slot_bytes = 288);
+    void end();
+    bool isValid() const { return _entries != nullptr; }
+    void clear();
+
+    // Coverage of a glyph, read through font.read on a miss.
+    // nullptr if the glyph is larger than a slot or the read fails.
+    const uint8_t* load(const AAFont& font, uint32_t index);
+
+    // Statistics
+    uint32_t hits() const { return _hits; }
+    uint32_t misses() const { return _misses; }
+    void resetStats() { _hits = 0; _misses = 0; }
+};
+
+} // namespace st7789
@@ -2,16 +2,50 @@
 
 #include <cstdint>
 #include "st7789_config.hpp"
+#include "st7789_framebuffer.hpp"
+#include "st7789_glyph_cache.hpp"
+#include "st7789_aa_font.hpp"
+#include "st7789_font_cache.hpp"
 
 namespace st7789 {
 
-// Forward declaration
+// Forward declarations
 class ST7789;
+class PixelStream;
 
 // Graphics class - handles drawing operations
 class Graphics {
+public:
+    static const size_t TEXT_BUFFER_PIXELS = 2048;  // Text run buffer, grown only to fit one large glyph
+    
 private:
     ST7789* _lcd; // Reference to main LCD class
+    FrameBuffer* _fb; // Render target, nullptr draws straight to the panel
+    uint16_t* _text_buf; // Glyph raster buffer, allocated on first text draw
+    size_t _text_buf_pixels;
+    GlyphCache _glyph_cache; // Optional cache of expanded glyphs
+    FontCache _font_cache;   // Coverage of glyphs read from external storage
+    uint16_t _blend_lut[16]; // Coverage level to color for _lut_color over _lut_bg
+    uint16_t _lut_color;
+    uint16_t _lut_bg;
+    bool _lut_valid;
+    
+    // Text helpers
+    uint16_t* textBuffer(size_t pixels);
+    void renderGlyph(uint16_t* dst, size_t stride, char c, uint16_t color, uint16_t bg, uint8_t size) const;
+    const uint16_t* cachedGlyph(char c, uint16_t color, uint16_t bg, uint8_t size);
+    void drawGlyphTransparent(int16_t x, int16_t y, char c, uint16_t color, uint8_t size);
+    void drawTextRun(int16_t x, int16_t y, const char* str, size_t len, uint16_t color, uint16_t bg, uint8_t size);
+    const uint16_t* blendLut(uint16_t color, uint16_t bg);
+    const uint8_t* glyphCoverage(const AAFont& font, uint32_t index);
+    void drawAARun(int16_t x, int16_t y, const char* str, size_t len, const AAFont& font, uint16_t color, uint16_t bg);
+    
+    // Drawable area of the current target
+    Rect clipBounds() const;
+    // Clip a rectangle to the current target, false if nothing is left
+    bool clipRect(int16_t& x, int16_t& y, int16_t& w, int16_t& h) const;
+    // Clipped window filled from a decoder, to the framebuffer or the panel
+    void drawStream(PixelStream& stream, int16_t cx, int16_t cy, int16_t cw, int16_t ch);
     
 public:
     Graphics(ST7789* lcd);
@@ -20,18 +54,53 @@ public:
     // Basic drawing functions
     void drawPixel(int16_t x, int16_t y, uint16_t color);
     void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);  // One window burst per span
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
     void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
     void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
     void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
     void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
     void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+    void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
     
     // Text functions
     void drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size);
     void drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size);
     
+    // Anti-aliased proportional UTF-8 text, y is the top of the line. Edges
+    // are blended against bg; with bg == color only the solid part is drawn.
+    void drawString(int16_t x, int16_t y, const char* str, const AAFont& font, uint16_t color, uint16_t bg);
+    int16_t textWidth(const char* str, const AAFont& font) const;
+    
+    // Screen area a drawString() call would touch
+    Rect textBounds(int16_t x, int16_t y, const char* str, uint8_t size) const;
+    Rect textBounds(int16_t x, int16_t y, const char* str, const AAFont& font) const;
+    
+    // RAM cache for fonts whose coverage is read from external storage,
+    // enabled with the defaults on first use
+    bool enableFontCache(uint8_t entries = 16, uint16_t slot_bytes = 288) { return _font_cache.begin(entries, slot_bytes); }
+    void disableFontCache() { _font_cache.end(); }
+    FontCache& fontCache() { return _font_cache; }
+    
+    // Glyph cache - opaque glyphs up to max_size are expanded once and reused
+    bool enableGlyphCache(uint8_t entries = 16, uint8_t max_size = 2) { return _glyph_cache.begin(entries, max_size); }
+    void disableGlyphCache() { _glyph_cache.end(); }
+    GlyphCache& glyphCache() { return _glyph_cache; }
+    
     // Image drawing
-    void drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data);
+    void drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data,
+                   PixelOrder order = PIXEL_NATIVE);
+    // RLE or QOI-style blob from tools/image_encode.py, decoded straight into
+    // the DMA buffer. False if the blob is not a compressed image.
+    bool drawImageCompressed(int16_t x, int16_t y, const uint8_t* data, size_t size);
+    // Baseline JPEG decoded one MCU row at a time, see JpegDecoder. False if
+    // the file is not supported, the working memory cannot be allocated or
+    // the data is corrupt; a corrupt file ends in black.
+    bool drawJpeg(int16_t x, int16_t y, const uint8_t* data, size_t size);
+    
+    // Render target
+    void setFrameBuffer(FrameBuffer* fb) { _fb = fb; }
+    FrameBuffer* frameBuffer() const { return _fb; }
     
     // Clear screen function
     void clearScreen(uint16_t width, uint16_t height, uint16_t color = BLACK);
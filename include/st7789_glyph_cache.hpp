@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace st7789 {
+
+// LRU cache of expanded RGB565 glyph cells keyed by character, colors and scale
+class GlyphCache {
+private:
+    struct Entry {
+        char c;
+        uint8_t size;           // 0 marks an unused slot
+        uint16_t fg;
+        uint16_t bg;
+        uint32_t last_use;      // Tick of the last lookup, smallest is evicted
+    };
+
+    Entry* _entries;
+    uint16_t* _pixels;          // One cell of the largest scale per entry
+    uint8_t _count;
+    uint8_t _max_size;
+    uint32_t _tick;
+    uint32_t _hits;
+    uint32_t _misses;
+
+    size_t cellPixels() const { return (size_t)48 * _max_size * _max_size; }
+
+public:
+    GlyphCache();
+    virtual ~GlyphCache();
+
+    // Memory use is entries * 96 * max_size^2 bytes
+    bool begin(uint8_t entries = 16, uint8_t max_size = 2);
+    void end();
+    bool isValid() const { return _entries != nullptr; }
+    uint8_t maxSize() const { return _max_size; }
+    void clear();
+
+    // Cached cell (6*size x 8*size, native order), nullptr on a miss
+    const uint16_t* find(char c, uint16_t fg, uint16_t bg, uint8_t size);
+    // Evict the least recently used entry and return its buffer for the new cell
+    uint16_t* insert(char c, uint16_t fg, uint16_t bg, uint8_t size);
+
+    // Statistics
+    uint32_t hits() const { return _hits; }
+    uint32_t misses() const { return _misses; }
+    void resetStats() { _hits = 0; _misses = 0; }
+};
+
+} // namespace st7789
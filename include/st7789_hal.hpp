@@ -1,12 +1,53 @@
 #pragma once
 
 #include <cstdint>
+#include "st7789_config.hpp"
+#ifdef ST7789_HOST_BUILD
+#include "st7789_emulator.hpp"
+#else
 #include "hardware/spi.h"
 #include "hardware/dma.h"
-#include "st7789_config.hpp"
+#endif
 
 namespace st7789 {
 
+// One piece of a chained bus transfer, see HAL::writeChainAsync()
+struct BusSegment {
+    enum Kind : uint8_t {
+        COMMAND,    // Bytes sent with DC low
+        DATA,       // Bytes sent with DC high
+        PIXELS      // Native RGB565 rectangle sent as 16-bit frames
+    };
+    
+    Kind kind;
+    uint16_t width;         // Bytes, or pixels per row
+    uint16_t height;        // Rows of PIXELS
+    uint16_t stride;        // Source pixels per row of PIXELS
+    const void* data;       // Must stay valid until the chain completes
+};
+
+// Pixels produced on demand, e.g. by an image decoder, see HAL::writeStream()
+class PixelStream {
+public:
+    virtual ~PixelStream() {}
+    // Next pixels of the window in row order as native RGB565, up to max.
+    // Returns the number written, fewer only when the source runs out.
+    virtual size_t read(uint16_t* pixels, size_t max) = 0;
+};
+
+// Pixels converted to the bus format on the way out, see HAL::writeConverted()
+struct PixelSource {
+    const void* data;
+    size_t width;
+    size_t height;
+    size_t stride;          // Source pixels per row, bytes per row of indices
+    PixelOrder order;
+    const uint16_t* lut;    // Palette in the bus format, null for RGB565/RGB444 pixels
+    uint8_t bpp;            // Bits per palette index
+    size_t first;           // Index of the first pixel within each row
+    PixelStream* stream;    // Decoded into the chunk instead of read from data
+};
+
 // Hardware Abstraction Layer class - handles all hardware-related operations
 class HAL {
 private:
@@ -19,11 +60,55 @@ private:
     size_t _dma_buffer_size;
     bool _dma_enabled;
     bool _dma_busy;
+    bool _dma_pending;          // Async transfer holding CS until waitDmaIdle()
+    uint16_t _fill_color;       // Source word of DMA fills, read without incrementing
+    uint8_t _spi_frame_bits;    // SPI frame size, 8 outside of pixel writes
+    bool _cs_active;            // CS currently asserted
+    uint8_t _transaction_depth; // Nested beginTransaction() calls
+    uint32_t _command_count;    // Commands sent, also bumped when panel state is lost
+    size_t _data_count;         // Data bytes sent since the last command
+    
+#ifdef ST7789_HOST_BUILD
+    Emulator _emu;              // Emulated panel on the other end of the bus
+#else
+    // Chained transfers: a control channel loads blocks into the TX channel
+    enum ChainWord {
+        WORD_ZERO, WORD_DC_DATA, WORD_DC_COMMAND, WORD_CR1_OFF,
+        WORD_CR0_8, WORD_CR1_ON_8, WORD_CR0_16, WORD_CR1_ON_16, WORD_COUNT
+    };
+    enum ChainCtrl { CTRL_TX8, CTRL_TX16, CTRL_WORD, CTRL_PAIR, CTRL_DELAY, CTRL_COUNT };
+    struct ChainBlock;
+    ChainBlock* _chain_blocks;
+    size_t _chain_capacity;
+    int _dma_ctrl_channel;
+    int _dma_timer;                         // Paces the waits for the SPI to drain
+    uint32_t _chain_words[WORD_COUNT];      // Register values written by the chain
+    uint32_t _chain_ctrl[CTRL_COUNT];       // TX channel configurations
+    uint32_t _chain_sink;                   // Target of the wait transfers
+    bool _chain_active;
+    bool _align_pending;                    // Odd number of 12-bit frames in flight
+    
+    void initChain();
+    void cleanupChain();
+    size_t buildChain(const BusSegment* segments, size_t count, ChainBlock* out);
+    void alignFrames();
+#endif
     
     // Private methods
     void initDma();
     void cleanupDma();
+    bool writeSegments(const BusSegment* segments, size_t count);
+    bool writeConverted(const PixelSource& src);
     bool waitForDmaComplete(uint32_t timeout_ms = 1000);
+    void setFrameSize(uint8_t bits);
+    void configureDma(uint8_t bits, bool read_increment);
+    void select();
+    void deselect();
+    
+    // Bytes count pixels take on the wire, an odd RGB444 run ends with a pad nibble
+    size_t pixelBytes(size_t count) const {
+        return _config.color_mode == COLOR_RGB444 ? (count * 3 + 1) / 2 : count * 2;
+    }
     
 public:
     HAL();
@@ -32,17 +117,64 @@ public:
     // Initialize hardware
     bool init(const Config& config);
     
+    // Transactions keep CS asserted across a group of commands and data,
+    // only DC toggles in between. Calls may nest.
+    void beginTransaction();
+    void endTransaction();
+    
     // Basic IO operations
     void writeCommand(uint8_t cmd);
+    void writeCommand(uint8_t cmd, const uint8_t* params, size_t len);  // Command and its parameters
     void writeData(uint8_t data);
     void writeDataBulk(const uint8_t* data, size_t len);
     
     // DMA operations
     bool writeDataDma(const uint16_t* data, size_t len);
+    bool writeDataDma(const uint16_t* data, size_t width, size_t height, size_t stride);
+    bool waitDmaIdle();
+    
+    // One RGB565 pixel as data bytes in the bus format
+    void writePixel(uint16_t color);
+    
+    // Zero-copy pixel writes straight from caller memory or flash. Native
+    // pixels go out as 16-bit SPI frames, panel-ordered ones as bytes and
+    // RGB444 ones as 12-bit frames in RGB444 mode. Sources in the other
+    // format are converted through the DMA buffer.
+    bool writePixels(const uint16_t* data, size_t width, size_t height, size_t stride,
+                     PixelOrder order = PIXEL_NATIVE);
+    bool writePixelsAsync(const uint16_t* data, size_t len, PixelOrder order = PIXEL_NATIVE);
+    
+    // Palette indices of bpp bits (1, 2, 4 or 8), packed with the first
+    // pixel in the high bits of a byte. The palette is turned into a table
+    // in the bus format and the indices are expanded through it into the
+    // DMA buffer, one ping-pong chunk at a time. first is the pixel offset
+    // of the rectangle within each row, stride is in bytes.
+    bool writeIndexed(const uint8_t* data, size_t first, size_t width, size_t height, size_t stride,
+                      uint8_t bpp, const uint16_t* palette);
+    
+    // width * height pixels pulled from a stream straight into the DMA
+    // buffer, one chunk is decoded while the previous one is on the wire
+    bool writeStream(PixelStream& stream, size_t width, size_t height);
+    
+    // Solid fill of count pixels, one DMA transfer from a single color word
+    bool fillPixelsAsync(uint16_t color, size_t count);
+    
+    // Send commands, parameters and pixel rectangles in one go. The DMA
+    // walks a chain of control blocks that also switches DC and the SPI
+    // frame size, so the CPU triggers once and gets one completion
+    // interrupt. CS stays low until waitDmaIdle(). Without DMA, in RGB444
+    // mode, or if the chain does not fit Config::dma.chain_blocks, segments
+    // are sent one by one before returning.
+    bool writeChainAsync(const BusSegment* segments, size_t count);
     bool isDmaBusy() const { return _dma_busy; }
     bool isDmaEnabled() const { return _dma_enabled; }
+    void setDmaIrqEnabled(bool enabled);  // Completion interrupt on the calling core
     void abortDma();
     
+    // Bus history, lets callers tell whether panel state they cached still holds
+    uint32_t commandCount() const { return _command_count; }
+    size_t dataCount() const { return _data_count; }
+    
     // Hardware control
     void reset();
     void setBacklight(bool on);
@@ -58,6 +190,12 @@ public:
     void setWidth(uint16_t width) { _config.width = width; }
     void setHeight(uint16_t height) { _config.height = height; }
     void setRotation(Rotation rotation) { _config.rotation = rotation; }
+    void setColorMode(ColorMode mode) { _config.color_mode = mode; }
+    
+#ifdef ST7789_HOST_BUILD
+    // Emulated panel (host build only)
+    Emulator& emulator() { return _emu; }
+#endif
     
     // Friend declaration - allows interrupt handler to access private members
     friend void dma_complete_handler();
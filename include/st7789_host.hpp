@@ -0,0 +1,16 @@
+#pragma once
+
+// Host build stand-ins for the Pico SDK types used by the public headers.
+// Only included when ST7789_HOST_BUILD is defined (see CMakeLists.txt).
+
+#include <cstdint>
+#include <cstddef>
+
+typedef unsigned int uint;
+
+// SPI instances are opaque handles on the host, the emulator ignores them
+struct spi_inst;
+typedef struct spi_inst spi_inst_t;
+
+#define spi0 ((spi_inst_t*)0x1)
+#define spi1 ((spi_inst_t*)0x2)
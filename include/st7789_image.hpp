@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "st7789_config.hpp"
+#include "st7789_hal.hpp"
+
+namespace st7789 {
+
+// Compressed image codecs, see tools/image_encode.py
+enum ImageCodec : uint8_t {
+    IMAGE_RLE = 1,      // Runs and literal spans of RGB565 pixels
+    IMAGE_QOI = 2       // QOI-style ops on RGB565: index, small deltas, runs
+};
+
+// Blob layout: 'S', 'I', codec, 0, width and height as little-endian
+// 16-bit values, then the codec stream for all pixels in row order.
+//
+// RLE: a header byte n then (n & 0x7F) + 1 pixels - one little-endian
+// pixel repeated if bit 7 is set, otherwise that many literal pixels.
+//
+// QOI: every op yields one pixel except runs, which repeat the previous
+// one. The previous pixel starts black, a 64-entry table holds the pixels
+// seen by hash (r * 3 + g * 5 + b * 7) % 64 on the 5/6/5-bit channels.
+//   00iiiiii            table entry i
+//   01rrggbb            r, g and b differences of -2..1, biased by 2
+//   10gggggg rrrrbbbb   green -32..31 biased by 32, then red and blue
+//                       minus half the green difference, -8..7 biased by 8
+//   11nnnnnn            run of n + 1 pixels, n below 62
+//   11111110 lo hi      literal pixel
+//
+// Channels wrap around in both delta ops.
+class ImageDecoder : public PixelStream {
+public:
+    static const size_t HEADER_SIZE = 8;
+
+private:
+    const uint8_t* _data;       // Codec stream
+    const uint8_t* _start;      // First op, for rewinding
+    const uint8_t* _end;
+    uint8_t _codec;
+    uint16_t _width;
+    uint16_t _height;
+
+    // Pending pixels of the current op
+    uint16_t _color;
+    size_t _count;
+    bool _literal;              // RLE literal span, pixels still in the stream
+
+    // QOI state
+    uint16_t _prev;
+    uint16_t _index[64];
+
+    // Window returned by read() and the next image pixel
+    uint16_t _win_x;
+    uint16_t _win_y;
+    uint16_t _win_w;
+    uint16_t _win_h;
+    uint16_t _col;
+    uint16_t _row;
+
+    bool nextOp();
+    void decode(uint16_t* out, size_t count);
+
+public:
+    ImageDecoder();
+
+    // Parse the header and rewind, false if the blob is not an image
+    bool begin(const uint8_t* blob, size_t size);
+    uint16_t width() const { return _width; }
+    uint16_t height() const { return _height; }
+
+    // Part of the image read() returns, the whole image after begin().
+    // Pixels around it are decoded and dropped. Setting it after reading
+    // rewinds to the start of the image.
+    void setWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+    size_t read(uint16_t* pixels, size_t max) override;
+};
+
+} // namespace st7789
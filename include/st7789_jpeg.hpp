@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "st7789_config.hpp"
+#include "st7789_hal.hpp"
+
+namespace st7789 {
+
+// Baseline JPEG decoder - one MCU row at a time into a strip buffer, read
+// out in row order as RGB565. Handles 8-bit Huffman-coded sequential
+// images, grayscale or YCbCr with 4:4:4, 4:2:2, 4:4:0 or 4:2:0 sampling,
+// and restart markers. Chroma is upsampled by pixel replication. The IDCT
+// and color conversion use integer math only.
+//
+// RAM is about 4KB of tables plus the strip, allocated on the first read()
+// and covering only the window columns rounded out to whole MCUs, 8 or 16
+// rows high. It does not grow with the image width or height beyond the
+// window. Progressive and arithmetic coded files are refused.
+class JpegDecoder : public PixelStream {
+private:
+    struct HuffTable {
+        const uint8_t* values;      // Symbols, points into the file
+        uint16_t lookup[256];       // Codes up to 8 bits: length << 8 | symbol, 0 if longer
+        int32_t maxcode[18];        // Largest code of each length, -1 if none
+        uint16_t mincode[17];
+        uint16_t valptr[17];        // Index of the first symbol of each length
+        bool valid;
+    };
+
+    struct Component {
+        uint8_t id;
+        uint8_t h;                  // Sampling factors
+        uint8_t v;
+        uint8_t quant;
+        uint8_t dc_table;
+        uint8_t ac_table;
+        int32_t pred;               // DC predictor
+    };
+
+    // Working memory, allocated by begin()
+    struct Tables {
+        HuffTable dc[2];
+        HuffTable ac[2];
+        uint16_t quant[4][64];      // Natural order
+        int32_t coef[64];
+        int32_t work[64];
+        uint8_t blocks[6][64];      // Samples of one MCU: up to 4 Y, Cb, Cr
+    };
+
+    Tables* _tables;
+    uint16_t* _strip;               // Window columns of one MCU row, RGB565
+    uint16_t _strip_mcu;            // MCU column of the first strip pixel
+    uint16_t _width;
+    uint16_t _height;
+    Component _comp[3];
+    uint8_t _comp_count;
+    uint8_t _hmax;
+    uint8_t _vmax;
+    uint16_t _mcu_w;
+    uint16_t _mcu_h;
+    uint16_t _mcus_x;
+    uint16_t _strip_width;          // Pixels per strip row, whole MCUs
+
+    // Entropy-coded data
+    const uint8_t* _pos;
+    const uint8_t* _end;
+    uint32_t _bits;                 // Left-aligned bit buffer
+    int _bit_count;
+    bool _marker;                   // Hit a marker, zeros are fed from here
+    bool _error;
+    uint16_t _restart_interval;
+    uint16_t _restart_left;
+
+    // Strip and window state
+    uint16_t _strip_y;              // Image row of the first strip row
+    uint16_t _next_strip_y;
+    bool _strip_ready;
+    uint16_t _win_x;
+    uint16_t _win_y;
+    uint16_t _win_w;
+    uint16_t _win_h;
+    uint16_t _col;
+    uint16_t _row;
+
+    bool parseHeaders(const uint8_t* data, size_t size);
+    bool buildTable(HuffTable& table, const uint8_t* counts, const uint8_t* values);
+    void fillBits();
+    uint32_t getBits(int n);
+    int decodeSymbol(const HuffTable& table);
+    bool restart();
+    bool decodeBlock(Component& comp, uint8_t* out, bool transform);
+    bool decodeStrip(bool output);
+    void convertMcu(uint16_t* dst);
+
+public:
+    JpegDecoder();
+    virtual ~JpegDecoder();
+
+    // Parse the headers up to the scan and allocate the working memory,
+    // false for files this decoder does not handle. The data must stay
+    // valid while decoding.
+    bool begin(const uint8_t* data, size_t size);
+    void end();
+    uint16_t width() const { return _width; }
+    uint16_t height() const { return _height; }
+
+    // Part of the image read() returns, the whole image after begin().
+    // Only takes effect before the first read(). Rows above it are entropy
+    // decoded only, rows below it are never decoded.
+    void setWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+    // Decoding stops at the first invalid code, the rest reads as black
+    size_t read(uint16_t* pixels, size_t max) override;
+    bool hasError() const { return _error; }
+};
+
+} // namespace st7789
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include "st7789_config.hpp"
+#include "st7789_aa_font.hpp"
+
+namespace st7789 {
+
+// Forward declaration
+class ST7789;
+
+// Function run on the render core, e.g. to draw through ST7789 directly
+typedef void (*PipelineFunc)(ST7789& lcd, void* user);
+
+// One queued drawing call
+struct PipelineCommand {
+    static const size_t TEXT_MAX = 27;  // Longest string carried in one command
+
+    uint8_t type;
+    uint8_t size;           // Text scale or image pixel order
+    uint16_t color;
+    uint16_t bg;
+    int16_t args[6];        // Coordinates, meaning depends on the type
+    const void* data;       // Image pixels
+    const AAFont* font;
+    PipelineFunc func;
+    void* user;
+    char text[TEXT_MAX + 1];
+};
+
+// Render pipeline - core 1 owns the HAL and DMA and executes drawing calls
+// that core 0 pushes through a lock-free single-producer/single-consumer
+// ring, so core 0 goes on with application logic while pixels stream.
+// On the host build a std::thread stands in for core 1.
+//
+// While started, only the pipeline may touch the display; draw through it
+// or through call().
+class RenderPipeline {
+private:
+    ST7789* _lcd;
+    PipelineCommand* _slots;
+    uint16_t _capacity;                 // Slots, one is always left free
+
+    // Ring indices, each written by one side only
+    std::atomic<uint16_t> _head;        // Next slot to fill, producer
+    std::atomic<uint16_t> _tail;        // Next slot to execute, consumer
+    std::atomic<uint32_t> _executed;    // Commands finished, consumer
+    std::atomic<bool> _running;
+
+    // Strings longer than TEXT_MAX arrive in parts and are joined here.
+    // Sized by the producer while the queue is drained.
+    char* _text;
+    size_t _text_size;
+    size_t _text_len;                   // Bytes joined so far, consumer
+
+    // Producer statistics
+    uint32_t _pushed;
+    uint32_t _stalls;
+    uint16_t _max_depth;
+
+    bool push(PipelineCommand& cmd);
+    bool pushText(PipelineCommand& cmd, const char* str);
+    void execute(const PipelineCommand& cmd);
+    void run();
+    static void consumerEntry(void* user);
+
+public:
+    // Command types
+    enum CommandType : uint8_t {
+        CMD_FILL_RECT,
+        CMD_PIXEL,
+        CMD_LINE,
+        CMD_RECT,
+        CMD_CIRCLE,
+        CMD_FILL_CIRCLE,
+        CMD_FILL_TRIANGLE,
+        CMD_TEXT,
+        CMD_TEXT_AA,
+        CMD_TEXT_PART,                  // TEXT_MAX bytes of the next text command
+        CMD_IMAGE,
+        CMD_FLUSH,
+        CMD_CALL,
+        CMD_STOP
+    };
+
+    RenderPipeline(ST7789& lcd);
+    virtual ~RenderPipeline();
+
+    // Memory use is (depth + 1) * sizeof(PipelineCommand), plus the longest
+    // string over TEXT_MAX bytes once one is drawn
+    bool begin(uint16_t depth = 32);
+    void end();
+
+    // Hand the display to the render core and take it back, false if
+    // core 1 is already in use
+    bool start();
+    void stop();
+    bool isRunning() const { return _running.load(std::memory_order_acquire); }
+
+    // Queue a drawing call, waits for a free slot when the ring is full.
+    // Strings longer than TEXT_MAX take one slot per TEXT_MAX bytes; one
+    // longer than any before first waits for the queue to drain. Image data
+    // must stay valid until sync().
+    bool fillScreen(uint16_t color);
+    bool fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    bool drawPixel(int16_t x, int16_t y, uint16_t color);
+    bool drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    bool drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    bool drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+    bool fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+    bool fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+    bool drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size);
+    bool drawString(int16_t x, int16_t y, const char* str, const AAFont& font, uint16_t color, uint16_t bg);
+    bool drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data,
+                   PixelOrder order = PIXEL_NATIVE);
+    bool flush();                       // Framebuffer mode
+    bool call(PipelineFunc func, void* user = nullptr);
+
+    // Wait until everything queued so far has been executed and sent
+    void sync();
+
+    // Queue statistics
+    uint16_t depth() const;
+    uint16_t maxDepth() const { return _max_depth; }
+    uint32_t stalls() const { return _stalls; }   // Pushes that found the ring full
+    uint32_t pushed() const { return _pushed; }
+    uint32_t executed() const { return _executed.load(std::memory_order_acquire); }
+    void resetStats() { _stalls = 0; _max_depth = 0; }
+};
+
+} // namespace st7789
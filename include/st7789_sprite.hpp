@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "st7789_config.hpp"
+#include "st7789_framebuffer.hpp"
+
+namespace st7789 {
+
+// Forward declaration
+class ST7789;
+
+// Background callback - fill w pixels of screen row y starting at column x
+typedef void (*SpriteBackgroundFunc)(int16_t x, int16_t y, int16_t w, uint16_t* pixels, void* user);
+
+// Sprite layer - moving images over a background without a framebuffer.
+// Changes only touch the sprite list; update() composites the area each
+// changed sprite left and entered in a small buffer, background first and
+// then every sprite overlapping it in order, and sends it as one window.
+// Nothing is erased on screen first, so there is no flicker.
+class SpriteLayer {
+public:
+    enum BackgroundType : uint8_t {
+        BG_SOLID,
+        BG_IMAGE,
+        BG_CALLBACK
+    };
+
+private:
+    struct Sprite {
+        const uint16_t* image;      // RGB565, row-major
+        const uint8_t* mask;        // 1 bit per pixel, set is opaque, nullptr if unused
+        uint16_t width;
+        uint16_t height;
+        int16_t x;
+        int16_t y;
+        uint16_t key;               // Transparent color when use_key is set
+        bool use_key;
+        bool visible;
+        bool dirty;                 // Changed since the last update()
+        Rect drawn;                 // Screen area last sent, empty if none
+    };
+
+    ST7789* _lcd;
+    Sprite* _sprites;               // Drawing order, later ones on top
+    uint8_t _max_sprites;
+    uint8_t _count;
+    uint16_t* _buffer;              // Composite buffer
+    size_t _buffer_pixels;
+
+    // Background
+    BackgroundType _bg_type;
+    uint16_t _bg_color;             // Also around a background image
+    const uint16_t* _bg_image;      // Placed at the screen origin
+    uint16_t _bg_width;
+    uint16_t _bg_height;
+    SpriteBackgroundFunc _bg_func;
+    void* _bg_user;
+
+    // Statistics since resetStats()
+    uint32_t _pixels_drawn;
+    uint32_t _windows;
+
+    Sprite* sprite(int8_t id);
+    void markDirty(Sprite& s);
+    Rect spriteBounds(const Sprite& s) const;
+    void composite(const Rect& r, uint16_t* dst);
+    void drawArea(const Rect& r);
+
+public:
+    SpriteLayer(ST7789& lcd);
+    virtual ~SpriteLayer();
+
+    // Memory use is buffer_pixels * 2 bytes plus 32 bytes per sprite. An
+    // area larger than the buffer goes out in several windows; the buffer
+    // holds at least one screen row.
+    bool begin(uint8_t max_sprites = 8, size_t buffer_pixels = 4096);
+    void end();
+    bool isValid() const { return _buffer != nullptr; }
+
+    // Background behind the sprites. An image is placed at the screen
+    // origin with the color around it; the callback fills row spans. The
+    // screen is not repainted, call redraw() when the background changes.
+    void setBackground(uint16_t color);
+    void setBackground(const uint16_t* image, uint16_t w, uint16_t h, uint16_t color = BLACK);
+    void setBackground(SpriteBackgroundFunc func, void* user = nullptr);
+
+    // New sprite, hidden until show(). Returns its id, -1 if the layer is full.
+    // The image and mask must stay valid while the sprite exists.
+    int8_t addSprite(const uint16_t* image, uint16_t w, uint16_t h);
+    void setImage(int8_t id, const uint16_t* image, uint16_t w, uint16_t h);
+    // Pixels of this color are transparent
+    void setColorKey(int8_t id, uint16_t key);
+    // 1-bit mask, rows padded to whole bytes, first pixel in the high bit
+    void setMask(int8_t id, const uint8_t* mask);
+    void clearTransparency(int8_t id);
+    void moveTo(int8_t id, int16_t x, int16_t y);
+    void show(int8_t id, bool visible = true);
+    void hide(int8_t id) { show(id, false); }
+    int16_t spriteX(int8_t id) const;
+    int16_t spriteY(int8_t id) const;
+
+    // Send the areas of the sprites that changed
+    void update();
+    // Repaint the whole screen, background and sprites
+    void redraw();
+
+    uint8_t count() const { return _count; }
+    uint32_t pixelsDrawn() const { return _pixels_drawn; }
+    uint32_t windowsDrawn() const { return _windows; }
+    void resetStats() { _pixels_drawn = 0; _windows = 0; }
+};
+
+} // namespace st7789
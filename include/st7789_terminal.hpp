@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "st7789_config.hpp"
+
+namespace st7789 {
+
+// Forward declaration
+class ST7789;
+
+// Text console - a grid of character cells in the built-in 6x8 font. Writes
+// only touch the grid; update() redraws the cells that changed, one window
+// per run of cells with the same colors. Newlines at the bottom use the
+// panel's vertical scroll instead of a repaint when the console can own it.
+class Terminal {
+public:
+    static const uint8_t PALETTE_SIZE = 16;
+
+    // Default palette, ANSI order
+    enum TermColor : uint8_t {
+        TERM_BLACK, TERM_RED, TERM_GREEN, TERM_YELLOW,
+        TERM_BLUE, TERM_MAGENTA, TERM_CYAN, TERM_WHITE,
+        TERM_GRAY, TERM_BRIGHT_RED, TERM_BRIGHT_GREEN, TERM_BRIGHT_YELLOW,
+        TERM_BRIGHT_BLUE, TERM_BRIGHT_MAGENTA, TERM_BRIGHT_CYAN, TERM_BRIGHT_WHITE
+    };
+
+private:
+    struct Cell {
+        char ch;
+        uint8_t attr;           // Foreground index in the low nibble, background in the high one
+    };
+
+    ST7789* _lcd;
+    Cell* _cells;               // Ring of rows, _first_row is the top line
+    uint8_t* _dirty;            // One bit per cell, same indexing as _cells
+    char* _run;                 // Characters of the run being drawn
+    uint16_t _cols;
+    uint16_t _rows;
+    uint16_t _first_row;
+    uint8_t _size;              // Font scale
+    int16_t _top;               // Screen row of the first line
+    uint16_t _cursor_col;
+    uint16_t _cursor_row;
+    uint8_t _attr;
+    uint16_t _palette[PALETTE_SIZE];
+    bool _hw_scroll;            // Panel scroll area set up for the console
+    uint16_t _pending_scroll;   // Lines scrolled since the last update()
+
+    // Statistics since resetStats()
+    uint32_t _cells_drawn;
+    uint32_t _windows;
+
+    size_t cellIndex(uint16_t col, uint16_t row) const;
+    void setCell(uint16_t col, uint16_t row, char c, uint8_t attr, bool force);
+    void newLine();
+    void scrollUp();
+
+public:
+    Terminal(ST7789& lcd);
+    virtual ~Terminal();
+
+    // Console from screen row top down to top + height, or to the bottom of
+    // the screen with height 0. Memory use is cols * rows * 2 bytes plus one
+    // bit per cell, 3.4KB for 40x40 cells at size 1.
+    bool begin(uint8_t size = 1, int16_t top = 0, int16_t height = 0);
+    // Releases the scroll area, the panel shows its memory unscrolled again
+    void end();
+    bool isValid() const { return _cells != nullptr; }
+
+    // Writing, handles '\n', '\r', '\b' and '\t'
+    void putChar(char c);
+    void print(const char* str);
+    void printf(const char* format, ...);
+    void clear();
+
+    void setCursor(uint16_t col, uint16_t row);
+    uint16_t cursorCol() const { return _cursor_col; }
+    uint16_t cursorRow() const { return _cursor_row; }
+    void setColor(uint8_t fg, uint8_t bg = TERM_BLACK);
+    void setPalette(uint8_t index, uint16_t color);
+
+    // Redraw the changed cells
+    void update();
+
+    uint16_t cols() const { return _cols; }
+    uint16_t rows() const { return _rows; }
+    bool usesHardwareScroll() const { return _hw_scroll; }
+    uint32_t cellsDrawn() const { return _cells_drawn; }
+    uint32_t windowsDrawn() const { return _windows; }
+    void resetStats() { _cells_drawn = 0; _windows = 0; }
+};
+
+} // namespace st7789
@@ -1,5 +1,6 @@
 #include "st7789.hpp"
 #include <cstdio>
+#include <algorithm>
 
 namespace st7789 {
 
@@ -17,6 +18,8 @@ enum ST7789_CMD {
     ST7789_CASET   = 0x2A,
     ST7789_RASET   = 0x2B,
     ST7789_RAMWR   = 0x2C,
+    ST7789_VSCRDEF = 0x33,
+    ST7789_VSCSAD  = 0x37,
     ST7789_COLMOD  = 0x3A,
     ST7789_MADCTL  = 0x36,
     ST7789_RAMCTRL = 0xB0,
@@ -42,7 +45,16 @@ enum ST7789_CMD {
 #define MADCTL_BGR 0x08  // BGR order
 #define MADCTL_MH  0x04  // Horizontal refresh order
 
-ST7789::ST7789() : _gfx(this), _initialized(false) {
+// Frame memory rows, scroll area definitions always add up to this
+static const uint16_t GRAM_LINES = 320;
+
+// Window commands as memory the DMA can read
+static const uint8_t window_commands[3] = { ST7789_CASET, ST7789_RASET, ST7789_RAMWR };
+
+ST7789::ST7789() : _gfx(this), _initialized(false),
+    _win_x0(0), _win_y0(0), _win_x1(0), _win_y1(0),
+    _win_command_count(0), _win_valid(false),
+    _scroll_enabled(false), _scroll_top(0), _scroll_height(0), _scroll_offset(0) {
 }
 
 ST7789::~ST7789() {
@@ -82,8 +94,10 @@ bool ST7789::begin(spi_inst_t* spi, uint8_t cs_pin, uint8_t dc_pin,
 }
 
 void ST7789::initializeDisplay() {
-    // Hardware reset
+    // Hardware reset, also clears the scroll registers
     _hal.reset();
+    _scroll_enabled = false;
+    _scroll_offset = 0;
     
     // Software reset
     _hal.writeCommand(ST7789_SWRESET);
@@ -93,50 +107,45 @@ void ST7789::initializeDisplay() {
     _hal.writeCommand(ST7789_SLPOUT);
     _hal.delay(120);
     
-    // Set 16-bit color mode (65K)
-    _hal.writeCommand(ST7789_COLMOD);
-    _hal.writeData(0x55);  // 16 bits/pixel
+    // Interface pixel format, 16 bits/pixel unless RGB444 is configured
+    uint8_t colmod = _hal.getConfig().color_mode;
+    _hal.writeCommand(ST7789_COLMOD, &colmod, 1);
     
     // Initial MADCTL setting to 0x00 (refer to st7789_init_sequence in bak)
-    _hal.writeCommand(ST7789_MADCTL);
-    _hal.writeData(0x00);  // Set to default orientation
+    static const uint8_t madctl[] = { 0x00 };  // Set to default orientation
+    _hal.writeCommand(ST7789_MADCTL, madctl, sizeof(madctl));
     
     // Set display orientation
     setRotation(_hal.getConfig().rotation);
     
+    // Panel setup runs as one transaction, CS stays low between commands
+    static const uint8_t frctrl2[] = { 0x0F };  // 60Hz
+    static const uint8_t porctrl[] = { 0x0C, 0x0C, 0x00, 0x33, 0x33 };
+    static const uint8_t gctrl[] = { 0x35 };
+    static const uint8_t vcoms[] = { 0x28 };
+    static const uint8_t lcmctrl[] = { 0x0C };
+    static const uint8_t vdvvrhen[] = { 0x01, 0xFF };
+    static const uint8_t vrhs[] = { 0x10 };
+    static const uint8_t vdvs[] = { 0x20 };
+    
+    _hal.beginTransaction();
+    
     // Frame rate control
-    _hal.writeCommand(ST7789_FRCTRL2);
-    _hal.writeData(0x0F);  // 60Hz
+    _hal.writeCommand(ST7789_FRCTRL2, frctrl2, sizeof(frctrl2));
     
     // Display inversion
     _hal.writeCommand(ST7789_INVON);
     
     // Other initialization settings
-    _hal.writeCommand(ST7789_PORCTRL);
-    _hal.writeData(0x0C);
-    _hal.writeData(0x0C);
-    _hal.writeData(0x00);
-    _hal.writeData(0x33);
-    _hal.writeData(0x33);
-    
-    _hal.writeCommand(ST7789_GCTRL);
-    _hal.writeData(0x35);
-    
-    _hal.writeCommand(ST7789_VCOMS);
-    _hal.writeData(0x28);
-    
-    _hal.writeCommand(ST7789_LCMCTRL);
-    _hal.writeData(0x0C);
-    
-    _hal.writeCommand(ST7789_VDVVRHEN);
-    _hal.writeData(0x01);
-    _hal.writeData(0xFF);
+    _hal.writeCommand(ST7789_PORCTRL, porctrl, sizeof(porctrl));
+    _hal.writeCommand(ST7789_GCTRL, gctrl, sizeof(gctrl));
+    _hal.writeCommand(ST7789_VCOMS, vcoms, sizeof(vcoms));
+    _hal.writeCommand(ST7789_LCMCTRL, lcmctrl, sizeof(lcmctrl));
+    _hal.writeCommand(ST7789_VDVVRHEN, vdvvrhen, sizeof(vdvvrhen));
+    _hal.writeCommand(ST7789_VRHS, vrhs, sizeof(vrhs));
+    _hal.writeCommand(ST7789_VDVS, vdvs, sizeof(vdvs));
     
-    _hal.writeCommand(ST7789_VRHS);
-    _hal.writeData(0x10);
-    
-    _hal.writeCommand(ST7789_VDVS);
-    _hal.writeData(0x20);
+    _hal.endTransaction();
     
     // Turn on display
     _hal.writeCommand(ST7789_NORON);
@@ -156,30 +165,77 @@ void ST7789::initializeDisplay() {
 }
 
 void ST7789::setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
-    // Set column address range
-    _hal.writeCommand(ST7789_CASET);
+    // Cached window still holds if nothing else was sent since our RAMWR
+    bool cached = _win_valid && _hal.commandCount() == _win_command_count;
+    
+    // Pixels written so far, only whole ones: 2 bytes each, or 3 bytes per
+    // pair in RGB444 where an odd run ends with a pad nibble
+    size_t bytes = _hal.dataCount();
+    bool rgb444 = (_hal.getConfig().color_mode == COLOR_RGB444);
+    bool aligned = rgb444 ? (bytes % 3 == 0) : (bytes % 2 == 0);
+    
+    if (cached && aligned) {
+        // Where the next pixel of the open RAMWR lands, wrapping inside the window
+        uint32_t win_w = _win_x1 - _win_x0 + 1;
+        uint32_t win_h = _win_y1 - _win_y0 + 1;
+        uint32_t written = rgb444 ? bytes / 3 * 2 : bytes / 2;
+        uint32_t pos = written % (win_w * win_h);
+        uint16_t px = _win_x0 + pos % win_w;
+        uint16_t py = _win_y0 + pos / win_w;
+        
+        // Keep writing if the new window follows the pointer: a run within
+        // the current row, or whole rows of the same columns
+        if (px == x0 && py == y0) {
+            bool row_run = (y0 == y1 && x1 <= _win_x1);
+            bool rows = (x0 == _win_x0 && x1 == _win_x1 && y1 <= _win_y1);
+            if (row_run || rows) {
+                return;
+            }
+        }
+    }
+    
+    // Window setup is one transaction, only DC toggles between the commands
+    _hal.beginTransaction();
+    
     uint8_t data[4];
-    data[0] = (x0 >> 8) & 0xFF;
-    data[1] = x0 & 0xFF;
-    data[2] = (x1 >> 8) & 0xFF;
-    data[3] = x1 & 0xFF;
-    _hal.writeDataBulk(data, 4);
-    
-    // Set row address range
-    _hal.writeCommand(ST7789_RASET);
-    data[0] = (y0 >> 8) & 0xFF;
-    data[1] = y0 & 0xFF;
-    data[2] = (y1 >> 8) & 0xFF;
-    data[3] = y1 & 0xFF;
-    _hal.writeDataBulk(data, 4);
+    
+    // Set column address range, unless unchanged
+    if (!cached || x0 != _win_x0 || x1 != _win_x1) {
+        data[0] = (x0 >> 8) & 0xFF;
+        data[1] = x0 & 0xFF;
+        data[2] = (x1 >> 8) & 0xFF;
+        data[3] = x1 & 0xFF;
+        _hal.writeCommand(ST7789_CASET, data, 4);
+    }
+    
+    // Set row address range, unless unchanged
+    if (!cached || y0 != _win_y0 || y1 != _win_y1) {
+        data[0] = (y0 >> 8) & 0xFF;
+        data[1] = y0 & 0xFF;
+        data[2] = (y1 >> 8) & 0xFF;
+        data[3] = y1 & 0xFF;
+        _hal.writeCommand(ST7789_RASET, data, 4);
+    }
     
     // Prepare for memory write
     _hal.writeCommand(ST7789_RAMWR);
+    
+    _hal.endTransaction();
+    
+    _win_x0 = x0;
+    _win_y0 = y0;
+    _win_x1 = x1;
+    _win_y1 = y1;
+    _win_command_count = _hal.commandCount();
+    _win_valid = true;
 }
 
 void ST7789::setRotation(Rotation rotation) {
     if (!_initialized) return;
     
+    // Scroll areas are defined for the old orientation
+    resetScroll();
+    
     uint8_t madctl = 0;
     uint16_t old_width = _hal.getConfig().width;
     uint16_t old_height = _hal.getConfig().height;
@@ -220,10 +276,20 @@ void ST7789::setRotation(Rotation rotation) {
             break;
     }
     
-    _hal.writeCommand(ST7789_MADCTL);
-    _hal.writeData(madctl);
+    _hal.writeCommand(ST7789_MADCTL, &madctl, 1);
     _hal.setRotation(rotation);
     
+    // Reshape the framebuffer, the panel content no longer matches it
+    if (isFrameBufferEnabled()) {
+        const Config& config = _hal.getConfig();
+        if (_fb.isIndexed()) {
+            _fb.beginIndexed(config.width, config.height, _fb.bitsPerPixel(), _fb.palette(), _fb.indexBuffer());
+        } else {
+            _fb.begin(config.width, config.height, _fb.buffer());
+        }
+        _fb.markAllDirty();
+    }
+    
     // If size has changed, re-set screen window
     if (old_width != _hal.getConfig().width || old_height != _hal.getConfig().height) {
         // Set new address window range to full screen
@@ -236,7 +302,9 @@ void ST7789::invertDisplay(bool invert) {
 }
 
 void ST7789::fillScreen(uint16_t color) {
-    if (_hal.isDmaEnabled()) {
+    if (isFrameBufferEnabled()) {
+        _gfx.fillRect(0, 0, _hal.getConfig().width, _hal.getConfig().height, color);
+    } else if (_hal.isDmaEnabled()) {
         fillRectDMA(0, 0, _hal.getConfig().width, _hal.getConfig().height, color);
     } else {
         _gfx.fillRect(0, 0, _hal.getConfig().width, _hal.getConfig().height, color);
@@ -248,6 +316,16 @@ void ST7789::sleepDisplay(bool sleep) {
     _hal.delay(120);
 }
 
+void ST7789::setColorMode(ColorMode mode) {
+    _hal.setColorMode(mode);
+    
+    // GRAM keeps its content, only the format of new pixels changes
+    if (_initialized) {
+        uint8_t colmod = mode;
+        _hal.writeCommand(ST7789_COLMOD, &colmod, 1);
+    }
+}
+
 void ST7789::setBacklight(bool on) {
     _hal.setBacklight(on);
 }
@@ -262,21 +340,23 @@ void ST7789::reset() {
     initializeDisplay();
 }
 
-bool ST7789::drawImageDMA(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data) {
+bool ST7789::drawImageDMA(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data, PixelOrder order) {
     if (!_initialized || x >= _hal.getConfig().width || y >= _hal.getConfig().height) {
         return false;
     }
     
+    // In framebuffer mode the image is sent by the next flush()
+    if (isFrameBufferEnabled()) {
+        _gfx.drawImage(x, y, w, h, data, order);
+        return true;
+    }
+    
     // Clip coordinates
     int16_t x1 = x + w - 1;
     int16_t y1 = y + h - 1;
+    int16_t cx = x < 0 ? 0 : x;
+    int16_t cy = y < 0 ? 0 : y;
     
-    if (x < 0) {
-        x = 0;
-    }
-    if (y < 0) {
-        y = 0;
-    }
     if (x1 >= _hal.getConfig().width) {
         x1 = _hal.getConfig().width - 1;
     }
@@ -284,18 +364,28 @@ bool ST7789::drawImageDMA(int16_t x, int16_t y, int16_t w, int16_t h, const uint
         y1 = _hal.getConfig().height - 1;
     }
     
-    w = x1 - x + 1;
-    h = y1 - y + 1;
-    
-    if (w <= 0 || h <= 0) {
+    if (x1 < cx || y1 < cy) {
         return false;
     }
     
-    // Set drawing window
-    setAddrWindow(x, y, x1, y1);
-    
-    // Use DMA to transfer image data
-    return _hal.writeDataDma(data, w * h);
+    // Window and pixels under one chip select, one window per span of
+    // memory rows while scrolled
+    ScrollSpan spans[4];
+    uint8_t count = scrollSpans(cy, y1 - cy + 1, spans);
+    bool ok = true;
+    _hal.beginTransaction();
+    for (uint8_t i = 0; i < count; i++) {
+        const ScrollSpan& span = spans[i];
+        setAddrWindow(cx, span.memory_y, x1, span.memory_y + span.rows - 1);
+        
+        // DMA reads the source directly, no copy or byte swap
+        const uint16_t* src = data + (span.screen_y - y) * w + (cx - x);
+        if (!_hal.writePixels(src, x1 - cx + 1, span.rows, w, order)) {
+            ok = false;
+        }
+    }
+    _hal.endTransaction();
+    return ok && _hal.isDmaEnabled();
 }
 
 bool ST7789::fillRectDMA(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
@@ -304,6 +394,12 @@ bool ST7789::fillRectDMA(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t co
         return false;
     }
     
+    // In framebuffer mode the fill is sent by the next flush()
+    if (isFrameBufferEnabled()) {
+        _gfx.fillRect(x, y, w, h, color);
+        return true;
+    }
+    
     // Clip coordinates
     int16_t x1 = x + w - 1;
     int16_t y1 = y + h - 1;
@@ -328,33 +424,278 @@ bool ST7789::fillRectDMA(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t co
         return false;
     }
     
-    // Set drawing window
-    setAddrWindow(x, y, x1, y1);
+    // Window and pixels under one chip select, one window per span of
+    // memory rows while scrolled
+    ScrollSpan spans[4];
+    uint8_t count = scrollSpans(y, h, spans);
+    bool ok = true;
+    _hal.beginTransaction();
+    for (uint8_t i = 0; i < count; i++) {
+        const ScrollSpan& span = spans[i];
+        setAddrWindow(x, span.memory_y, x1, span.memory_y + span.rows - 1);
+        
+        // One DMA transfer per window, returns while it runs
+        if (!_hal.fillPixelsAsync(color, (size_t)w * span.rows)) {
+            ok = false;
+        }
+    }
+    _hal.endTransaction();
+    return ok && _hal.isDmaEnabled();
+}
+
+bool ST7789::setScrollArea(uint16_t top_fixed, uint16_t bottom_fixed) {
+    if (!_initialized) {
+        return false;
+    }
     
-    // Prepare fill data
-    const size_t buffer_size = 256; // Use a small buffer
-    uint16_t fill_buffer[buffer_size];
-    for (size_t i = 0; i < buffer_size; i++) {
-        fill_buffer[i] = color;
+    // The panel scrolls along its native vertical axis only
+    Rotation rotation = _hal.getConfig().rotation;
+    uint16_t height = _hal.getConfig().height;
+    if (rotation == ROTATION_90 || rotation == ROTATION_270 ||
+        height > GRAM_LINES || top_fixed + bottom_fixed >= height) {
+        return false;
     }
     
-    // Calculate total pixels
-    size_t total_pixels = w * h;
-    size_t pixels_sent = 0;
+    _scroll_top = top_fixed;
+    _scroll_height = height - top_fixed - bottom_fixed;
+    
+    // Areas in frame memory lines from the native top. Rotated by 180
+    // degrees the screen's bottom comes first; memory rows past the
+    // screen join the fixed area there.
+    uint16_t tfa = (rotation == ROTATION_0) ? top_fixed : GRAM_LINES - height + bottom_fixed;
+    uint16_t bfa = GRAM_LINES - tfa - _scroll_height;
+    uint8_t data[6];
+    data[0] = (tfa >> 8) & 0xFF;
+    data[1] = tfa & 0xFF;
+    data[2] = (_scroll_height >> 8) & 0xFF;
+    data[3] = _scroll_height & 0xFF;
+    data[4] = (bfa >> 8) & 0xFF;
+    data[5] = bfa & 0xFF;
+    _hal.writeCommand(ST7789_VSCRDEF, data, sizeof(data));
+    
+    _scroll_enabled = true;
+    setScrollOffset(0);
+    return true;
+}
+
+void ST7789::setScrollOffset(uint16_t offset) {
+    if (!_scroll_enabled) return;
+    
+    _scroll_offset = offset % _scroll_height;
+    
+    // Start line is the frame memory line shown first in the scroll area.
+    // Rotated by 180 degrees the area is shown bottom up.
+    uint16_t vsp;
+    if (_hal.getConfig().rotation == ROTATION_0) {
+        vsp = _scroll_top + _scroll_offset;
+    } else {
+        uint16_t tfa = GRAM_LINES - _scroll_top - _scroll_height;
+        vsp = tfa + (_scroll_height - _scroll_offset) % _scroll_height;
+    }
+    uint8_t data[2];
+    data[0] = (vsp >> 8) & 0xFF;
+    data[1] = vsp & 0xFF;
+    _hal.writeCommand(ST7789_VSCSAD, data, sizeof(data));
+}
+
+void ST7789::scroll(int16_t rows) {
+    if (!_scroll_enabled) return;
+    
+    int32_t offset = ((int32_t)_scroll_offset + rows) % _scroll_height;
+    if (offset < 0) {
+        offset += _scroll_height;
+    }
+    setScrollOffset(offset);
+}
+
+void ST7789::resetScroll() {
+    if (!_scroll_enabled) return;
+    
+    // Whole memory as scroll area from line 0 shows it unscrolled
+    static const uint8_t vscrdef[] = { 0, 0, GRAM_LINES >> 8, GRAM_LINES & 0xFF, 0, 0 };
+    static const uint8_t vscsad[] = { 0, 0 };
+    _hal.beginTransaction();
+    _hal.writeCommand(ST7789_VSCRDEF, vscrdef, sizeof(vscrdef));
+    _hal.writeCommand(ST7789_VSCSAD, vscsad, sizeof(vscsad));
+    _hal.endTransaction();
+    
+    _scroll_enabled = false;
+    _scroll_offset = 0;
+}
+
+int16_t ST7789::screenToMemoryY(int16_t y) const {
+    if (!_scroll_enabled || y < _scroll_top || y >= _scroll_top + _scroll_height) {
+        return y;
+    }
+    return _scroll_top + (y - _scroll_top + _scroll_offset) % _scroll_height;
+}
+
+int16_t ST7789::memoryToScreenY(int16_t y) const {
+    if (!_scroll_enabled || y < _scroll_top || y >= _scroll_top + _scroll_height) {
+        return y;
+    }
+    return _scroll_top + (y - _scroll_top + _scroll_height - _scroll_offset) % _scroll_height;
+}
+
+uint8_t ST7789::scrollSpans(int16_t y, int16_t h, ScrollSpan* spans) const {
+    if (!_scroll_enabled) {
+        spans[0].screen_y = y;
+        spans[0].memory_y = y;
+        spans[0].rows = h;
+        return 1;
+    }
+    
+    // Fixed rows map to themselves, the scroll area breaks where it wraps
+    int16_t end = y + h;
+    int16_t area_end = _scroll_top + _scroll_height;
+    uint8_t count = 0;
+    while (y < end) {
+        int16_t memory_y = y;
+        int16_t stop = end;
+        if (y < _scroll_top) {
+            stop = std::min<int16_t>(end, _scroll_top);
+        } else if (y < area_end) {
+            int16_t pos = (y - _scroll_top + _scroll_offset) % _scroll_height;
+            memory_y = _scroll_top + pos;
+            stop = std::min<int16_t>(end, y + _scroll_height - pos);
+            stop = std::min<int16_t>(stop, area_end);
+        }
+        spans[count].screen_y = y;
+        spans[count].memory_y = memory_y;
+        spans[count].rows = stop - y;
+        count++;
+        y = stop;
+    }
+    return count;
+}
+
+bool ST7789::enableFrameBuffer(uint16_t* buffer) {
+    if (!_initialized) {
+        return false;
+    }
+    
+    // Full screen at RGB565, 150KB for 240x320
+    if (!_fb.begin(_hal.getConfig().width, _hal.getConfig().height, buffer)) {
+        printf("Failed to allocate framebuffer\n");
+        return false;
+    }
     
-    // Send in batches
-    while (pixels_sent < total_pixels) {
-        size_t pixels_to_send = (total_pixels - pixels_sent > buffer_size) ? 
-                                buffer_size : (total_pixels - pixels_sent);
+    _gfx.setFrameBuffer(&_fb);
+    _fb.markAllDirty();
+    return true;
+}
+
+bool ST7789::enableIndexedFrameBuffer(uint8_t bpp, const uint16_t* palette, uint8_t* buffer) {
+    if (!_initialized) {
+        return false;
+    }
+    
+    // Full screen of palette indices, 38KB for 240x320 at 4 bits
+    if (!_fb.beginIndexed(_hal.getConfig().width, _hal.getConfig().height, bpp, palette, buffer)) {
+        printf("Failed to allocate indexed framebuffer\n");
+        return false;
+    }
+    
+    _gfx.setFrameBuffer(&_fb);
+    _fb.markAllDirty();
+    return true;
+}
+
+void ST7789::disableFrameBuffer() {
+    _gfx.setFrameBuffer(nullptr);
+    _fb.end();
+}
+
+bool ST7789::flush() {
+    bool ok = flushAsync();
+    if (!_hal.waitDmaIdle()) {
+        ok = false;
+    }
+    return ok;
+}
+
+bool ST7789::flushAsync() {
+    if (!_initialized || !isFrameBufferEnabled()) {
+        return false;
+    }
+    if (_fb.dirtyCount() == 0) {
+        return true;
+    }
+    
+    // Palette indices need expanding on the way out, which the chain cannot
+    // do: one window per dirty rectangle, each streamed through the DMA
+    // buffer. The call returns once everything is sent.
+    if (_fb.isIndexed()) {
+        bool ok = true;
+        _hal.beginTransaction();
+        for (uint8_t i = 0; i < _fb.dirtyCount(); i++) {
+            const Rect& r = _fb.dirtyRect(i);
+            setAddrWindow(r.x, r.y, r.x + r.w - 1, r.y + r.h - 1);
+            if (!_hal.writeIndexed(_fb.indexRow(r.y), r.x - _fb.bounds().x, r.w, r.h, _fb.rowBytes(),
+                                   _fb.bitsPerPixel(), _fb.palette())) {
+                ok = false;
+            }
+        }
+        _hal.endTransaction();
+        _fb.clearDirty();
+        return ok;
+    }
+    
+    // One window per dirty rectangle, all of them in a single DMA chain
+    // that reads the framebuffer directly. Window parameters live in
+    // _chain_params so they outlast the call.
+    bool cached = _win_valid && _hal.commandCount() == _win_command_count;
+    uint16_t x0 = _win_x0, y0 = _win_y0, x1 = _win_x1, y1 = _win_y1;
+    size_t n = 0;
+    
+    for (uint8_t i = 0; i < _fb.dirtyCount(); i++) {
+        const Rect& r = _fb.dirtyRect(i);
+        uint16_t rx1 = r.x + r.w - 1;
+        uint16_t ry1 = r.y + r.h - 1;
+        uint8_t* params = _chain_params[i];
         
-        if (!_hal.writeDataDma(fill_buffer, pixels_to_send)) {
-            return false;
+        // Column and row ranges only when they differ from the previous window
+        if (!cached || r.x != x0 || rx1 != x1) {
+            params[0] = (r.x >> 8) & 0xFF;
+            params[1] = r.x & 0xFF;
+            params[2] = (rx1 >> 8) & 0xFF;
+            params[3] = rx1 & 0xFF;
+            _chain[n++] = { BusSegment::COMMAND, 1, 0, 0, &window_commands[0] };
+            _chain[n++] = { BusSegment::DATA, 4, 0, 0, &params[0] };
+        }
+        if (!cached || r.y != y0 || ry1 != y1) {
+            params[4] = (r.y >> 8) & 0xFF;
+            params[5] = r.y & 0xFF;
+            params[6] = (ry1 >> 8) & 0xFF;
+            params[7] = ry1 & 0xFF;
+            _chain[n++] = { BusSegment::COMMAND, 1, 0, 0, &window_commands[1] };
+            _chain[n++] = { BusSegment::DATA, 4, 0, 0, &params[4] };
         }
+        _chain[n++] = { BusSegment::COMMAND, 1, 0, 0, &window_commands[2] };
+        _chain[n++] = { BusSegment::PIXELS, (uint16_t)r.w, (uint16_t)r.h, _fb.width(),
+                        _fb.pixelPtr(r.x, r.y) };
         
-        pixels_sent += pixels_to_send;
+        cached = true;
+        x0 = r.x;
+        y0 = r.y;
+        x1 = rx1;
+        y1 = ry1;
     }
     
-    return true;
+    _hal.beginTransaction();
+    bool ok = _hal.writeChainAsync(_chain, n);
+    _hal.endTransaction();
+    
+    // The panel is left on the last window
+    _win_x0 = x0;
+    _win_y0 = y0;
+    _win_x1 = x1;
+    _win_y1 = y1;
+    _win_command_count = _hal.commandCount();
+    _win_valid = true;
+    
+    _fb.clearDirty();
+    return ok;
 }
 
-} // namespace st7789 
\ No newline at end of file
+} // namespace st7789
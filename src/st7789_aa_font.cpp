@@ -0,0 +1,70 @@
+#include "st7789_aa_font.hpp"
+
+namespace st7789 {
+
+int32_t findGlyph(const AAFont& font, uint32_t codepoint) {
+    if (!font.codepoints) {
+        if (codepoint < font.first || codepoint > font.last) {
+            return -1;
+        }
+        return codepoint - font.first;
+    }
+
+    // Binary search over the sorted index
+    uint32_t lo = 0;
+    uint32_t hi = font.glyph_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (font.codepoints[mid] < codepoint) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < font.glyph_count && font.codepoints[lo] == codepoint) {
+        return lo;
+    }
+    return -1;
+}
+
+uint32_t decodeUtf8(const char*& str) {
+    const uint8_t* s = (const uint8_t*)str;
+    uint32_t cp;
+    uint8_t extra;
+
+    if (s[0] < 0x80) {
+        str++;
+        return s[0];
+    } else if ((s[0] & 0xE0) == 0xC0) {
+        cp = s[0] & 0x1F;
+        extra = 1;
+    } else if ((s[0] & 0xF0) == 0xE0) {
+        cp = s[0] & 0x0F;
+        extra = 2;
+    } else if ((s[0] & 0xF8) == 0xF0) {
+        cp = s[0] & 0x07;
+        extra = 3;
+    } else {
+        str++;
+        return 0xFFFD;
+    }
+
+    // Stop at a missing continuation byte (also the terminating zero)
+    for (uint8_t i = 1; i <= extra; i++) {
+        if ((s[i] & 0xC0) != 0x80) {
+            str += i;
+            return 0xFFFD;
+        }
+        cp = (cp << 6) | (s[i] & 0x3F);
+    }
+    str += extra + 1;
+
+    // Overlong forms, surrogates and values past U+10FFFF
+    static const uint32_t min_cp[4] = { 0, 0x80, 0x800, 0x10000 };
+    if (cp < min_cp[extra] || (cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF) {
+        return 0xFFFD;
+    }
+    return cp;
+}
+
+} // namespace st7789
@@ -0,0 +1,91 @@
+#include "st7789_band.hpp"
+#include "st7789.hpp"
+#include <cstdio>
+
+namespace st7789 {
+
+BandRenderer::BandRenderer(ST7789& lcd) : _lcd(&lcd), _band_height(0) {
+}
+
+BandRenderer::~BandRenderer() {
+    end();
+}
+
+bool BandRenderer::begin(uint16_t band_height) {
+    if (band_height == 0) {
+        return false;
+    }
+    _band_height = band_height;
+    return allocate();
+}
+
+void BandRenderer::end() {
+    _bands[0].end();
+    _bands[1].end();
+}
+
+bool BandRenderer::allocate() {
+    uint16_t width = _lcd->hal().getConfig().width;
+    for (int i = 0; i < 2; i++) {
+        if (!_bands[i].begin(width, _band_height)) {
+            printf("Failed to allocate band buffer\n");
+            end();
+            return false;
+        }
+        // Bands are always sent whole
+        _bands[i].setDirtyTracking(false);
+    }
+    return true;
+}
+
+bool BandRenderer::render(BandDrawFunc draw, void* user, uint16_t bg) {
+    if (_band_height == 0 || !draw) {
+        return false;
+    }
+
+    // Follow rotation changes since begin()
+    uint16_t width = _lcd->hal().getConfig().width;
+    uint16_t height = _lcd->hal().getConfig().height;
+    if (_bands[0].width() != width && !allocate()) {
+        return false;
+    }
+
+    Graphics& gfx = _lcd->graphics();
+    FrameBuffer* saved_target = gfx.frameBuffer();
+    HAL& hal = _lcd->hal();
+    bool ok = true;
+    int current = 0;
+
+    // The chip stays selected for the whole frame
+    hal.beginTransaction();
+    for (uint16_t y = 0; y < height; y += _band_height) {
+        FrameBuffer& band = _bands[current];
+        uint16_t rows = (height - y < _band_height) ? height - y : _band_height;
+
+        // Rasterize this band while the previous one is still on the wire
+        band.setOrigin(0, y);
+        band.fillRect(0, y, width, rows, bg);
+        gfx.setFrameBuffer(&band);
+        draw(gfx, user);
+
+        // The window runs to the bottom of the screen so every later band
+        // continues the open memory write without new window commands.
+        // DMA streams the band straight from the buffer as 16-bit frames.
+        _lcd->setAddrWindow(0, y, width - 1, height - 1);
+        if (!hal.writePixelsAsync(band.buffer(), (size_t)width * rows)) {
+            ok = false;
+        }
+
+        current ^= 1;
+    }
+
+    if (!hal.waitDmaIdle()) {
+        ok = false;
+    }
+    hal.endTransaction();
+
+    gfx.setFrameBuffer(saved_target);
+    return ok;
+}
+
+} // namespace st7789
@@ -0,0 +1,162 @@
+#include "st7789_core.hpp"
+#include <atomic>
+#ifdef ST7789_HOST_BUILD
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#else
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+#endif
+
+namespace st7789 {
+
+static std::atomic<bool> core1_busy(false);
+
+#ifdef ST7789_HOST_BUILD
+// The thread sleeps on a condition variable between jobs
+static std::thread core1_thread;
+static std::mutex core1_mutex;
+static std::condition_variable core1_cv;
+static SecondCore::Entry core1_entry = nullptr;
+static void* core1_user = nullptr;
+static bool core1_done = false;
+static bool core1_stop = false;
+
+static void core1Loop() {
+    std::unique_lock<std::mutex> lock(core1_mutex);
+    while (true) {
+        core1_cv.wait(lock, [] { return core1_entry != nullptr || core1_stop; });
+        if (!core1_entry) {
+            return;
+        }
+        SecondCore::Entry entry = core1_entry;
+        lock.unlock();
+        entry(core1_user);
+        lock.lock();
+        core1_entry = nullptr;
+        core1_done = true;
+        core1_cv.notify_all();
+    }
+}
+
+// A joinable std::thread must not be destroyed at exit
+static void releaseAtExit() {
+    SecondCore::release();
+}
+#else
+// Core 1 sleeps in WFE between jobs; the entry is published last
+static std::atomic<SecondCore::Entry> core1_entry(nullptr);
+static void* core1_user = nullptr;
+static std::atomic<bool> core1_done(false);
+static bool core1_started = false;      // Only touched by core 0
+
+static void core1Loop() {
+    while (true) {
+        SecondCore::Entry entry = core1_entry.load(std::memory_order_acquire);
+        if (!entry) {
+            __wfe();
+            continue;
+        }
+        entry(core1_user);
+        core1_entry.store(nullptr, std::memory_order_relaxed);
+        core1_done.store(true, std::memory_order_release);
+        __sev();
+    }
+}
+#endif
+
+bool SecondCore::launch(Entry entry, void* user) {
+    bool expected = false;
+    if (!entry || !core1_busy.compare_exchange_strong(expected, true)) {
+        return false;
+    }
+
+#ifdef ST7789_HOST_BUILD
+    if (!core1_thread.joinable()) {
+        static bool registered = false;
+        if (!registered) {
+            atexit(releaseAtExit);
+            registered = true;
+        }
+        core1_stop = false;
+        core1_thread = std::thread(core1Loop);
+    }
+    {
+        std::lock_guard<std::mutex> lock(core1_mutex);
+        core1_entry = entry;
+        core1_user = user;
+        core1_done = false;
+    }
+    core1_cv.notify_all();
+#else
+    // Started once, later launches only wake it up
+    if (!core1_started) {
+        multicore_reset_core1();
+        multicore_launch_core1(core1Loop);
+        core1_started = true;
+    }
+    core1_user = user;
+    core1_done.store(false, std::memory_order_relaxed);
+    core1_entry.store(entry, std::memory_order_release);
+    __sev();
+#endif
+    return true;
+}
+
+void SecondCore::join() {
+    if (!core1_busy.load(std::memory_order_acquire)) {
+        return;
+    }
+
+#ifdef ST7789_HOST_BUILD
+    std::unique_lock<std::mutex> lock(core1_mutex);
+    core1_cv.wait(lock, [] { return core1_done; });
+#else
+    while (!core1_done.load(std::memory_order_acquire)) {
+        __wfe();
+    }
+#endif
+    core1_busy.store(false, std::memory_order_release);
+}
+
+void SecondCore::release() {
+    join();
+
+#ifdef ST7789_HOST_BUILD
+    if (core1_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(core1_mutex);
+            core1_stop = true;
+        }
+        core1_cv.notify_all();
+        core1_thread.join();
+    }
+#else
+    if (core1_started) {
+        multicore_reset_core1();
+        core1_started = false;
+    }
+#endif
+}
+
+bool SecondCore::isBusy() {
+    return core1_busy.load(std::memory_order_acquire);
+}
+
+void SecondCore::wait() {
+#ifdef ST7789_HOST_BUILD
+    std::this_thread::yield();
+#else
+    __wfe();
+#endif
+}
+
+void SecondCore::signal() {
+#ifndef ST7789_HOST_BUILD
+    __sev();
+#endif
+}
+
+} // namespace st7789
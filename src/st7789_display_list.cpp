@@ -0,0 +1,650 @@
+#include "st7789_display_list.hpp"
+#include "st7789.hpp"
+#include "st7789_core.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+namespace st7789 {
+
+DisplayList::DisplayList(ST7789& lcd) :
+    _lcd(&lcd),
+    _commands(nullptr),
+    _max_commands(0),
+    _command_count(0),
+    _text(nullptr),
+    _text_size(0),
+    _text_used(0),
+    _overflow(false),
+    _tile_width(0),
+    _tile_height(0),
+    _tile_pixels(nullptr),
+    _tile_slots(0),
+    _tile_cols(0),
+    _tile_rows(0),
+    _bin_start(nullptr),
+    _bin_refs(nullptr),
+    _bin_capacity(0),
+    _signatures(nullptr),
+    _signatures_valid(false),
+    _jobs(nullptr),
+    _job_count(0),
+    _bg(BLACK),
+    _parallel(false),
+    _worker_gfx(&lcd),
+    _next_job(0),
+    _released(0),
+    _tiles_by_core{ 0, 0 },
+    _tiles_sent(0),
+    _tiles_skipped(0),
+    _commands_drawn(0),
+    _commands_culled(0) {
+}
+
+DisplayList::~DisplayList() {
+    end();
+}
+
+bool DisplayList::begin(uint16_t max_commands, size_t text_bytes, uint16_t tile_width, uint16_t tile_height) {
+    end();
+    if (max_commands == 0 || tile_width == 0 || tile_height == 0) {
+        return false;
+    }
+
+    _commands = (Command*)malloc(sizeof(Command) * max_commands);
+    _text = text_bytes ? (char*)malloc(text_bytes) : nullptr;
+    _tile_pixels = (uint16_t*)malloc((size_t)2 * tile_width * tile_height * sizeof(uint16_t));
+    if (!_commands || (text_bytes && !_text) || !_tile_pixels) {
+        printf("Failed to allocate display list\n");
+        end();
+        return false;
+    }
+
+    _max_commands = max_commands;
+    _text_size = text_bytes;
+    _tile_width = tile_width;
+    _tile_height = tile_height;
+    _tile_slots = 2;
+    clear();
+    return true;
+}
+
+void DisplayList::end() {
+    free(_commands);
+    free(_text);
+    free(_tile_pixels);
+    free(_bin_start);
+    free(_bin_refs);
+    free(_signatures);
+    free(_jobs);
+    _commands = nullptr;
+    _text = nullptr;
+    _tile_pixels = nullptr;
+    _tile_slots = 0;
+    _bin_start = nullptr;
+    _bin_refs = nullptr;
+    _signatures = nullptr;
+    _jobs = nullptr;
+    _parallel = false;
+    _max_commands = 0;
+    _command_count = 0;
+    _text_size = 0;
+    _text_used = 0;
+    _bin_capacity = 0;
+    _tile_cols = 0;
+    _tile_rows = 0;
+    _signatures_valid = false;
+}
+
+void DisplayList::clear() {
+    _command_count = 0;
+    _text_used = 0;
+    _overflow = false;
+}
+
+// Append a command, nullptr if it is off screen or the list is full
+DisplayList::Command* DisplayList::record(uint8_t type, const Rect& bounds, uint16_t color) {
+    const Config& config = _lcd->hal().getConfig();
+    Rect clipped = bounds.intersect(Rect(0, 0, config.width, config.height));
+    if (clipped.isEmpty() || !_commands) {
+        return nullptr;
+    }
+    if (_command_count >= _max_commands) {
+        _overflow = true;
+        return nullptr;
+    }
+
+    Command* cmd = &_commands[_command_count++];
+    *cmd = Command();
+    cmd->type = type;
+    cmd->color = color;
+    cmd->bounds = clipped;
+    return cmd;
+}
+
+// Copy a string into the arena so the caller's buffer can be reused
+const char* DisplayList::storeText(const char* str) {
+    size_t len = strlen(str) + 1;
+    if (_text_used + len > _text_size) {
+        _overflow = true;
+        return nullptr;
+    }
+    char* copy = _text + _text_used;
+    memcpy(copy, str, len);
+    _text_used += len;
+    return copy;
+}
+
+void DisplayList::fillScreen(uint16_t color) {
+    const Config& config = _lcd->hal().getConfig();
+    fillRect(0, 0, config.width, config.height, color);
+}
+
+void DisplayList::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    Command* cmd = record(CMD_FILL_RECT, Rect(x, y, w, h), color);
+    if (cmd) {
+        // Only the visible part is kept, which is also what occludes
+        cmd->args[0] = cmd->bounds.x;
+        cmd->args[1] = cmd->bounds.y;
+        cmd->args[2] = cmd->bounds.w;
+        cmd->args[3] = cmd->bounds.h;
+    }
+}
+
+void DisplayList::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    Command* cmd = record(CMD_DRAW_RECT, Rect(x, y, w, h), color);
+    if (cmd) {
+        cmd->args[0] = x;
+        cmd->args[1] = y;
+        cmd->args[2] = w;
+        cmd->args[3] = h;
+    }
+}
+
+void DisplayList::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    Rect bounds(std::min(x0, x1), std::min(y0, y1), std::abs(x1 - x0) + 1, std::abs(y1 - y0) + 1);
+    Command* cmd = record(CMD_LINE, bounds, color);
+    if (cmd) {
+        cmd->args[0] = x0;
+        cmd->args[1] = y0;
+        cmd->args[2] = x1;
+        cmd->args[3] = y1;
+    }
+}
+
+void DisplayList::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    Command* cmd = record(CMD_CIRCLE, Rect(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1), color);
+    if (cmd) {
+        cmd->args[0] = x0;
+        cmd->args[1] = y0;
+        cmd->args[2] = r;
+    }
+}
+
+void DisplayList::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    Command* cmd = record(CMD_FILL_CIRCLE, Rect(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1), color);
+    if (cmd) {
+        cmd->args[0] = x0;
+        cmd->args[1] = y0;
+        cmd->args[2] = r;
+    }
+}
+
+// Bounding box of a triangle
+static Rect triangleBounds(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
+    int16_t left = std::min({ x0, x1, x2 });
+    int16_t top = std::min({ y0, y1, y2 });
+    int16_t right = std::max({ x0, x1, x2 });
+    int16_t bottom = std::max({ y0, y1, y2 });
+    return Rect(left, top, right - left + 1, bottom - top + 1);
+}
+
+void DisplayList::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    Command* cmd = record(CMD_TRIANGLE, triangleBounds(x0, y0, x1, y1, x2, y2), color);
+    if (cmd) {
+        int16_t args[6] = { x0, y0, x1, y1, x2, y2 };
+        memcpy(cmd->args, args, sizeof(args));
+    }
+}
+
+void DisplayList::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    Command* cmd = record(CMD_FILL_TRIANGLE, triangleBounds(x0, y0, x1, y1, x2, y2), color);
+    if (cmd) {
+        int16_t args[6] = { x0, y0, x1, y1, x2, y2 };
+        memcpy(cmd->args, args, sizeof(args));
+    }
+}
+
+void DisplayList::drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) {
+    if (size == 0) return;
+    Command* cmd = record(CMD_TEXT, _lcd->graphics().textBounds(x, y, str, size), color);
+    if (!cmd) return;
+
+    cmd->data = storeText(str);
+    if (!cmd->data) {
+        _command_count--;
+        return;
+    }
+    cmd->size = size;
+    cmd->bg = bg;
+    cmd->args[0] = x;
+    cmd->args[1] = y;
+}
+
+void DisplayList::drawString(int16_t x, int16_t y, const char* str, const AAFont& font, uint16_t color, uint16_t bg) {
+    Command* cmd = record(CMD_TEXT_AA, _lcd->graphics().textBounds(x, y, str, font), color);
+    if (!cmd) return;
+
+    cmd->data = storeText(str);
+    if (!cmd->data) {
+        _command_count--;
+        return;
+    }
+    cmd->font = &font;
+    cmd->bg = bg;
+    cmd->args[0] = x;
+    cmd->args[1] = y;
+}
+
+void DisplayList::drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data, PixelOrder order) {
+    Command* cmd = record(CMD_IMAGE, Rect(x, y, w, h), 0);
+    if (cmd) {
+        cmd->data = data;
+        cmd->size = order;
+        cmd->args[0] = x;
+        cmd->args[1] = y;
+        cmd->args[2] = w;
+        cmd->args[3] = h;
+    }
+}
+
+// Size the per-tile tables for the current screen
+bool DisplayList::allocateTiles(uint16_t width, uint16_t height) {
+    uint16_t cols = (width + _tile_width - 1) / _tile_width;
+    uint16_t rows = (height + _tile_height - 1) / _tile_height;
+    if (cols == _tile_cols && rows == _tile_rows && _bin_start) {
+        return true;
+    }
+
+    free(_bin_start);
+    free(_signatures);
+    free(_jobs);
+    size_t count = (size_t)cols * rows;
+    _bin_start = (uint16_t*)malloc((count + 1) * sizeof(uint16_t));
+    _signatures = (uint32_t*)malloc(count * sizeof(uint32_t));
+    _jobs = (TileJob*)malloc(count * sizeof(TileJob));
+    _signatures_valid = false;
+    if (!_bin_start || !_signatures || !_jobs) {
+        printf("Failed to allocate tile tables\n");
+        free(_bin_start);
+        free(_signatures);
+        free(_jobs);
+        _bin_start = nullptr;
+        _signatures = nullptr;
+        _jobs = nullptr;
+        _tile_cols = 0;
+        _tile_rows = 0;
+        return false;
+    }
+    _tile_cols = cols;
+    _tile_rows = rows;
+    return true;
+}
+
+// Group command indices by the tiles their bounds overlap, two passes:
+// count per tile, then fill the prefix-summed slots in recording order
+bool DisplayList::binCommands() {
+    size_t tile_count = (size_t)_tile_cols * _tile_rows;
+    memset(_bin_start, 0, (tile_count + 1) * sizeof(uint16_t));
+
+    size_t total = 0;
+    for (uint16_t i = 0; i < _command_count; i++) {
+        const Rect& b = _commands[i].bounds;
+        uint16_t tx0 = b.x / _tile_width, tx1 = (b.x + b.w - 1) / _tile_width;
+        uint16_t ty0 = b.y / _tile_height, ty1 = (b.y + b.h - 1) / _tile_height;
+        for (uint16_t ty = ty0; ty <= ty1 && ty < _tile_rows; ty++) {
+            for (uint16_t tx = tx0; tx <= tx1 && tx < _tile_cols; tx++) {
+                _bin_start[ty * _tile_cols + tx + 1]++;
+                total++;
+            }
+        }
+    }
+    if (total > UINT16_MAX) {
+        printf("Display list too large to bin\n");
+        return false;
+    }
+
+    if (total > _bin_capacity) {
+        uint16_t* refs = (uint16_t*)realloc(_bin_refs, total * sizeof(uint16_t));
+        if (!refs) {
+            printf("Failed to allocate tile bins\n");
+            return false;
+        }
+        _bin_refs = refs;
+        _bin_capacity = total;
+    }
+
+    for (size_t t = 0; t < tile_count; t++) {
+        _bin_start[t + 1] += _bin_start[t];
+    }
+
+    // Each start is advanced while filling and ends up at the next tile's
+    // start, shifted back afterwards
+    for (uint16_t i = 0; i < _command_count; i++) {
+        const Rect& b = _commands[i].bounds;
+        uint16_t tx0 = b.x / _tile_width, tx1 = (b.x + b.w - 1) / _tile_width;
+        uint16_t ty0 = b.y / _tile_height, ty1 = (b.y + b.h - 1) / _tile_height;
+        for (uint16_t ty = ty0; ty <= ty1 && ty < _tile_rows; ty++) {
+            for (uint16_t tx = tx0; tx <= tx1 && tx < _tile_cols; tx++) {
+                _bin_refs[_bin_start[ty * _tile_cols + tx]++] = i;
+            }
+        }
+    }
+    for (size_t t = tile_count; t > 0; t--) {
+        _bin_start[t] = _bin_start[t - 1];
+    }
+    _bin_start[0] = 0;
+    return true;
+}
+
+// FNV-1a
+static uint32_t hashBytes(uint32_t hash, const void* data, size_t len) {
+    const uint8_t* p = (const uint8_t*)data;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Hash of the commands a tile is drawn from. Images are identified by
+// their pointer only, invalidate() after changing pixels in place.
+uint32_t DisplayList::signature(uint16_t first, uint16_t last, bool covered, uint16_t bg) const {
+    uint32_t hash = 2166136261u;
+    if (!covered) {
+        hash = hashBytes(hash, &bg, sizeof(bg));
+    }
+    for (uint16_t i = first; i < last; i++) {
+        const Command& cmd = _commands[_bin_refs[i]];
+        hash = hashBytes(hash, &cmd.type, sizeof(cmd.type));
+        hash = hashBytes(hash, &cmd.size, sizeof(cmd.size));
+        hash = hashBytes(hash, &cmd.color, sizeof(cmd.color));
+        hash = hashBytes(hash, &cmd.bg, sizeof(cmd.bg));
+        hash = hashBytes(hash, cmd.args, sizeof(cmd.args));
+        hash = hashBytes(hash, &cmd.font, sizeof(cmd.font));
+        if (cmd.type == CMD_TEXT || cmd.type == CMD_TEXT_AA) {
+            hash = hashBytes(hash, cmd.data, strlen((const char*)cmd.data));
+        } else {
+            hash = hashBytes(hash, &cmd.data, sizeof(cmd.data));
+        }
+    }
+    return hash;
+}
+
+void DisplayList::execute(Graphics& gfx, const Command& cmd) const {
+    const int16_t* a = cmd.args;
+    switch (cmd.type) {
+        case CMD_FILL_RECT:
+            gfx.fillRect(a[0], a[1], a[2], a[3], cmd.color);
+            break;
+        case CMD_DRAW_RECT:
+            gfx.drawRect(a[0], a[1], a[2], a[3], cmd.color);
+            break;
+        case CMD_LINE:
+            gfx.drawLine(a[0], a[1], a[2], a[3], cmd.color);
+            break;
+        case CMD_CIRCLE:
+            gfx.drawCircle(a[0], a[1], a[2], cmd.color);
+            break;
+        case CMD_FILL_CIRCLE:
+            gfx.fillCircle(a[0], a[1], a[2], cmd.color);
+            break;
+        case CMD_TRIANGLE:
+            gfx.drawTriangle(a[0], a[1], a[2], a[3], a[4], a[5], cmd.color);
+            break;
+        case CMD_FILL_TRIANGLE:
+            gfx.fillTriangle(a[0], a[1], a[2], a[3], a[4], a[5], cmd.color);
+            break;
+        case CMD_TEXT:
+            gfx.drawString(a[0], a[1], (const char*)cmd.data, cmd.color, cmd.bg, cmd.size);
+            break;
+        case CMD_TEXT_AA:
+            gfx.drawString(a[0], a[1], (const char*)cmd.data, *cmd.font, cmd.color, cmd.bg);
+            break;
+        case CMD_IMAGE:
+            gfx.drawImage(a[0], a[1], a[2], a[3], (const uint16_t*)cmd.data, (PixelOrder)cmd.size);
+            break;
+        default:
+            break;
+    }
+}
+
+// Decide which tiles to send and what each one is drawn from
+void DisplayList::planTiles() {
+    uint16_t width = _lcd->hal().getConfig().width;
+    uint16_t height = _lcd->hal().getConfig().height;
+    _job_count = 0;
+
+    for (uint16_t ty = 0; ty < _tile_rows; ty++) {
+        for (uint16_t tx = 0; tx < _tile_cols; tx++) {
+            uint16_t t = ty * _tile_cols + tx;
+            int16_t x = tx * _tile_width;
+            int16_t y = ty * _tile_height;
+            Rect tile(x, y, std::min<int16_t>(_tile_width, width - x), std::min<int16_t>(_tile_height, height - y));
+
+            // Everything below the last opaque command covering the whole
+            // tile would be overwritten, start from that one instead
+            uint16_t first = _bin_start[t];
+            uint16_t last = _bin_start[t + 1];
+            bool covered = false;
+            for (uint16_t i = last; i > first; i--) {
+                const Command& cmd = _commands[_bin_refs[i - 1]];
+                if ((cmd.type == CMD_FILL_RECT || cmd.type == CMD_IMAGE) && cmd.bounds.contains(tile)) {
+                    _commands_culled += i - 1 - first;
+                    first = i - 1;
+                    covered = true;
+                    break;
+                }
+            }
+
+            // Unchanged since the last render, the panel already shows it
+            uint32_t sig = signature(first, last, covered, _bg);
+            if (_signatures_valid && _signatures[t] == sig) {
+                _tiles_skipped++;
+                continue;
+            }
+            _signatures[t] = sig;
+
+            TileJob& job = _jobs[_job_count++];
+            job.tile = tile;
+            job.first = first;
+            job.last = last;
+            job.covered = covered;
+            _commands_drawn += last - first;
+        }
+    }
+}
+
+// Rasterize a tile into its slot, returns the pixels
+uint16_t* DisplayList::rasterTile(Graphics& gfx, uint16_t index) {
+    const TileJob& job = _jobs[index];
+    uint16_t* pixels = _tile_pixels + (size_t)(index % _tile_slots) * _tile_width * _tile_height;
+
+    // Wraps the slot, nothing is allocated
+    FrameBuffer fb;
+    fb.begin(job.tile.w, job.tile.h, pixels);
+    fb.setDirtyTracking(false);
+    fb.setOrigin(job.tile.x, job.tile.y);
+    if (!job.covered) {
+        fb.fillRect(job.tile.x, job.tile.y, job.tile.w, job.tile.h, _bg);
+    }
+
+    FrameBuffer* saved_target = gfx.frameBuffer();
+    gfx.setFrameBuffer(&fb);
+    for (uint16_t i = job.first; i < job.last; i++) {
+        execute(gfx, _commands[_bin_refs[i]]);
+    }
+    gfx.setFrameBuffer(saved_target);
+    return pixels;
+}
+
+// One window and one burst per tile
+bool DisplayList::sendTile(uint16_t index, const uint16_t* pixels) {
+    const Rect& tile = _jobs[index].tile;
+    _lcd->setAddrWindow(tile.x, tile.y, tile.x + tile.w - 1, tile.y + tile.h - 1);
+    _tiles_sent++;
+    return _lcd->hal().writePixelsAsync(pixels, (size_t)tile.w * tile.h);
+}
+
+bool DisplayList::render(uint16_t bg) {
+    if (!_commands) {
+        return false;
+    }
+
+    uint16_t width = _lcd->hal().getConfig().width;
+    uint16_t height = _lcd->hal().getConfig().height;
+    if (!allocateTiles(width, height) || !binCommands()) {
+        return false;
+    }
+
+    _bg = bg;
+    _tiles_sent = 0;
+    _tiles_skipped = 0;
+    _commands_drawn = 0;
+    _commands_culled = 0;
+    _tiles_by_core[0] = 0;
+    _tiles_by_core[1] = 0;
+    planTiles();
+
+    HAL& hal = _lcd->hal();
+    bool ok;
+
+    // The chip stays selected for the whole frame
+    hal.beginTransaction();
+    if (_parallel && _job_count > 1) {
+        ok = renderParallel();
+    } else {
+        ok = renderSerial();
+    }
+    if (!hal.waitDmaIdle()) {
+        ok = false;
+    }
+    hal.endTransaction();
+
+    _signatures_valid = ok;
+    return ok;
+}
+
+// Tile N+1 is rasterized while tile N is on the wire
+bool DisplayList::renderSerial() {
+    Graphics& gfx = _lcd->graphics();
+    bool ok = true;
+    for (uint16_t j = 0; j < _job_count; j++) {
+        uint16_t* pixels = rasterTile(gfx, j);
+        _tiles_by_core[0]++;
+        if (!sendTile(j, pixels)) {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+// Claim the next tile in screen order once its slot has been sent
+bool DisplayList::claimJob(uint16_t& job) {
+    uint16_t next = _next_job.load(std::memory_order_acquire);
+    while (next < _job_count && next < _released.load(std::memory_order_acquire) + _tile_slots) {
+        if (_next_job.compare_exchange_weak(next, next + 1, std::memory_order_acq_rel)) {
+            job = next;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Core 1 rasterizes tiles until none are left to claim
+void DisplayList::workerEntry(void* user) {
+    DisplayList* list = (DisplayList*)user;
+    uint16_t job;
+    while (list->_next_job.load(std::memory_order_acquire) < list->_job_count) {
+        if (!list->claimJob(job)) {
+            SecondCore::wait();
+            continue;
+        }
+        list->rasterTile(list->_worker_gfx, job);
+        list->_tiles_by_core[1]++;
+        list->_slot_ready[job % list->_tile_slots].store(job, std::memory_order_release);
+        SecondCore::signal();
+    }
+}
+
+// Both cores take tiles from a shared cursor in screen order; the next
+// tile to send is never blocked behind the other core since either core
+// picks it up as soon as it is free. Core 0 sends finished tiles in order
+// and rasterizes whenever the next one is not ready yet.
+bool DisplayList::renderParallel() {
+    for (uint8_t i = 0; i < _tile_slots; i++) {
+        _slot_ready[i].store(-1, std::memory_order_relaxed);
+    }
+    _released.store(0, std::memory_order_relaxed);
+    _next_job.store(0, std::memory_order_release);
+
+    // Core 1 busy with something else, e.g. a RenderPipeline
+    if (!SecondCore::launch(workerEntry, this)) {
+        return renderSerial();
+    }
+
+    Graphics& gfx = _lcd->graphics();
+    bool ok = true;
+
+    uint16_t next_send = 0;
+    uint16_t job;
+    while (next_send < _job_count) {
+        uint8_t slot = next_send % _tile_slots;
+        if (_slot_ready[slot].load(std::memory_order_acquire) == next_send) {
+            const uint16_t* pixels = _tile_pixels + (size_t)slot * _tile_width * _tile_height;
+            if (!sendTile(next_send, pixels)) {
+                ok = false;
+            }
+            // Starting this transfer waited for the previous one
+            _released.store(next_send, std::memory_order_release);
+            next_send++;
+            SecondCore::signal();
+        } else if (claimJob(job)) {
+            rasterTile(gfx, job);
+            _tiles_by_core[0]++;
+            _slot_ready[job % _tile_slots].store(job, std::memory_order_release);
+        } else {
+            SecondCore::wait();
+        }
+    }
+
+    SecondCore::join();
+    return ok;
+}
+
+bool DisplayList::enableParallel(uint8_t tile_slots) {
+    if (!_commands) {
+        return false;
+    }
+    if (tile_slots < 2) {
+        tile_slots = 2;
+    } else if (tile_slots > MAX_TILE_SLOTS) {
+        tile_slots = MAX_TILE_SLOTS;
+    }
+
+    uint16_t* pixels = (uint16_t*)realloc(_tile_pixels, (size_t)tile_slots * _tile_width * _tile_height * sizeof(uint16_t));
+    if (!pixels) {
+        printf("Failed to allocate tile slots\n");
+        return false;
+    }
+    _tile_pixels = pixels;
+    _tile_slots = tile_slots;
+    _parallel = true;
+    return true;
+}
+
+void DisplayList::disableParallel() {
+    _parallel = false;
+}
+
+} // namespace st7789
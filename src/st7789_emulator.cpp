@@ -0,0 +1,289 @@
+#include "st7789_emulator.hpp"
+#include <cstdio>
+
+namespace st7789 {
+
+// Commands understood by the emulator
+enum EMU_CMD {
+    EMU_SWRESET = 0x01,
+    EMU_SLPIN   = 0x10,
+    EMU_SLPOUT  = 0x11,
+    EMU_INVOFF  = 0x20,
+    EMU_INVON   = 0x21,
+    EMU_DISPOFF = 0x28,
+    EMU_DISPON  = 0x29,
+    EMU_CASET   = 0x2A,
+    EMU_RASET   = 0x2B,
+    EMU_RAMWR   = 0x2C,
+    EMU_VSCRDEF = 0x33,
+    EMU_VSCSAD  = 0x37,
+    EMU_MADCTL  = 0x36,
+    EMU_RAMWRC  = 0x3C,
+    EMU_COLMOD  = 0x3A
+};
+
+// GRAM keeps RGB565, 4-bit channels are widened by repeating their high bits
+static uint16_t expand444(uint16_t c) {
+    uint16_t r = (c >> 8) & 0xF;
+    uint16_t g = (c >> 4) & 0xF;
+    uint16_t b = c & 0xF;
+    return (((r << 1) | (r >> 3)) << 11) | (((g << 2) | (g >> 2)) << 5) | ((b << 1) | (b >> 3));
+}
+
+// MADCTL bits affecting the address mapping
+static const uint8_t EMU_MADCTL_MY = 0x80;
+static const uint8_t EMU_MADCTL_MX = 0x40;
+static const uint8_t EMU_MADCTL_MV = 0x20;
+
+Emulator::Emulator() {
+    clearGram(0);
+    _cs = true;
+    _dc = true;
+    reset();
+}
+
+void Emulator::reset() {
+    _cmd = 0;
+    _param_count = 0;
+    _xs = 0;
+    _xe = GRAM_WIDTH - 1;
+    _ys = 0;
+    _ye = GRAM_HEIGHT - 1;
+    _cur_x = 0;
+    _cur_y = 0;
+    _madctl = 0;
+    _colmod = 0x66;  // Power-on default is 18 bits/pixel
+    _tfa = 0;
+    _vsa = GRAM_HEIGHT;
+    _bfa = 0;
+    _vsp = 0;
+    _sleeping = true;
+    _display_on = false;
+    _inverted = false;
+}
+
+void Emulator::setCs(bool level) {
+    if (_cs && !level) {
+        _stats.cs_toggles++;
+    }
+    _cs = level;
+}
+
+void Emulator::setDc(bool level) {
+    if (_dc != level) {
+        _stats.dc_flips++;
+    }
+    _dc = level;
+}
+
+void Emulator::write(const uint8_t* data, size_t len) {
+    // Panel ignores the bus while not selected
+    if (_cs) return;
+
+    for (size_t i = 0; i < len; i++) {
+        if (_dc) {
+            _stats.data_bytes++;
+            handleData(data[i]);
+        } else {
+            _stats.command_bytes++;
+            handleCommand(data[i]);
+        }
+    }
+}
+
+void Emulator::handleCommand(uint8_t cmd) {
+    _stats.commands++;
+    _cmd = cmd;
+    _param_count = 0;
+
+    switch (cmd) {
+        case EMU_SWRESET:
+            reset();
+            break;
+        case EMU_SLPIN:
+            _sleeping = true;
+            break;
+        case EMU_SLPOUT:
+            _sleeping = false;
+            break;
+        case EMU_INVOFF:
+            _inverted = false;
+            break;
+        case EMU_INVON:
+            _inverted = true;
+            break;
+        case EMU_DISPOFF:
+            _display_on = false;
+            break;
+        case EMU_DISPON:
+            _display_on = true;
+            break;
+        case EMU_RAMWR:
+            // Memory write restarts at the window origin
+            _cur_x = _xs;
+            _cur_y = _ys;
+            break;
+        default:
+            break;
+    }
+}
+
+void Emulator::handleData(uint8_t data) {
+    switch (_cmd) {
+        case EMU_CASET:
+        case EMU_RASET:
+            if (_param_count < 4) {
+                _params[_param_count++] = data;
+            }
+            if (_param_count == 4) {
+                uint16_t start = (_params[0] << 8) | _params[1];
+                uint16_t end = (_params[2] << 8) | _params[3];
+                if (_cmd == EMU_CASET) {
+                    _xs = start;
+                    _xe = end;
+                } else {
+                    _ys = start;
+                    _ye = end;
+                }
+                _param_count = 0;
+            }
+            break;
+        case EMU_VSCRDEF:
+            if (_param_count < 6) {
+                _params[_param_count++] = data;
+            }
+            if (_param_count == 6) {
+                uint16_t tfa = (_params[0] << 8) | _params[1];
+                uint16_t vsa = (_params[2] << 8) | _params[3];
+                uint16_t bfa = (_params[4] << 8) | _params[5];
+                // Areas must cover the whole memory, otherwise ignored
+                if (tfa + vsa + bfa == GRAM_HEIGHT && vsa > 0) {
+                    _tfa = tfa;
+                    _vsa = vsa;
+                    _bfa = bfa;
+                }
+                _param_count = 0;
+            }
+            break;
+        case EMU_VSCSAD:
+            if (_param_count < 2) {
+                _params[_param_count++] = data;
+            }
+            if (_param_count == 2) {
+                _vsp = (_params[0] << 8) | _params[1];
+                _param_count = 0;
+            }
+            break;
+        case EMU_MADCTL:
+            _madctl = data;
+            break;
+        case EMU_COLMOD:
+            _colmod = data;
+            break;
+        case EMU_RAMWR:
+        case EMU_RAMWRC:
+            _params[_param_count++] = data;
+            if ((_colmod & 0x07) == 0x03) {
+                // 12 bits/pixel, two pixels in three bytes. A pixel is
+                // written once its last bit arrives, a trailing nibble is lost.
+                if (_param_count == 2) {
+                    writePixel(expand444((_params[0] << 4) | (_params[1] >> 4)));
+                } else if (_param_count == 3) {
+                    writePixel(expand444(((_params[1] & 0x0F) << 8) | _params[2]));
+                    _param_count = 0;
+                }
+            } else if (_param_count == 2) {
+                // 16 bits/pixel, big-endian on the wire
+                writePixel((_params[0] << 8) | _params[1]);
+                _param_count = 0;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void Emulator::writePixel(uint16_t color) {
+    // Map the MCU address to the physical GRAM location
+    uint16_t x = _cur_x;
+    uint16_t y = _cur_y;
+    if (_madctl & EMU_MADCTL_MV) {
+        uint16_t t = x;
+        x = y;
+        y = t;
+    }
+    if (_madctl & EMU_MADCTL_MX) {
+        x = GRAM_WIDTH - 1 - x;
+    }
+    if (_madctl & EMU_MADCTL_MY) {
+        y = GRAM_HEIGHT - 1 - y;
+    }
+
+    if (x < GRAM_WIDTH && y < GRAM_HEIGHT) {
+        _gram[y * GRAM_WIDTH + x] = color;
+    }
+    _stats.pixels++;
+
+    // Advance the write pointer, wrapping inside the window
+    if (_cur_x >= _xe) {
+        _cur_x = _xs;
+        _cur_y = (_cur_y >= _ye) ? _ys : _cur_y + 1;
+    } else {
+        _cur_x++;
+    }
+}
+
+uint16_t Emulator::pixel(uint16_t x, uint16_t y) const {
+    if (x >= GRAM_WIDTH || y >= GRAM_HEIGHT) return 0;
+    return _gram[y * GRAM_WIDTH + x];
+}
+
+// Memory line shown on a line of the glass
+uint16_t Emulator::displayLine(uint16_t line) const {
+    if (line < _tfa || line >= _tfa + _vsa) {
+        return line;
+    }
+    // Offset of the start line within the scroll area
+    uint32_t start = (_vsp + _vsa - _tfa % _vsa) % _vsa;
+    return _tfa + (start + line - _tfa) % _vsa;
+}
+
+uint16_t Emulator::displayPixel(uint16_t x, uint16_t y) const {
+    if (x >= GRAM_WIDTH || y >= GRAM_HEIGHT) return 0;
+    return _gram[displayLine(y) * GRAM_WIDTH + x];
+}
+
+void Emulator::clearGram(uint16_t color) {
+    for (size_t i = 0; i < (size_t)GRAM_WIDTH * GRAM_HEIGHT; i++) {
+        _gram[i] = color;
+    }
+}
+
+bool Emulator::savePpm(const char* path) const {
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        printf("Failed to open %s\n", path);
+        return false;
+    }
+
+    fprintf(f, "P6\n%d %d\n255\n", GRAM_WIDTH, GRAM_HEIGHT);
+    uint8_t row[GRAM_WIDTH * 3];
+    for (uint16_t y = 0; y < GRAM_HEIGHT; y++) {
+        const uint16_t* line = &_gram[displayLine(y) * GRAM_WIDTH];
+        for (uint16_t x = 0; x < GRAM_WIDTH; x++) {
+            uint16_t c = line[x];
+            uint8_t r = (c >> 11) & 0x1F;
+            uint8_t g = (c >> 5) & 0x3F;
+            uint8_t b = c & 0x1F;
+            row[x * 3] = (r << 3) | (r >> 2);
+            row[x * 3 + 1] = (g << 2) | (g >> 4);
+            row[x * 3 + 2] = (b << 3) | (b >> 2);
+        }
+        fwrite(row, 1, sizeof(row), f);
+    }
+
+    fclose(f);
+    return true;
+}
+
+} // namespace st7789
@@ -0,0 +1,103 @@
+#include "st7789_font_cache.hpp"
+#include <cstdlib>
+#include <cstdio>
+
+namespace st7789 {
+
+FontCache::FontCache() :
+    _entries(nullptr),
+    _data(nullptr),
+    _count(0),
+    _slot_bytes(0),
+    _tick(0),
+    _hits(0),
+    _misses(0) {
+}
+
+FontCache::~FontCache() {
+    end();
+}
+
+bool FontCache::begin(uint8_t entries, uint16_t slot_bytes) {
+    if (entries == 0 || slot_bytes == 0) {
+        return false;
+    }
+    end();
+
+    _entries = (Entry*)malloc(entries * sizeof(Entry));
+    _data = (uint8_t*)malloc((size_t)entries * slot_bytes);
+    if (!_entries || !_data) {
+        printf("Failed to allocate font cache\n");
+        end();
+        return false;
+    }
+
+    _count = entries;
+    _slot_bytes = slot_bytes;
+    clear();
+    resetStats();
+    return true;
+}
+
+void FontCache::end() {
+    if (_entries) {
+        free(_entries);
+        _entries = nullptr;
+    }
+    if (_data) {
+        free(_data);
+        _data = nullptr;
+    }
+    _count = 0;
+    _slot_bytes = 0;
+}
+
+void FontCache::clear() {
+    for (uint8_t i = 0; i < _count; i++) {
+        _entries[i].font = nullptr;
+        _entries[i].last_use = 0;
+    }
+    _tick = 0;
+}
+
+const uint8_t* FontCache::load(const AAFont& font, uint32_t index) {
+    if (_count == 0 || !font.read) {
+        return nullptr;
+    }
+
+    // Hit, or pick the least recently used slot (unused slots go first)
+    uint8_t victim = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+        Entry& e = _entries[i];
+        if (e.font == &font && e.index == index) {
+            e.last_use = ++_tick;
+            _hits++;
+            return _data + (size_t)i * _slot_bytes;
+        }
+        if (e.last_use < _entries[victim].last_use) {
+            victim = i;
+        }
+    }
+    _misses++;
+
+    const AAGlyph& glyph = font.glyphs[index];
+    size_t bytes = glyphBytes(font, glyph);
+    if (bytes > _slot_bytes) {
+        return nullptr;
+    }
+
+    uint8_t* dst = _data + (size_t)victim * _slot_bytes;
+    Entry& e = _entries[victim];
+    if (!font.read(font.read_user, glyph.offset, dst, bytes)) {
+        e.font = nullptr;
+        e.last_use = 0;
+        return nullptr;
+    }
+
+    e.font = &font;
+    e.index = index;
+    e.last_use = ++_tick;
+    return dst;
+}
+
+} // namespace st7789
@@ -0,0 +1,307 @@
+// Generated by tools/font_convert.py from Lato-Regular.ttf, 14px, 4 bpp
+// Source font Copyright (c) 2010, Lukasz Dziedzic, with Reserved Font Name Lato,
+// licensed under the SIL Open Font License, Version 1.1 (http://scripts.sil.org/OFL).
+
+#include "st7789_aa_font.hpp"
+
+namespace st7789 {
+
+static const uint8_t font_sans_14_bitmap[] = {
+    0x3F, 0x03, 0xF0, 0x3F, 0x03, 0xF0, 0x2F, 0x01, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x04, 0xE2, 0xE2,
+    0x97, 0xE2, 0x97, 0xC1, 0x75, 0x00, 0x1E, 0x04, 0xA0, 0x00, 0x4C, 0x07, 0x80, 0x00, 0x79, 0x0A,
+    0x50, 0x3F, 0xFF, 0xFF, 0xF9, 0x00, 0xC4, 0x1E, 0x00, 0x00, 0xE1, 0x4C, 0x00, 0x9F, 0xFF, 0xFF,
+    0xF3, 0x05, 0xA0, 0x96, 0x00, 0x08, 0x70, 0xC3, 0x00, 0x0B, 0x40, 0xE1, 0x00, 0x00, 0x00, 0xB0,
+    0x00, 0x00, 0x7D, 0xFC, 0x60, 0x07, 0xC3, 0xC4, 0x91, 0x0C, 0x60, 0xC0, 0x00, 0x0A, 0xB2, 0xB0,
+    0x00, 0x02, 0xCE, 0xD4, 0x00, 0x00, 0x06, 0xDE, 0xB0, 0x00, 0x04, 0x81, 0xE5, 0x00, 0x05, 0x70,
+    0xD5, 0x1D, 0x67, 0x77, 0xE1, 0x04, 0xBF, 0xEB, 0x30, 0x00, 0x09, 0x30, 0x00, 0x09, 0xEC, 0x30,
+    0x00, 0xB7, 0x04, 0xC1, 0x6B, 0x00, 0x7A, 0x00, 0x78, 0x01, 0xE0, 0x4D, 0x10, 0x04, 0xC1, 0x5B,
+    0x1D, 0x30, 0x00, 0x09, 0xEC, 0x2B, 0x70, 0x00, 0x00, 0x00, 0x07, 0xA3, 0xCE, 0x90, 0x00, 0x04,
+    0xD1, 0xB6, 0x1C, 0x40, 0x01, 0xD3, 0x0E, 0x10, 0x87, 0x00, 0xB7, 0x00, 0xB5, 0x1C, 0x40, 0x7A,
+    0x00, 0x03, 0xCE, 0x80, 0x00, 0x2B, 0xEC, 0x30, 0x00, 0x00, 0xC8, 0x16, 0xE0, 0x00, 0x00, 0xF2,
+    0x00, 0x40, 0x00, 0x00, 0xD7, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x50, 0x00, 0x00, 0x08, 0xC8, 0xF5,
+    0x06, 0x90, 0x3F, 0x10, 0x5E, 0x5B, 0x50, 0x5E, 0x00, 0x05, 0xED, 0x00, 0x2E, 0x71, 0x17, 0xDE,
+    0x50, 0x04, 0xCF, 0xD9, 0x14, 0xE5, 0xE2, 0xE2, 0xC1, 0x00, 0x55, 0x00, 0xD4, 0x05, 0xC0, 0x0A,
+    0x70, 0x0D, 0x30, 0x0F, 0x10, 0x1F, 0x00, 0x0F, 0x10, 0x0E, 0x30, 0x0B, 0x60, 0x06, 0xB0, 0x01,
+    0xE3, 0x00, 0x76, 0x46, 0x00, 0x3E, 0x10, 0x0B, 0x60, 0x06, 0xB0, 0x02, 0xE0, 0x00, 0xF1, 0x00,
+    0xE2, 0x00, 0xF2, 0x01, 0xF0, 0x05, 0xC0, 0x0A, 0x70, 0x1E, 0x20, 0x58, 0x00, 0x01, 0x81, 0x11,
+    0x9B, 0x96, 0x18, 0xC9, 0x50, 0x18, 0x11, 0x00, 0x07, 0x80, 0x00, 0x00, 0x07, 0x80, 0x00, 0x00,
+    0x07, 0x80, 0x00, 0x4F, 0xFF, 0xFF, 0xF6, 0x00, 0x07, 0x80, 0x00, 0x00, 0x07, 0x80, 0x00, 0x00,
+    0x07, 0x80, 0x00, 0x3E, 0x30, 0xA2, 0x26, 0x00, 0x4F, 0xFF, 0x20, 0x3E, 0x30, 0x00, 0x00, 0x0C,
+    0x20, 0x00, 0x05, 0xA0, 0x00, 0x00, 0xB4, 0x00, 0x00, 0x2D, 0x00, 0x00, 0x09, 0x60, 0x00, 0x01,
+    0xD1, 0x00, 0x00, 0x69, 0x00, 0x00, 0x0C, 0x30, 0x00, 0x04, 0xB0, 0x00, 0x00, 0xA5, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x00, 0x01, 0x9E, 0xEA, 0x10, 0x0A, 0xB2, 0x2A, 0xC0, 0x3F, 0x20, 0x01, 0xE5,
+    0x7C, 0x00, 0x00, 0xB8, 0x8B, 0x00, 0x00, 0x9A, 0x8B, 0x00, 0x00, 0x9A, 0x7C, 0x00, 0x00, 0xB9,
+    0x3F, 0x20, 0x01, 0xE5, 0x0B, 0xB2, 0x2A, 0xC0, 0x01, 0x9E, 0xEA, 0x10, 0x00, 0x4E, 0x60, 0x00,
+    0x6E, 0xE6, 0x00, 0x5E, 0x3C, 0x60, 0x00, 0x10, 0xC6, 0x00, 0x00, 0x0C, 0x60, 0x00, 0x00, 0xC6,
+    0x00, 0x00, 0x0C, 0x60, 0x00, 0x00, 0xC6, 0x00, 0x00, 0x0C, 0x60, 0x00, 0xFF, 0xFF, 0xF6, 0x00,
+    0x8D, 0xEB, 0x20, 0x08, 0xC2, 0x19, 0xD0, 0x0C, 0x30, 0x02, 0xF2, 0x00, 0x00, 0x03, 0xF1, 0x00,
+    0x00, 0x0A, 0xB0, 0x00, 0x00, 0x8D, 0x20, 0x00, 0x07, 0xE2, 0x00, 0x00, 0x7E, 0x30, 0x00, 0x07,
+    0xE3, 0x00, 0x00, 0x3F, 0xEF, 0xFF, 0xF6, 0x00, 0x8D, 0xEC, 0x40, 0x08, 0xC2, 0x17, 0xE1, 0x07,
+    0x30, 0x00, 0xF3, 0x00, 0x00, 0x18, 0xC0, 0x00, 0x05, 0xFE, 0x30, 0x00, 0x00, 0x17, 0xE2, 0x00,
+    0x00, 0x00, 0xC6, 0x1D, 0x20, 0x00, 0xD6, 0x0B, 0xB2, 0x18, 0xE1, 0x01, 0x9E, 0xEB, 0x20, 0x00,
+    0x00, 0x4F, 0x50, 0x00, 0x02, 0xDE, 0x50, 0x00, 0x0C, 0x6C, 0x50, 0x00, 0x99, 0x0C, 0x50, 0x06,
+    0xC0, 0x0C, 0x50, 0x4D, 0x20, 0x0C, 0x50, 0x9F, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x0C, 0x50, 0x00,
+    0x00, 0x0C, 0x50, 0x00, 0x00, 0x0C, 0x50, 0x00, 0xFF, 0xFF, 0xB0, 0x02, 0xD0, 0x00, 0x00, 0x05,
+    0xB0, 0x00, 0x00, 0x07, 0x90, 0x00, 0x00, 0x09, 0xEE, 0xEA, 0x20, 0x02, 0x30, 0x2B, 0xC0, 0x00,
+    0x00, 0x03, 0xF1, 0x00, 0x00, 0x04, 0xF1, 0x08, 0x30, 0x3C, 0x90, 0x07, 0xDF, 0xD7, 0x00, 0x00,
+    0x00, 0x9D, 0x10, 0x00, 0x06, 0xF3, 0x00, 0x00, 0x3E, 0x60, 0x00, 0x01, 0xD9, 0x00, 0x00, 0x08,
+    0xFC, 0xEC, 0x50, 0x1F, 0xA2, 0x17, 0xF2, 0x3F, 0x10, 0x00, 0xD7, 0x2F, 0x10, 0x00, 0xD6, 0x0B,
+    0xA1, 0x18, 0xE1, 0x01, 0x9E, 0xEA, 0x20, 0x3F, 0xFF, 0xFF, 0xF9, 0x00, 0x00, 0x01, 0xE4, 0x00,
+    0x00, 0x08, 0xC0, 0x00, 0x00, 0x1E, 0x40, 0x00, 0x00, 0x8C, 0x00, 0x00, 0x01, 0xE4, 0x00, 0x00,
+    0x08, 0xC0, 0x00, 0x00, 0x1E, 0x50, 0x00, 0x00, 0x8C, 0x00, 0x00, 0x01, 0xE4, 0x00, 0x00, 0x01,
+    0xAE, 0xEA, 0x20, 0x0B, 0xA1, 0x19, 0xC0, 0x0E, 0x40, 0x03, 0xF0, 0x0A, 0xA1, 0x19, 0xB0, 0x01,
+    0xCF, 0xFD, 0x20, 0x0C, 0xA1, 0x19, 0xD1, 0x4F, 0x10, 0x00, 0xE5, 0x4F, 0x10, 0x00, 0xE5, 0x1D,
+    0xA1, 0x18, 0xE1, 0x02, 0xAE, 0xEB, 0x30, 0x06, 0xDE, 0xC3, 0x06, 0xD3, 0x16, 0xE2, 0xD6, 0x00,
+    0x0C, 0x6E, 0x60, 0x00, 0xB8, 0x9C, 0x21, 0x6F, 0x51, 0xAE, 0xDC, 0xC0, 0x00, 0x03, 0xE3, 0x00,
+    0x01, 0xD7, 0x00, 0x00, 0xAC, 0x00, 0x00, 0x7E, 0x20, 0x00, 0x0D, 0x70, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x0D, 0x70, 0x0D, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0D, 0x70,
+    0x56, 0x08, 0x00, 0x00, 0x00, 0x44, 0x00, 0x4C, 0xC3, 0x3B, 0xD5, 0x00, 0xCE, 0x40, 0x00, 0x05,
+    0xCB, 0x40, 0x00, 0x05, 0xD6, 0x00, 0x00, 0x02, 0xEF, 0xFF, 0xFF, 0x10, 0x00, 0x00, 0x00, 0xEF,
+    0xFF, 0xFF, 0x10, 0x35, 0x00, 0x00, 0x02, 0xCC, 0x50, 0x00, 0x00, 0x4C, 0xC4, 0x00, 0x00, 0x3D,
+    0xD1, 0x03, 0xAD, 0x60, 0x04, 0xD6, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x3B, 0xFD, 0x50, 0x65,
+    0x15, 0xF2, 0x00, 0x00, 0xD4, 0x00, 0x03, 0xE1, 0x00, 0x4E, 0x60, 0x00, 0xE5, 0x00, 0x00, 0xE0,
+    0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x03, 0xE3, 0x00, 0x00, 0x05, 0xBE, 0xEC, 0x60, 0x00,
+    0x0A, 0xB4, 0x11, 0x4B, 0xA0, 0x08, 0xA0, 0x00, 0x00, 0x0A, 0x61, 0xD1, 0x03, 0xBF, 0xE3, 0x2C,
+    0x49, 0x02, 0xD5, 0x1D, 0x10, 0xD5, 0x80, 0x86, 0x03, 0xB0, 0x2C, 0x4A, 0x0A, 0x71, 0xBA, 0x1A,
+    0x61, 0xD1, 0x4E, 0xD4, 0xCE, 0x80, 0x08, 0x90, 0x00, 0x00, 0x00, 0x00, 0x0B, 0xB4, 0x10, 0x25,
+    0xA1, 0x00, 0x05, 0xBE, 0xFD, 0x92, 0x00, 0x00, 0x02, 0xFA, 0x00, 0x00, 0x00, 0x08, 0xCF, 0x10,
+    0x00, 0x00, 0x0E, 0x5C, 0x70, 0x00, 0x00, 0x5E, 0x06, 0xD0, 0x00, 0x00, 0xB8, 0x01, 0xE4, 0x00,
+    0x02, 0xF2, 0x00, 0x9A, 0x00, 0x08, 0xFF, 0xFF, 0xFF, 0x10, 0x0E, 0x50, 0x00, 0x0C, 0x70, 0x5E,
+    0x10, 0x00, 0x07, 0xD0, 0xB9, 0x00, 0x00, 0x02, 0xE4, 0xCF, 0xFF, 0xD8, 0x10, 0xC9, 0x00, 0x3D,
+    0x90, 0xC9, 0x00, 0x07, 0xD0, 0xC9, 0x00, 0x08, 0xD0, 0xC9, 0x00, 0x4E, 0x50, 0xCF, 0xFF, 0xFA,
+    0x10, 0xC9, 0x00, 0x18, 0xE1, 0xC9, 0x00, 0x01, 0xF3, 0xC9, 0x00, 0x19, 0xE1, 0xCF, 0xFF, 0xEA,
+    0x30, 0x00, 0x18, 0xDF, 0xEA, 0x30, 0x2D, 0xB3, 0x02, 0x7A, 0x0C, 0xC0, 0x00, 0x00, 0x02, 0xF4,
+    0x00, 0x00, 0x00, 0x5F, 0x10, 0x00, 0x00, 0x05, 0xF1, 0x00, 0x00, 0x00, 0x3F, 0x40, 0x00, 0x00,
+    0x00, 0xCB, 0x00, 0x00, 0x00, 0x03, 0xEB, 0x20, 0x28, 0xB0, 0x02, 0xAE, 0xFE, 0xA2, 0xCF, 0xFF,
+    0xEC, 0x60, 0x0C, 0x90, 0x01, 0x5E, 0x90, 0xC9, 0x00, 0x00, 0x3F, 0x5C, 0x90, 0x00, 0x00, 0xBA,
+    0xC9, 0x00, 0x00, 0x08, 0xDC, 0x90, 0x00, 0x00, 0x8D, 0xC9, 0x00, 0x00, 0x0B, 0xAC, 0x90, 0x00,
+    0x03, 0xF5, 0xC9, 0x00, 0x15, 0xE9, 0x0C, 0xFF, 0xFE, 0xC6, 0x00, 0xCF, 0xFF, 0xFF, 0x6C, 0x90,
+    0x00, 0x00, 0xC9, 0x00, 0x00, 0x0C, 0x90, 0x00, 0x00, 0xC9, 0x00, 0x00, 0x0C, 0xFF, 0xFF, 0x70,
+    0xC9, 0x00, 0x00, 0x0C, 0x90, 0x00, 0x00, 0xC9, 0x00, 0x00, 0x0C, 0xFF, 0xFF, 0xF6, 0xCF, 0xFF,
+    0xFF, 0x6C, 0x90, 0x00, 0x00, 0xC9, 0x00, 0x00, 0x0C, 0x90, 0x00, 0x00, 0xC9, 0x00, 0x00, 0x0C,
+    0xFF, 0xFF, 0xB0, 0xC9, 0x00, 0x00, 0x0C, 0x90, 0x00, 0x00, 0xC9, 0x00, 0x00, 0x0C, 0x90, 0x00,
+    0x00, 0x00, 0x18, 0xDF, 0xEC, 0x60, 0x02, 0xEB, 0x30, 0x15, 0xB1, 0x0C, 0xB0, 0x00, 0x00, 0x00,
+    0x2F, 0x40, 0x00, 0x00, 0x00, 0x5F, 0x10, 0x00, 0x00, 0x00, 0x5F, 0x10, 0x00, 0xAF, 0xF6, 0x2F,
+    0x40, 0x00, 0x00, 0xC6, 0x0C, 0xC0, 0x00, 0x00, 0xC6, 0x02, 0xEB, 0x30, 0x15, 0xE6, 0x00, 0x19,
+    0xDF, 0xEC, 0x71, 0xC9, 0x00, 0x00, 0x0F, 0x5C, 0x90, 0x00, 0x00, 0xF5, 0xC9, 0x00, 0x00, 0x0F,
+    0x5C, 0x90, 0x00, 0x00, 0xF5, 0xC9, 0x00, 0x00, 0x0F, 0x5C, 0xFF, 0xFF, 0xFF, 0xF5, 0xC9, 0x00,
+    0x00, 0x0F, 0x5C, 0x90, 0x00, 0x00, 0xF5, 0xC9, 0x00, 0x00, 0x0F, 0x5C, 0x90, 0x00, 0x00, 0xF5,
+    0x8C, 0x8C, 0x8C, 0x8C, 0x8C, 0x8C, 0x8C, 0x8C, 0x8C, 0x8C, 0x00, 0x05, 0xF0, 0x00, 0x5F, 0x00,
+    0x05, 0xF0, 0x00, 0x5F, 0x00, 0x05, 0xF0, 0x00, 0x5F, 0x00, 0x06, 0xE0, 0x00, 0x7D, 0x00, 0x3D,
+    0x77, 0xED, 0x80, 0xAB, 0x00, 0x00, 0xBA, 0x0A, 0xB0, 0x00, 0x9D, 0x10, 0xAB, 0x00, 0x6E, 0x30,
+    0x0A, 0xB0, 0x3E, 0x50, 0x00, 0xAB, 0x1D, 0x80, 0x00, 0x0A, 0xFF, 0xE2, 0x00, 0x00, 0xAB, 0x1A,
+    0xD2, 0x00, 0x0A, 0xB0, 0x0A, 0xD2, 0x00, 0xAB, 0x00, 0x0A, 0xD1, 0x0A, 0xB0, 0x00, 0x0A, 0xC1,
+    0xC9, 0x00, 0x00, 0xC9, 0x00, 0x00, 0xC9, 0x00, 0x00, 0xC9, 0x00, 0x00, 0xC9, 0x00, 0x00, 0xC9,
+    0x00, 0x00, 0xC9, 0x00, 0x00, 0xC9, 0x00, 0x00, 0xC9, 0x00, 0x00, 0xCF, 0xFF, 0xFE, 0xCC, 0x00,
+    0x00, 0x00, 0x1D, 0xAC, 0xF6, 0x00, 0x00, 0x08, 0xFA, 0xCB, 0xE1, 0x00, 0x01, 0xEB, 0xAC, 0x6C,
+    0x80, 0x00, 0x9A, 0x8A, 0xC6, 0x3E, 0x20, 0x3E, 0x28, 0xAC, 0x60, 0xAA, 0x0B, 0x90, 0x8A, 0xC6,
+    0x02, 0xF7, 0xE1, 0x08, 0xAC, 0x60, 0x08, 0xF7, 0x00, 0x8A, 0xC6, 0x00, 0x18, 0x00, 0x08, 0xAC,
+    0x60, 0x00, 0x00, 0x00, 0x8A, 0xC9, 0x00, 0x00, 0x0D, 0x5C, 0xF5, 0x00, 0x00, 0xD5, 0xCC, 0xE3,
+    0x00, 0x0D, 0x5C, 0x69, 0xD1, 0x00, 0xD5, 0xC6, 0x1C, 0xA0, 0x0D, 0x5C, 0x60, 0x2E, 0x70, 0xD5,
+    0xC6, 0x00, 0x5F, 0x3D, 0x5C, 0x60, 0x00, 0x8D, 0xD5, 0xC6, 0x00, 0x00, 0xBF, 0x5C, 0x60, 0x00,
+    0x01, 0xD5, 0x00, 0x19, 0xDF, 0xEA, 0x20, 0x00, 0x2E, 0xB3, 0x02, 0x9E, 0x40, 0x0B, 0xB0, 0x00,
+    0x00, 0x9D, 0x02, 0xF4, 0x00, 0x00, 0x02, 0xF5, 0x5F, 0x20, 0x00, 0x00, 0x0E, 0x75, 0xF2, 0x00,
+    0x00, 0x00, 0xE7, 0x2F, 0x40, 0x00, 0x00, 0x2F, 0x50, 0xBB, 0x00, 0x00, 0x09, 0xE1, 0x02, 0xEB,
+    0x20, 0x29, 0xE4, 0x00, 0x01, 0x9D, 0xFE, 0xA2, 0x00, 0xAF, 0xFF, 0xD8, 0x10, 0xAB, 0x00, 0x4D,
+    0x90, 0xAB, 0x00, 0x06, 0xE0, 0xAB, 0x00, 0x06, 0xE0, 0xAB, 0x00, 0x4D, 0x90, 0xAF, 0xFF, 0xD7,
+    0x00, 0xAB, 0x00, 0x00, 0x00, 0xAB, 0x00, 0x00, 0x00, 0xAB, 0x00, 0x00, 0x00, 0xAB, 0x00, 0x00,
+    0x00, 0x00, 0x19, 0xDF, 0xE9, 0x20, 0x00, 0x2E, 0xB3, 0x02, 0x9E, 0x40, 0x0B, 0xB0, 0x00, 0x00,
+    0x9D, 0x02, 0xF4, 0x00, 0x00, 0x02, 0xF4, 0x5F, 0x20, 0x00, 0x00, 0x0E, 0x75, 0xF2, 0x00, 0x00,
+    0x00, 0xE7, 0x2F, 0x40, 0x00, 0x00, 0x2F, 0x50, 0xBB, 0x00, 0x00, 0x09, 0xE1, 0x02, 0xEB, 0x20,
+    0x29, 0xF5, 0x00, 0x01, 0x9D, 0xFE, 0xEA, 0x00, 0x00, 0x00, 0x00, 0x02, 0xD8, 0x00, 0x00, 0x00,
+    0x00, 0x03, 0xD8, 0xAF, 0xFF, 0xD7, 0x00, 0xAB, 0x01, 0x4E, 0x70, 0xAB, 0x00, 0x08, 0xC0, 0xAB,
+    0x00, 0x09, 0xB0, 0xAB, 0x01, 0x5E, 0x50, 0xAF, 0xFF, 0xC4, 0x00, 0xAB, 0x07, 0xE2, 0x00, 0xAB,
+    0x00, 0xAC, 0x10, 0xAB, 0x00, 0x1D, 0x90, 0xAB, 0x00, 0x03, 0xE6, 0x02, 0xAE, 0xEB, 0x30, 0xC9,
+    0x11, 0x75, 0x1F, 0x20, 0x00, 0x00, 0xF9, 0x10, 0x00, 0x06, 0xFE, 0xA4, 0x00, 0x02, 0x7C, 0xF6,
+    0x00, 0x00, 0x0A, 0xC0, 0x00, 0x00, 0x6C, 0x5B, 0x31, 0x3D, 0x60, 0x8D, 0xFD, 0x60, 0xCF, 0xFF,
+    0xFF, 0xFF, 0x10, 0x00, 0x8C, 0x00, 0x00, 0x00, 0x08, 0xC0, 0x00, 0x00, 0x00, 0x8C, 0x00, 0x00,
+    0x00, 0x08, 0xC0, 0x00, 0x00, 0x00, 0x8C, 0x00, 0x00, 0x00, 0x08, 0xC0, 0x00, 0x00, 0x00, 0x8C,
+    0x00, 0x00, 0x00, 0x08, 0xC0, 0x00, 0x00, 0x00, 0x8C, 0x00, 0x00, 0xD7, 0x00, 0x00, 0x4F, 0x2D,
+    0x70, 0x00, 0x04, 0xF2, 0xD7, 0x00, 0x00, 0x4F, 0x2D, 0x70, 0x00, 0x04, 0xF2, 0xD7, 0x00, 0x00,
+    0x4F, 0x2D, 0x70, 0x00, 0x04, 0xF2, 0xD8, 0x00, 0x00, 0x5F, 0x19, 0xC0, 0x00, 0x08, 0xC0, 0x1E,
+    0x82, 0x16, 0xE4, 0x00, 0x2A, 0xEF, 0xC3, 0x00, 0xBA, 0x00, 0x00, 0x02, 0xF4, 0x5F, 0x10, 0x00,
+    0x09, 0xD0, 0x0E, 0x70, 0x00, 0x0E, 0x60, 0x08, 0xD0, 0x00, 0x6E, 0x10, 0x02, 0xF4, 0x00, 0xC9,
+    0x00, 0x00, 0xAA, 0x03, 0xF3, 0x00, 0x00, 0x4F, 0x29, 0xC0, 0x00, 0x00, 0x0D, 0x7E, 0x60, 0x00,
+    0x00, 0x07, 0xEE, 0x10, 0x00, 0x00, 0x01, 0xF9, 0x00, 0x00, 0xBB, 0x00, 0x00, 0x8D, 0x00, 0x00,
+    0x5E, 0x17, 0xF1, 0x00, 0x0D, 0xF3, 0x00, 0x0A, 0xA0, 0x2F, 0x50, 0x03, 0xEB, 0x80, 0x01, 0xE6,
+    0x00, 0xCA, 0x00, 0x8A, 0x6D, 0x00, 0x5F, 0x10, 0x07, 0xE0, 0x0D, 0x41, 0xF3, 0x09, 0xB0, 0x00,
+    0x3F, 0x34, 0xE0, 0x0B, 0x90, 0xD7, 0x00, 0x00, 0xD8, 0x99, 0x00, 0x6E, 0x3F, 0x20, 0x00, 0x08,
+    0xCD, 0x40, 0x01, 0xFB, 0xC0, 0x00, 0x00, 0x4F, 0xE0, 0x00, 0x0A, 0xF7, 0x00, 0x00, 0x00, 0xE9,
+    0x00, 0x00, 0x5F, 0x30, 0x00, 0x6E, 0x20, 0x00, 0x1E, 0x70, 0xBC, 0x00, 0x0A, 0xB0, 0x02, 0xE7,
+    0x05, 0xE2, 0x00, 0x06, 0xE3, 0xE6, 0x00, 0x00, 0x0B, 0xFB, 0x00, 0x00, 0x00, 0xCD, 0xD1, 0x00,
+    0x00, 0x8D, 0x1D, 0x80, 0x00, 0x3F, 0x30, 0x4F, 0x30, 0x1D, 0x80, 0x00, 0xAD, 0x19, 0xD1, 0x00,
+    0x01, 0xE8, 0xAC, 0x00, 0x00, 0x1E, 0x71, 0xE6, 0x00, 0x09, 0xD0, 0x06, 0xE1, 0x03, 0xF4, 0x00,
+    0x0C, 0x90, 0xBA, 0x00, 0x00, 0x3F, 0x7E, 0x10, 0x00, 0x00, 0x9F, 0x60, 0x00, 0x00, 0x04, 0xF1,
+    0x00, 0x00, 0x00, 0x4F, 0x10, 0x00, 0x00, 0x04, 0xF1, 0x00, 0x00, 0x00, 0x4F, 0x10, 0x00, 0x2F,
+    0xFF, 0xFF, 0xFF, 0x20, 0x00, 0x00, 0x1D, 0xA0, 0x00, 0x00, 0x0A, 0xD1, 0x00, 0x00, 0x05, 0xF4,
+    0x00, 0x00, 0x02, 0xE8, 0x00, 0x00, 0x00, 0xBC, 0x00, 0x00, 0x00, 0x7F, 0x30, 0x00, 0x00, 0x3F,
+    0x60, 0x00, 0x00, 0x0D, 0xB0, 0x00, 0x00, 0x05, 0xFF, 0xFF, 0xFF, 0xF2, 0xFF, 0x8F, 0x10, 0xF1,
+    0x0F, 0x10, 0xF1, 0x0F, 0x10, 0xF1, 0x0F, 0x10, 0xF1, 0x0F, 0x10, 0xF1, 0x0F, 0x10, 0xFF, 0x80,
+    0x0C, 0x10, 0x00, 0x00, 0x87, 0x00, 0x00, 0x02, 0xD0, 0x00, 0x00, 0x0A, 0x50, 0x00, 0x00, 0x4B,
+    0x00, 0x00, 0x00, 0xD2, 0x00, 0x00, 0x06, 0x90, 0x00, 0x00, 0x1E, 0x10, 0x00, 0x00, 0x96, 0x00,
+    0x00, 0x03, 0xC0, 0x00, 0x00, 0x06, 0x10, 0x5F, 0xF3, 0x00, 0xD3, 0x00, 0xD3, 0x00, 0xD3, 0x00,
+    0xD3, 0x00, 0xD3, 0x00, 0xD3, 0x00, 0xD3, 0x00, 0xD3, 0x00, 0xD3, 0x00, 0xD3, 0x00, 0xD3, 0x5F,
+    0xF3, 0x00, 0xAA, 0x00, 0x03, 0xDD, 0x40, 0x0C, 0x65, 0xC0, 0x5D, 0x00, 0xB5, 0x63, 0x00, 0x26,
+    0xFF, 0xFF, 0xF8, 0x4E, 0x20, 0x6B, 0x04, 0xCF, 0xD5, 0x00, 0x84, 0x16, 0xE1, 0x00, 0x00, 0x0F,
+    0x30, 0x3A, 0xDF, 0xF4, 0x2F, 0x62, 0x0F, 0x44, 0xE2, 0x16, 0xF4, 0x0A, 0xFD, 0x5B, 0x40, 0xE5,
+    0x00, 0x00, 0x0E, 0x50, 0x00, 0x00, 0xE5, 0x00, 0x00, 0x0E, 0x6B, 0xEC, 0x30, 0xEC, 0x21, 0x9D,
+    0x0E, 0x50, 0x01, 0xF3, 0xE5, 0x00, 0x0F, 0x4E, 0x50, 0x02, 0xF2, 0xEA, 0x12, 0xBB, 0x0E, 0x6D,
+    0xFA, 0x10, 0x02, 0xBF, 0xD8, 0x01, 0xD9, 0x11, 0x60, 0x5E, 0x00, 0x00, 0x07, 0xC0, 0x00, 0x00,
+    0x5E, 0x00, 0x00, 0x01, 0xD9, 0x12, 0x81, 0x03, 0xBE, 0xD8, 0x00, 0x00, 0x00, 0x07, 0xB0, 0x00,
+    0x00, 0x7B, 0x00, 0x00, 0x07, 0xB0, 0x2C, 0xEC, 0xAB, 0x1E, 0x91, 0x2C, 0xB5, 0xE0, 0x00, 0x7B,
+    0x7C, 0x00, 0x07, 0xB6, 0xE0, 0x00, 0x7B, 0x2F, 0x71, 0x4D, 0xB0, 0x5D, 0xEA, 0x6B, 0x02, 0xBE,
+    0xD6, 0x01, 0xD8, 0x13, 0xD4, 0x5E, 0x00, 0x06, 0x97, 0xFF, 0xFF, 0xFB, 0x5D, 0x00, 0x00, 0x00,
+    0xD8, 0x11, 0x54, 0x02, 0xAE, 0xEA, 0x20, 0x01, 0xAE, 0x80, 0x8C, 0x10, 0x0A, 0x80, 0x0B, 0xFF,
+    0xF8, 0x0B, 0x80, 0x00, 0xB8, 0x00, 0x0B, 0x80, 0x00, 0xB8, 0x00, 0x0B, 0x80, 0x00, 0xB8, 0x00,
+    0x06, 0xDF, 0xFF, 0xE2, 0xF3, 0x05, 0xE2, 0x2E, 0x30, 0x5E, 0x00, 0x7E, 0xFC, 0x40, 0x0E, 0x30,
+    0x00, 0x00, 0xBF, 0xFF, 0xD4, 0x6A, 0x00, 0x19, 0xA8, 0xB2, 0x02, 0xB7, 0x19, 0xEF, 0xD7, 0x00,
+    0xF4, 0x00, 0x00, 0xF4, 0x00, 0x00, 0xF4, 0x00, 0x00, 0xF6, 0xBE, 0xC2, 0xFC, 0x21, 0xBA, 0xF4,
+    0x00, 0x5D, 0xF4, 0x00, 0x5E, 0xF4, 0x00, 0x5E, 0xF4, 0x00, 0x5E, 0xF4, 0x00, 0x5E, 0x0D, 0x70,
+    0x00, 0x00, 0x00, 0xD6, 0x0D, 0x60, 0xD6, 0x0D, 0x60, 0xD6, 0x0D, 0x60, 0xD6, 0x00, 0xD7, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xD6, 0x00, 0xD6, 0x00, 0xD6, 0x00, 0xD6, 0x00, 0xD6, 0x00, 0xD6, 0x00,
+    0xD6, 0x01, 0xE5, 0x5F, 0xB1, 0xE5, 0x00, 0x00, 0x0E, 0x50, 0x00, 0x00, 0xE5, 0x00, 0x00, 0x0E,
+    0x50, 0x1C, 0x70, 0xE5, 0x0B, 0x90, 0x0E, 0x5A, 0xB0, 0x00, 0xEF, 0xF3, 0x00, 0x0E, 0x58, 0xD1,
+    0x00, 0xE5, 0x0A, 0xC1, 0x0E, 0x50, 0x0B, 0xA0, 0xD6, 0xD6, 0xD6, 0xD6, 0xD6, 0xD6, 0xD6, 0xD6,
+    0xD6, 0xD6, 0xF4, 0xDE, 0x64, 0xDE, 0xA0, 0xFA, 0x23, 0xEB, 0x22, 0xE6, 0xF4, 0x00, 0xD7, 0x00,
+    0xA9, 0xF4, 0x00, 0xC7, 0x00, 0x9A, 0xF4, 0x00, 0xC7, 0x00, 0x9A, 0xF4, 0x00, 0xC7, 0x00, 0x9A,
+    0xF4, 0x00, 0xC7, 0x00, 0x9A, 0xF4, 0xCE, 0xC2, 0xFB, 0x21, 0xBA, 0xF4, 0x00, 0x5D, 0xF4, 0x00,
+    0x5E, 0xF4, 0x00, 0x5E, 0xF4, 0x00, 0x5E, 0xF4, 0x00, 0x5E, 0x02, 0xAE, 0xD9, 0x10, 0x1D, 0x91,
+    0x2B, 0xA0, 0x5E, 0x00, 0x03, 0xF1, 0x7C, 0x00, 0x01, 0xF3, 0x5E, 0x00, 0x03, 0xF2, 0x1D, 0x81,
+    0x2B, 0xB0, 0x02, 0xBE, 0xE9, 0x10, 0xF3, 0xBE, 0xC3, 0x0F, 0xB2, 0x1A, 0xC0, 0xF4, 0x00, 0x2F,
+    0x2F, 0x40, 0x01, 0xF3, 0xF4, 0x00, 0x3F, 0x2F, 0x91, 0x2B, 0xB0, 0xF9, 0xDE, 0xA1, 0x0F, 0x40,
+    0x00, 0x00, 0xF4, 0x00, 0x00, 0x00, 0x02, 0xCE, 0xC7, 0xB1, 0xE9, 0x12, 0xCB, 0x5E, 0x00, 0x07,
+    0xB7, 0xC0, 0x00, 0x7B, 0x6E, 0x00, 0x07, 0xB2, 0xF7, 0x14, 0xDB, 0x05, 0xDE, 0x98, 0xB0, 0x00,
+    0x00, 0x7B, 0x00, 0x00, 0x07, 0xB0, 0xF5, 0xCF, 0x3F, 0xC2, 0x00, 0xF5, 0x00, 0x0F, 0x40, 0x00,
+    0xF4, 0x00, 0x0F, 0x40, 0x00, 0xF4, 0x00, 0x00, 0x08, 0xEE, 0xA1, 0x4E, 0x31, 0x51, 0x3E, 0x40,
+    0x00, 0x05, 0xBD, 0x80, 0x00, 0x01, 0xD6, 0x36, 0x12, 0xD5, 0x2B, 0xFE, 0x80, 0x02, 0x50, 0x00,
+    0x5A, 0x00, 0x07, 0xA0, 0x09, 0xFF, 0xFB, 0x09, 0xA0, 0x00, 0x9A, 0x00, 0x09, 0xA0, 0x00, 0x9A,
+    0x00, 0x08, 0xC1, 0x20, 0x2D, 0xE8, 0x2F, 0x10, 0x07, 0xB2, 0xF1, 0x00, 0x7B, 0x2F, 0x10, 0x07,
+    0xB2, 0xF1, 0x00, 0x7B, 0x2F, 0x20, 0x07, 0xB0, 0xE8, 0x14, 0xDB, 0x04, 0xDE, 0xA6, 0xB0, 0xA9,
+    0x00, 0x06, 0xC4, 0xE1, 0x00, 0xC6, 0x0D, 0x60, 0x3E, 0x10, 0x6C, 0x09, 0x90, 0x01, 0xE4, 0xE3,
+    0x00, 0x09, 0xDB, 0x00, 0x00, 0x3F, 0x50, 0x00, 0xB8, 0x00, 0x4F, 0x20, 0x0B, 0x76, 0xD0, 0x0A,
+    0xE6, 0x01, 0xF2, 0x1F, 0x20, 0xE6, 0xB0, 0x5C, 0x00, 0xB7, 0x5B, 0x1E, 0x1A, 0x70, 0x07, 0xB9,
+    0x60, 0xA6, 0xE2, 0x00, 0x2E, 0xE1, 0x05, 0xDD, 0x00, 0x00, 0xCA, 0x00, 0x1E, 0x80, 0x00, 0x5E,
+    0x20, 0x1D, 0x60, 0xAA, 0x09, 0xA0, 0x01, 0xE8, 0xE1, 0x00, 0x07, 0xF8, 0x00, 0x02, 0xE7, 0xE2,
+    0x00, 0xB8, 0x08, 0xC0, 0x7C, 0x00, 0x1D, 0x70, 0xAA, 0x00, 0x06, 0xC0, 0x3F, 0x20, 0x0D, 0x60,
+    0x0B, 0x90, 0x4D, 0x00, 0x04, 0xE1, 0xB7, 0x00, 0x00, 0xC9, 0xE1, 0x00, 0x00, 0x5F, 0x80, 0x00,
+    0x00, 0x2F, 0x20, 0x00, 0x00, 0x8A, 0x00, 0x00, 0x01, 0xE3, 0x00, 0x00, 0x4F, 0xFF, 0xFE, 0x00,
+    0x01, 0xC6, 0x00, 0x09, 0xA0, 0x00, 0x6C, 0x10, 0x03, 0xE2, 0x00, 0x1D, 0x50, 0x00, 0x7F, 0xFF,
+    0xFC, 0x05, 0xD8, 0x0E, 0x50, 0x1F, 0x00, 0x0E, 0x20, 0x0C, 0x40, 0x1E, 0x30, 0xAB, 0x00, 0x1E,
+    0x40, 0x0C, 0x40, 0x0E, 0x20, 0x1F, 0x00, 0x0E, 0x40, 0x05, 0xD8, 0x69, 0x69, 0x69, 0x69, 0x69,
+    0x69, 0x69, 0x69, 0x69, 0x69, 0x69, 0x69, 0x69, 0x5E, 0x70, 0x02, 0xE2, 0x00, 0xC4, 0x00, 0xE2,
+    0x01, 0xF0, 0x01, 0xF2, 0x00, 0x8D, 0x01, 0xF2, 0x01, 0xF0, 0x00, 0xE2, 0x00, 0xC4, 0x02, 0xE2,
+    0x5E, 0x70, 0x06, 0xEC, 0x51, 0xD3, 0x1E, 0x24, 0xBE, 0x90, 0x16, 0x00, 0x00, 0x00,
+};
+
+static const AAGlyph font_sans_14_glyphs[] = {
+    {     0,  0,  0,  3,   0,   0 },  // ' '
+    {     0,  3, 10,  5,   1, -10 },  // '!'
+    {    15,  4,  3,  6,   1, -10 },  // '"'
+    {    21,  8, 10,  8,   0, -10 },  // '#'
+    {    61,  8, 12,  8,   0, -11 },  // '$'
+    {   109, 11, 10, 11,   0, -10 },  // '%'
+    {   164, 10, 10, 10,   0, -10 },  // '&'
+    {   214,  2,  3,  3,   1, -10 },  // '''
+    {   217,  4, 13,  4,   0, -11 },  // '('
+    {   243,  4, 13,  4,   0, -11 },  // ')'
+    {   269,  5,  4,  6,   0, -10 },  // '*'
+    {   279,  8,  7,  8,   0,  -8 },  // '+'
+    {   307,  3,  3,  3,   0,  -1 },  // ','
+    {   312,  5,  1,  5,   0,  -5 },  // '-'
+    {   315,  3,  1,  3,   0,  -1 },  // '.'
+    {   317,  7, 11,  5,  -1, -10 },  // '/'
+    {   356,  8, 10,  8,   0, -10 },  // '0'
+    {   396,  7, 10,  8,   1, -10 },  // '1'
+    {   431,  8, 10,  8,   0, -10 },  // '2'
+    {   471,  8, 10,  8,   0, -10 },  // '3'
+    {   511,  8, 10,  8,   0, -10 },  // '4'
+    {   551,  8, 10,  8,   0, -10 },  // '5'
+    {   591,  8, 10,  8,   0, -10 },  // '6'
+    {   631,  8, 10,  8,   0, -10 },  // '7'
+    {   671,  8, 10,  8,   0, -10 },  // '8'
+    {   711,  7, 10,  8,   1, -10 },  // '9'
+    {   746,  3,  7,  4,   0,  -7 },  // ':'
+    {   757,  3,  9,  4,   0,  -7 },  // ';'
+    {   771,  6,  7,  8,   1,  -8 },  // '<'
+    {   792,  7,  3,  8,   1,  -6 },  // '='
+    {   803,  7,  7,  8,   1,  -8 },  // '>'
+    {   828,  6, 10,  6,   0, -10 },  // '?'
+    {   858, 11, 11, 12,   0,  -9 },  // '@'
+    {   919, 10, 10, 10,   0, -10 },  // 'A'
+    {   969,  8, 10,  9,   1, -10 },  // 'B'
+    {  1009,  9, 10, 10,   0, -10 },  // 'C'
+    {  1054,  9, 10, 11,   1, -10 },  // 'D'
+    {  1099,  7, 10,  8,   1, -10 },  // 'E'
+    {  1134,  7, 10,  8,   1, -10 },  // 'F'
+    {  1169, 10, 10, 10,   0, -10 },  // 'G'
+    {  1219,  9, 10, 11,   1, -10 },  // 'H'
+    {  1264,  2, 10,  4,   1, -10 },  // 'I'
+    {  1274,  5, 10,  6,   0, -10 },  // 'J'
+    {  1299,  9, 10, 10,   1, -10 },  // 'K'
+    {  1344,  6, 10,  7,   1, -10 },  // 'L'
+    {  1374, 11, 10, 13,   1, -10 },  // 'M'
+    {  1429,  9, 10, 11,   1, -10 },  // 'N'
+    {  1474, 11, 10, 11,   0, -10 },  // 'O'
+    {  1529,  8, 10,  9,   1, -10 },  // 'P'
+    {  1569, 11, 12, 11,   0, -10 },  // 'Q'
+    {  1635,  8, 10,  9,   1, -10 },  // 'R'
+    {  1675,  7, 10,  7,   0, -10 },  // 'S'
+    {  1710,  9, 10,  8,   0, -10 },  // 'T'
+    {  1755,  9, 10, 10,   1, -10 },  // 'U'
+    {  1800, 10, 10, 10,   0, -10 },  // 'V'
+    {  1850, 15, 10, 14,   0, -10 },  // 'W'
+    {  1925,  9, 10,  9,   0, -10 },  // 'X'
+    {  1970,  9, 10,  9,   0, -10 },  // 'Y'
+    {  2015,  9, 10,  9,   0, -10 },  // 'Z'
+    {  2060,  3, 13,  4,   1, -11 },  // '['
+    {  2080,  7, 11,  5,  -1, -10 },  // backslash
+    {  2119,  4, 13,  4,   0, -11 },  // ']'
+    {  2145,  6,  5,  8,   1, -10 },  // '^'
+    {  2160,  6,  1,  6,   0,   1 },  // '_'
+    {  2163,  3,  2,  4,   0, -10 },  // '`'
+    {  2166,  7,  7,  7,   0,  -7 },  // 'a'
+    {  2191,  7, 10,  8,   1, -10 },  // 'b'
+    {  2226,  7,  7,  7,   0,  -7 },  // 'c'
+    {  2251,  7, 10,  8,   0, -10 },  // 'd'
+    {  2286,  7,  7,  7,   0,  -7 },  // 'e'
+    {  2311,  5, 10,  5,   0, -10 },  // 'f'
+    {  2336,  7,  9,  7,   0,  -7 },  // 'g'
+    {  2368,  6, 10,  8,   1, -10 },  // 'h'
+    {  2398,  3, 10,  4,   0, -10 },  // 'i'
+    {  2413,  4, 12,  4,  -1, -10 },  // 'j'
+    {  2437,  7, 10,  7,   1, -10 },  // 'k'
+    {  2472,  2, 10,  4,   1, -10 },  // 'l'
+    {  2482, 10,  7, 12,   1,  -7 },  // 'm'
+    {  2517,  6,  7,  8,   1,  -7 },  // 'n'
+    {  2538,  8,  7,  8,   0,  -7 },  // 'o'
+    {  2566,  7,  9,  8,   1,  -7 },  // 'p'
+    {  2598,  7,  9,  8,   0,  -7 },  // 'q'
+    {  2630,  5,  7,  6,   1,  -7 },  // 'r'
+    {  2648,  6,  7,  6,   0,  -7 },  // 's'
+    {  2669,  5, 10,  5,   0, -10 },  // 't'
+    {  2694,  7,  7,  8,   0,  -7 },  // 'u'
+    {  2719,  7,  7,  7,   0,  -7 },  // 'v'
+    {  2744, 11,  7, 11,   0,  -7 },  // 'w'
+    {  2783,  7,  7,  7,   0,  -7 },  // 'x'
+    {  2808,  8,  9,  7,   0,  -7 },  // 'y'
+    {  2844,  6,  7,  6,   0,  -7 },  // 'z'
+    {  2865,  4, 13,  4,   0, -11 },  // '{'
+    {  2891,  2, 13,  4,   1, -11 },  // '|'
+    {  2904,  4, 13,  4,   0, -11 },  // '}'
+    {  2930,  8,  3,  8,   0,  -5 },  // '~'
+};
+
+extern const AAFont font_sans_14 = {
+    font_sans_14_bitmap,
+    font_sans_14_glyphs,
+    0x20, 0x7E,  // first, last
+    4,           // bpp
+    17,          // line_height
+    14,          // ascent
+    nullptr,     // codepoints
+    95,          // glyph_count
+    nullptr,     // read
+    nullptr      // read_user
+};
+
+} // namespace st7789
@@ -0,0 +1,334 @@
+#include "st7789_framebuffer.hpp"
+#include <cstdlib>
+#include <cstring>
+
+namespace st7789 {
+
+Rect Rect::unite(const Rect& o) const {
+    if (isEmpty()) return o;
+    if (o.isEmpty()) return *this;
+
+    int16_t x0 = x < o.x ? x : o.x;
+    int16_t y0 = y < o.y ? y : o.y;
+    int16_t x1 = (x + w > o.x + o.w) ? x + w : o.x + o.w;
+    int16_t y1 = (y + h > o.y + o.h) ? y + h : o.y + o.h;
+    return Rect(x0, y0, x1 - x0, y1 - y0);
+}
+
+Rect Rect::intersect(const Rect& o) const {
+    int16_t x0 = x > o.x ? x : o.x;
+    int16_t y0 = y > o.y ? y : o.y;
+    int16_t x1 = (x + w < o.x + o.w) ? x + w : o.x + o.w;
+    int16_t y1 = (y + h < o.y + o.h) ? y + h : o.y + o.h;
+    if (x1 <= x0 || y1 <= y0) {
+        return Rect();
+    }
+    return Rect(x0, y0, x1 - x0, y1 - y0);
+}
+
+FrameBuffer::FrameBuffer() :
+    _buffer(nullptr),
+    _indices(nullptr),
+    _owns_buffer(false),
+    _palette(nullptr),
+    _bpp(16),
+    _row_bytes(0),
+    _cache_color{0, 0},
+    _cache_index{0, 0},
+    _cache_next(0),
+    _width(0),
+    _height(0),
+    _origin_x(0),
+    _origin_y(0),
+    _dirty_count(0),
+    _track_dirty(true) {
+}
+
+FrameBuffer::~FrameBuffer() {
+    end();
+}
+
+bool FrameBuffer::begin(uint16_t width, uint16_t height, uint16_t* buffer) {
+    if (width == 0 || height == 0) {
+        return false;
+    }
+
+    // Keep the current buffer when only the shape changes (e.g. rotation)
+    bool same_size = (size_t)width * height == (size_t)_width * _height;
+    if (_buffer && same_size && (buffer == _buffer || (buffer == nullptr && _owns_buffer))) {
+        buffer = _buffer;
+    } else {
+        end();
+        if (buffer == nullptr) {
+            buffer = (uint16_t*)malloc((size_t)width * height * sizeof(uint16_t));
+            if (!buffer) {
+                return false;
+            }
+            memset(buffer, 0, (size_t)width * height * sizeof(uint16_t));
+            _owns_buffer = true;
+        }
+    }
+
+    _buffer = buffer;
+    _width = width;
+    _height = height;
+    _dirty_count = 0;
+    return true;
+}
+
+bool FrameBuffer::beginIndexed(uint16_t width, uint16_t height, uint8_t bpp, const uint16_t* palette,
+                               uint8_t* buffer) {
+    if (width == 0 || height == 0 || !palette || (bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8)) {
+        return false;
+    }
+
+    // Copy the palette first, it may be the current one
+    size_t colors = (size_t)1 << bpp;
+    uint16_t* copy = (uint16_t*)malloc(colors * sizeof(uint16_t));
+    if (!copy) {
+        return false;
+    }
+    memcpy(copy, palette, colors * sizeof(uint16_t));
+
+    // Keep the current buffer when only the shape changes (e.g. rotation)
+    size_t row_bytes = ((size_t)width * bpp + 7) / 8;
+    size_t bytes = row_bytes * height;
+    bool same_size = bytes == (size_t)_row_bytes * _height;
+    bool owns = false;
+    if (_indices && same_size && (buffer == _indices || (buffer == nullptr && _owns_buffer))) {
+        buffer = _indices;
+        owns = _owns_buffer;
+        _indices = nullptr;
+        _owns_buffer = false;
+    } else if (buffer == _indices) {
+        buffer = nullptr;
+    }
+    end();
+
+    if (buffer == nullptr) {
+        buffer = (uint8_t*)malloc(bytes);
+        if (!buffer) {
+            free(copy);
+            return false;
+        }
+        memset(buffer, 0, bytes);
+        owns = true;
+    }
+
+    _indices = buffer;
+    _owns_buffer = owns;
+    _palette = copy;
+    _bpp = bpp;
+    _row_bytes = row_bytes;
+    _width = width;
+    _height = height;
+    _cache_color[0] = _cache_color[1] = palette[0];
+    _cache_index[0] = _cache_index[1] = 0;
+    _dirty_count = 0;
+    return true;
+}
+
+void FrameBuffer::end() {
+    if (_owns_buffer) {
+        free(_buffer);
+        free(_indices);
+    }
+    free(_palette);
+    _buffer = nullptr;
+    _indices = nullptr;
+    _palette = nullptr;
+    _bpp = 16;
+    _row_bytes = 0;
+    _owns_buffer = false;
+    _width = 0;
+    _height = 0;
+    _dirty_count = 0;
+}
+
+void FrameBuffer::setPalette(uint8_t index, uint16_t color) {
+    if (!_palette || index >= (1 << _bpp) || _palette[index] == color) return;
+    _palette[index] = color;
+    _cache_color[0] = _cache_color[1] = _palette[0];
+    _cache_index[0] = _cache_index[1] = 0;
+    markAllDirty();
+}
+
+uint8_t FrameBuffer::nearestIndex(uint16_t color) {
+    if (_cache_color[0] == color) return _cache_index[0];
+    if (_cache_color[1] == color) return _cache_index[1];
+
+    // Closest by squared distance, channels scaled to 6 bits
+    int r = (color >> 11) << 1;
+    int g = (color >> 5) & 0x3F;
+    int b = (color & 0x1F) << 1;
+    uint8_t best = 0;
+    int32_t best_dist = INT32_MAX;
+    for (size_t i = 0; i < ((size_t)1 << _bpp); i++) {
+        uint16_t c = _palette[i];
+        int dr = ((c >> 11) << 1) - r;
+        int dg = ((c >> 5) & 0x3F) - g;
+        int db = ((c & 0x1F) << 1) - b;
+        int32_t dist = dr * dr + dg * dg + db * db;
+        if (dist < best_dist) {
+            best_dist = dist;
+            best = i;
+            if (dist == 0) break;
+        }
+    }
+
+    _cache_color[_cache_next] = color;
+    _cache_index[_cache_next] = best;
+    _cache_next ^= 1;
+    return best;
+}
+
+void FrameBuffer::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < _origin_x || y < _origin_y || x >= _origin_x + _width || y >= _origin_y + _height) return;
+
+    if (_buffer) {
+        *pixelPtr(x, y) = color;
+    } else if (_indices) {
+        setIndex(x, y, nearestIndex(color));
+    } else {
+        return;
+    }
+    addDirty(Rect(x, y, 1, 1));
+}
+
+// Whole bytes of a row are set at once, partial ones pixel by pixel
+void FrameBuffer::fillIndices(const Rect& r, uint8_t index) {
+    uint8_t pattern = index;
+    for (uint8_t bits = _bpp; bits < 8; bits *= 2) {
+        pattern |= pattern << bits;
+    }
+
+    const uint8_t per_byte = 8 / _bpp;
+    for (int16_t j = r.y; j < r.y + r.h; j++) {
+        int16_t x = r.x;
+        int16_t end = r.x + r.w;
+        while (x < end && (x - _origin_x) % per_byte != 0) {
+            setIndex(x++, j, index);
+        }
+        int16_t bytes = (end - x) / per_byte;
+        if (bytes > 0) {
+            memset(_indices + (j - _origin_y) * _row_bytes + (x - _origin_x) / per_byte, pattern, bytes);
+            x += bytes * per_byte;
+        }
+        while (x < end) {
+            setIndex(x++, j, index);
+        }
+    }
+}
+
+void FrameBuffer::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    Rect r = Rect(x, y, w, h).intersect(bounds());
+    if (r.isEmpty() || !isValid()) return;
+
+    if (_indices) {
+        fillIndices(r, nearestIndex(color));
+        addDirty(r);
+        return;
+    }
+
+    uint16_t* row = pixelPtr(r.x, r.y);
+    for (int16_t j = 0; j < r.h; j++) {
+        for (int16_t i = 0; i < r.w; i++) {
+            row[i] = color;
+        }
+        row += _width;
+    }
+
+    addDirty(r);
+}
+
+void FrameBuffer::writePixels(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data, int16_t stride,
+                              PixelOrder order) {
+    Rect r = Rect(x, y, w, h).intersect(bounds());
+    if (r.isEmpty() || !isValid()) return;
+
+    // Skip the clipped-away part of the source
+    const uint16_t* src = data + (r.y - y) * stride + (r.x - x);
+    if (_indices) {
+        for (int16_t j = 0; j < r.h; j++) {
+            for (int16_t i = 0; i < r.w; i++) {
+                uint16_t c = src[i];
+                if (order == PIXEL_PANEL) {
+                    c = (c << 8) | (c >> 8);
+                } else if (order == PIXEL_RGB444) {
+                    c = rgb444To565(c);
+                }
+                setIndex(r.x + i, r.y + j, nearestIndex(c));
+            }
+            src += stride;
+        }
+        addDirty(r);
+        return;
+    }
+    uint16_t* dst = pixelPtr(r.x, r.y);
+    for (int16_t j = 0; j < r.h; j++) {
+        if (order == PIXEL_NATIVE) {
+            memcpy(dst, src, r.w * sizeof(uint16_t));
+        } else if (order == PIXEL_RGB444) {
+            for (int16_t i = 0; i < r.w; i++) {
+                dst[i] = rgb444To565(src[i]);
+            }
+        } else {
+            for (int16_t i = 0; i < r.w; i++) {
+                dst[i] = (src[i] << 8) | (src[i] >> 8);
+            }
+        }
+        src += stride;
+        dst += _width;
+    }
+
+    addDirty(r);
+}
+
+void FrameBuffer::markDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+    Rect r = Rect(x, y, w, h).intersect(bounds());
+    if (!r.isEmpty()) {
+        addDirty(r);
+    }
+}
+
+void FrameBuffer::addDirty(const Rect& r) {
+    if (!_track_dirty) return;
+
+    Rect pending = r;
+
+    // Merge with existing rectangles while it saves window setups
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (uint8_t i = 0; i < _dirty_count; i++) {
+            Rect u = _dirty[i].unite(pending);
+            if (u.area() <= _dirty[i].area() + pending.area() + MERGE_SLACK) {
+                pending = u;
+                _dirty[i] = _dirty[--_dirty_count];
+                merged = true;
+                break;
+            }
+        }
+    }
+
+    if (_dirty_count < MAX_DIRTY_RECTS) {
+        _dirty[_dirty_count++] = pending;
+        return;
+    }
+
+    // List full, merge into the rectangle that grows the least
+    uint8_t best = 0;
+    int32_t best_growth = INT32_MAX;
+    for (uint8_t i = 0; i < _dirty_count; i++) {
+        int32_t growth = _dirty[i].unite(pending).area() - _dirty[i].area();
+        if (growth < best_growth) {
+            best_growth = growth;
+            best = i;
+        }
+    }
+    pending = _dirty[best].unite(pending);
+    _dirty[best] = _dirty[--_dirty_count];
+    addDirty(pending);
+}
+
+} // namespace st7789
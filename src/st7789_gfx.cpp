@@ -1,17 +1,33 @@
 #include "st7789_gfx.hpp"
 #include "st7789.hpp"
+#include "st7789_image.hpp"
+#include "st7789_jpeg.hpp"
 #include <cstdlib>
+#include <cstdio>
+#include <cstring>
 #include <cmath>
+#include <utility>
+#include <algorithm>
 
 // Forward declaration of font data
 extern const unsigned char font[];
 
 namespace st7789 {
 
-Graphics::Graphics(ST7789* lcd) : _lcd(lcd) {
+Graphics::Graphics(ST7789* lcd) :
+    _lcd(lcd),
+    _fb(nullptr),
+    _text_buf(nullptr),
+    _text_buf_pixels(0),
+    _lut_color(0),
+    _lut_bg(0),
+    _lut_valid(false) {
 }
 
 Graphics::~Graphics() {
+    if (_text_buf) {
+        free(_text_buf);
+    }
 }
 
 // Convert RGB values to 16-bit color
@@ -19,23 +35,65 @@ uint16_t Graphics::color565(uint8_t r, uint8_t g, uint8_t b) {
     return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
 }
 
+// Screen area, narrowed to the framebuffer when drawing into one
+Rect Graphics::clipBounds() const {
+    Rect r(0, 0, _lcd->hal().getConfig().width, _lcd->hal().getConfig().height);
+    if (_fb) {
+        r = r.intersect(_fb->bounds());
+    }
+    return r;
+}
+
+// Clip a rectangle to the framebuffer or the screen
+bool Graphics::clipRect(int16_t& x, int16_t& y, int16_t& w, int16_t& h) const {
+    Rect r = Rect(x, y, w, h).intersect(clipBounds());
+    
+    x = r.x;
+    y = r.y;
+    w = r.w;
+    h = r.h;
+    return !r.isEmpty();
+}
+
 // Draw a single pixel
 void Graphics::drawPixel(int16_t x, int16_t y, uint16_t color) {
-    // Access main LCD class to set drawing window and send data
-    _lcd->setAddrWindow(x, y, x, y);
+    int16_t w = 1, h = 1;
+    if (!clipRect(x, y, w, h)) {
+        return;
+    }
     
-    // Convert single pixel data to bytes and send
-    uint8_t data[2];
-    data[0] = color >> 8;
-    data[1] = color & 0xFF;
+    if (_fb) {
+        _fb->drawPixel(x, y, color);
+        return;
+    }
     
-    _lcd->hal().writeDataBulk(data, 2);
+    // Access main LCD class to set drawing window and send data,
+    // all under one chip select
+    y = _lcd->screenToMemoryY(y);
+    _lcd->hal().beginTransaction();
+    _lcd->setAddrWindow(x, y, x, y);
+    
+    _lcd->hal().writePixel(color);
+    _lcd->hal().endTransaction();
 }
 
 // Draw a line
 void Graphics::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
-    // Use Bresenham's algorithm to draw line
-    int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+    // Axis-aligned lines are a single span
+    if (y0 == y1) {
+        if (x0 > x1) std::swap(x0, x1);
+        drawFastHLine(x0, y0, x1 - x0 + 1, color);
+        return;
+    }
+    if (x0 == x1) {
+        if (y0 > y1) std::swap(y0, y1);
+        drawFastVLine(x0, y0, y1 - y0 + 1, color);
+        return;
+    }
+    
+    // Run-length Bresenham: walk the major axis and emit each stretch of
+    // constant minor coordinate as one span
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
     
     if (steep) {
         std::swap(x0, y0);
@@ -47,69 +105,120 @@ void Graphics::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t
         std::swap(y0, y1);
     }
     
-    int16_t dx = x1 - x0;
-    int16_t dy = abs(y1 - y0);
-    int16_t err = dx / 2;
+    int32_t dx = x1 - x0;
+    int32_t dy = abs(y1 - y0);
+    int32_t half = dx / 2;
     int16_t ystep = (y0 < y1) ? 1 : -1;
     
-    for (; x0 <= x1; x0++) {
-        if (steep) {
-            drawPixel(y0, x0, color);
-        } else {
-            drawPixel(x0, y0, color);
-        }
-        
+    // Clip up front in the (major, minor) frame
+    Rect b = clipBounds();
+    if (b.isEmpty()) {
+        return;
+    }
+    int32_t major_min = steep ? b.y : b.x;
+    int32_t major_max = steep ? b.y + b.h - 1 : b.x + b.w - 1;
+    int32_t minor_min = steep ? b.x : b.y;
+    int32_t minor_max = steep ? b.x + b.w - 1 : b.y + b.h - 1;
+    
+    // Steps k along the major axis, minor steps n taken after step k
+    int32_t k_first = std::max<int32_t>(0, major_min - x0);
+    int32_t k_last = std::min<int32_t>(dx, major_max - x0);
+    int32_t n_min = (ystep > 0) ? minor_min - y0 : y0 - minor_max;
+    int32_t n_max = (ystep > 0) ? minor_max - y0 : y0 - minor_min;
+    if (n_max < 0 || n_min > dy) {
+        return;
+    }
+    
+    // n(k) = ceil((k * dy - half) / dx), solved for the visible minor range
+    if (n_min > 0) {
+        k_first = std::max<int32_t>(k_first, ((n_min - 1) * dx + half) / dy + 1);
+    }
+    if (n_max < dy) {
+        k_last = std::min<int32_t>(k_last, (n_max * dx + half) / dy);
+    }
+    if (k_first > k_last) {
+        return;
+    }
+    
+    // Bresenham state at the first visible step
+    int32_t n = (k_first * dy > half) ? (k_first * dy - half + dx - 1) / dx : 0;
+    int32_t err = half - k_first * dy + n * dx;
+    int16_t y = y0 + ystep * n;
+    int16_t run_start = x0 + k_first;
+    
+    for (int32_t k = k_first; k <= k_last; k++) {
         err -= dy;
+        if (err < 0 || k == k_last) {
+            int16_t run_end = x0 + k;
+            if (steep) {
+                drawFastVLine(y, run_start, run_end - run_start + 1, color);
+            } else {
+                drawFastHLine(run_start, y, run_end - run_start + 1, color);
+            }
+            run_start = run_end + 1;
+        }
         if (err < 0) {
-            y0 += ystep;
+            y += ystep;
             err += dx;
         }
     }
 }
 
+// Draw horizontal line
+void Graphics::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    // A one pixel high rectangle, clipped once and sent as one burst
+    fillRect(x, y, w, 1, color);
+}
+
+// Draw vertical line
+void Graphics::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    // The window is one column wide, so the panel advances down the column
+    fillRect(x, y, 1, h, color);
+}
+
 // Draw rectangle outline
 void Graphics::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
-    // Draw four edges
-    drawLine(x, y, x + w - 1, y, color);         // Top edge
-    drawLine(x, y + h - 1, x + w - 1, y + h - 1, color); // Bottom edge
-    drawLine(x, y, x, y + h - 1, color);         // Left edge
-    drawLine(x + w - 1, y, x + w - 1, y + h - 1, color); // Right edge
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    
+    // Draw four edges, the sides skip the corners already drawn
+    drawFastHLine(x, y, w, color);                 // Top edge
+    if (h > 1) {
+        drawFastHLine(x, y + h - 1, w, color);     // Bottom edge
+    }
+    if (h > 2) {
+        drawFastVLine(x, y + 1, h - 2, color);     // Left edge
+        if (w > 1) {
+            drawFastVLine(x + w - 1, y + 1, h - 2, color); // Right edge
+        }
+    }
 }
 
 // Fill rectangle
 void Graphics::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
     // Boundary check
-    if (w <= 0 || h <= 0) {
+    if (!clipRect(x, y, w, h)) {
         return;
     }
     
-    // Set drawing window
-    _lcd->setAddrWindow(x, y, x + w - 1, y + h - 1);
-    
-    // Prepare color data
-    uint8_t colorHi = color >> 8;
-    uint8_t colorLo = color & 0xFF;
-    
-    // Calculate total pixels to fill
-    uint32_t total = w * h;
-    
-    // If data amount is large, send in batches
-    const uint32_t batch_size = 128; // Pixels per batch
-    uint8_t buffer[batch_size * 2];  // 2 bytes per pixel
-    
-    // Initialize buffer
-    for (uint32_t i = 0; i < batch_size; i++) {
-        buffer[i * 2] = colorHi;
-        buffer[i * 2 + 1] = colorLo;
+    if (_fb) {
+        _fb->fillRect(x, y, w, h, color);
+        return;
     }
     
-    // Send data in batches
-    uint32_t remaining = total;
-    while (remaining > 0) {
-        uint32_t current_batch = (remaining > batch_size) ? batch_size : remaining;
-        _lcd->hal().writeDataBulk(buffer, current_batch * 2);
-        remaining -= current_batch;
+    // One window per span of memory rows, a single one unless scrolled
+    ST7789::ScrollSpan spans[4];
+    uint8_t count = _lcd->scrollSpans(y, h, spans);
+    _lcd->hal().beginTransaction();
+    for (uint8_t i = 0; i < count; i++) {
+        const ST7789::ScrollSpan& span = spans[i];
+        _lcd->setAddrWindow(x, span.memory_y, x + w - 1, span.memory_y + span.rows - 1);
+        
+        // Solid fill, a single DMA transfer when DMA is enabled
+        _lcd->hal().fillPixelsAsync(color, (size_t)w * span.rows);
     }
+    _lcd->hal().endTransaction();
 }
 
 // Draw circle
@@ -152,7 +261,7 @@ void Graphics::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
 // Fill circle
 void Graphics::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
     // Draw vertical lines to fill circle
-    drawLine(x0, y0 - r, x0, y0 + r, color);
+    drawFastVLine(x0, y0 - r, 2 * r + 1, color);
     
     int16_t f = 1 - r;
     int16_t ddF_x = 1;
@@ -171,10 +280,10 @@ void Graphics::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
         ddF_x += 2;
         f += ddF_x;
         
-        drawLine(x0 + x, y0 - y, x0 + x, y0 + y, color);
-        drawLine(x0 - x, y0 - y, x0 - x, y0 + y, color);
-        drawLine(x0 + y, y0 - x, x0 + y, y0 + x, color);
-        drawLine(x0 - y, y0 - x, x0 - y, y0 + x, color);
+        drawFastVLine(x0 + x, y0 - y, 2 * y + 1, color);
+        drawFastVLine(x0 - x, y0 - y, 2 * y + 1, color);
+        drawFastVLine(x0 + y, y0 - x, 2 * x + 1, color);
+        drawFastVLine(x0 - y, y0 - x, 2 * x + 1, color);
     }
 }
 
@@ -186,110 +295,594 @@ void Graphics::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int1
     drawLine(x2, y2, x0, y0, color);
 }
 
-// Draw character
-void Graphics::drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
-    if ((x >= _lcd->hal().getConfig().width) ||   // Beyond right boundary
-        (y >= _lcd->hal().getConfig().height) ||  // Beyond bottom boundary
-        ((x + 6 * size - 1) < 0) || // Beyond left boundary
-        ((y + 8 * size - 1) < 0))   // Beyond top boundary
+// Fill triangle
+void Graphics::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    // Sort vertices by y (y0 <= y1 <= y2)
+    if (y0 > y1) {
+        std::swap(y0, y1);
+        std::swap(x0, x1);
+    }
+    if (y1 > y2) {
+        std::swap(y1, y2);
+        std::swap(x1, x2);
+    }
+    if (y0 > y1) {
+        std::swap(y0, y1);
+        std::swap(x0, x1);
+    }
+    
+    // All vertices on one row
+    if (y0 == y2) {
+        int16_t a = std::min(x0, std::min(x1, x2));
+        int16_t b = std::max(x0, std::max(x1, x2));
+        drawFastHLine(a, y0, b - a + 1, color);
         return;
+    }
+    
+    // One horizontal span per scanline, edges stepped in fixed ratios
+    int32_t dx01 = x1 - x0, dy01 = y1 - y0;
+    int32_t dx02 = x2 - x0, dy02 = y2 - y0;
+    int32_t dx12 = x2 - x1, dy12 = y2 - y1;
+    int32_t sa = 0;
+    int32_t sb = 0;
+    
+    // Upper part, includes row y1 when the bottom edge is flat
+    int16_t last = (y1 == y2) ? y1 : y1 - 1;
+    int16_t y;
+    for (y = y0; y <= last; y++) {
+        int16_t a = x0 + sa / dy01;
+        int16_t b = x0 + sb / dy02;
+        sa += dx01;
+        sb += dx02;
+        if (a > b) std::swap(a, b);
+        drawFastHLine(a, y, b - a + 1, color);
+    }
     
+    // Lower part, from row y1 (or y1 + 1) down to y2
+    sa = dx12 * (y - y1);
+    sb = dx02 * (y - y0);
+    for (; y <= y2; y++) {
+        int16_t a = x1 + sa / dy12;
+        int16_t b = x0 + sb / dy02;
+        sa += dx12;
+        sb += dx02;
+        if (a > b) std::swap(a, b);
+        drawFastHLine(a, y, b - a + 1, color);
+    }
+}
+
+// Text raster buffer of at least the given size, nullptr if out of memory
+uint16_t* Graphics::textBuffer(size_t pixels) {
+    if (pixels > _text_buf_pixels) {
+        uint16_t* buf = (uint16_t*)realloc(_text_buf, pixels * sizeof(uint16_t));
+        if (!buf) {
+            printf("Failed to allocate text buffer\n");
+            return nullptr;
+        }
+        _text_buf = buf;
+        _text_buf_pixels = pixels;
+    }
+    return _text_buf;
+}
+
+// Expand one 6x8 character cell, scaled, into an RGB565 buffer
+void Graphics::renderGlyph(uint16_t* dst, size_t stride, char c, uint16_t color, uint16_t bg, uint8_t size) const {
     // Ensure character is in printable range
     if (c < ' ' || c > '~')
         c = '?';
     
-    // Font data obtained from font
-    for (int8_t i = 0; i < 6; i++) {
-        uint8_t line;
-        if (i == 5) {
-            line = 0x0;
-        } else {
-            line = font[(c - ' ') * 5 + i];
+    const unsigned char* glyph = &font[(c - ' ') * 5];
+    for (int8_t j = 0; j < 8; j++) {
+        // Expand one font row, then repeat it size times
+        uint16_t* row = dst + j * size * stride;
+        for (int8_t i = 0; i < 6; i++) {
+            uint8_t line = (i == 5) ? 0x0 : glyph[i];
+            uint16_t pixel = (line >> j) & 0x1 ? color : bg;
+            for (uint8_t k = 0; k < size; k++) {
+                row[i * size + k] = pixel;
+            }
         }
-        
-        for (int8_t j = 0; j < 8; j++) {
-            if (line & 0x1) {
-                if (size == 1) {
-                    drawPixel(x + i, y + j, color);
-                } else {
-                    fillRect(x + i * size, y + j * size, size, size, color);
-                }
-            } else if (bg != color) {
-                if (size == 1) {
-                    drawPixel(x + i, y + j, bg);
-                } else {
-                    fillRect(x + i * size, y + j * size, size, size, bg);
+        for (uint8_t k = 1; k < size; k++) {
+            memcpy(row + k * stride, row, 6 * size * sizeof(uint16_t));
+        }
+    }
+}
+
+// Expanded cell from the glyph cache, rendered into it on a miss
+const uint16_t* Graphics::cachedGlyph(char c, uint16_t color, uint16_t bg, uint8_t size) {
+    if (c < ' ' || c > '~')
+        c = '?';
+    
+    const uint16_t* cell = _glyph_cache.find(c, color, bg, size);
+    if (cell) {
+        return cell;
+    }
+    
+    uint16_t* slot = _glyph_cache.insert(c, color, bg, size);
+    if (slot) {
+        renderGlyph(slot, 6 * size, c, color, bg, size);
+    }
+    return slot;
+}
+
+// Transparent background, only set pixels are drawn as vertical runs per column
+void Graphics::drawGlyphTransparent(int16_t x, int16_t y, char c, uint16_t color, uint8_t size) {
+    if (c < ' ' || c > '~')
+        c = '?';
+    
+    for (int8_t i = 0; i < 5; i++) {
+        uint8_t line = font[(c - ' ') * 5 + i];
+        int8_t j = 0;
+        while (j < 8) {
+            if (!(line & (1 << j))) {
+                j++;
+                continue;
+            }
+            int8_t start = j;
+            while (j < 8 && (line & (1 << j))) {
+                j++;
+            }
+            fillRect(x + i * size, y + start * size, size, (j - start) * size, color);
+        }
+    }
+}
+
+// Draw a run of characters on one text row as a single window burst,
+// split only when the run does not fit the text buffer
+void Graphics::drawTextRun(int16_t x, int16_t y, const char* str, size_t len, uint16_t color, uint16_t bg, uint8_t size) {
+    if (len == 0 || size == 0) {
+        return;
+    }
+    
+    if (bg == color) {
+        for (size_t n = 0; n < len; n++) {
+            drawGlyphTransparent(x + n * 6 * size, y, str[n], color, size);
+        }
+        return;
+    }
+    
+    bool cached = _glyph_cache.isValid() && size <= _glyph_cache.maxSize();
+    
+    // A single cached glyph is sent straight from the cache
+    if (cached && len == 1) {
+        const uint16_t* cell = cachedGlyph(str[0], color, bg, size);
+        if (cell) {
+            drawImage(x, y, 6 * size, 8 * size, cell);
+        }
+        return;
+    }
+    
+    const size_t glyph_pixels = (size_t)48 * size * size;
+    size_t per_chunk = TEXT_BUFFER_PIXELS / glyph_pixels;
+    if (per_chunk == 0) {
+        per_chunk = 1;
+    }
+    uint16_t* buf = textBuffer(per_chunk < len ? per_chunk * glyph_pixels : len * glyph_pixels);
+    if (!buf) {
+        return;
+    }
+    
+    while (len > 0) {
+        size_t count = len < per_chunk ? len : per_chunk;
+        size_t stride = count * 6 * size;
+        for (size_t n = 0; n < count; n++) {
+            const uint16_t* cell = cached ? cachedGlyph(str[n], color, bg, size) : nullptr;
+            if (cell) {
+                // Copy the cached cell row by row into its place in the run
+                for (uint8_t row = 0; row < 8 * size; row++) {
+                    memcpy(buf + row * stride + n * 6 * size, cell + row * 6 * size, 6 * size * sizeof(uint16_t));
                 }
+            } else {
+                renderGlyph(buf + n * 6 * size, stride, str[n], color, bg, size);
             }
-            line >>= 1;
         }
+        drawImage(x, y, stride, 8 * size, buf);
+        
+        x += stride;
+        str += count;
+        len -= count;
     }
 }
 
+// Draw character
+void Graphics::drawChar(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
+    if ((x >= _lcd->hal().getConfig().width) ||   // Beyond right boundary
+        (y >= _lcd->hal().getConfig().height) ||  // Beyond bottom boundary
+        ((x + 6 * size - 1) < 0) || // Beyond left boundary
+        ((y + 8 * size - 1) < 0))   // Beyond top boundary
+        return;
+    
+    // Whole cell rasterized and sent as one window
+    drawTextRun(x, y, &c, 1, color, bg, size);
+}
+
 // Draw string
 void Graphics::drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) {
     int16_t cursor_x = x;
     int16_t cursor_y = y;
     
+    // Characters on the same text row are collected and sent together
+    const char* run = str;
+    int16_t run_x = cursor_x;
+    int16_t run_y = cursor_y;
+    
     while (*str) {
         // Process line break
         if (*str == '\n') {
+            drawTextRun(run_x, run_y, run, str - run, color, bg, size);
             cursor_x = x;
             cursor_y += 8 * size;
+            run = str + 1;
         } 
         // Process carriage return
         else if (*str == '\r') {
+            drawTextRun(run_x, run_y, run, str - run, color, bg, size);
             cursor_x = x;
+            run = str + 1;
         } 
         else {
-            drawChar(cursor_x, cursor_y, *str, color, bg, size);
             cursor_x += 6 * size;
             
             // If about to exceed right boundary, auto line break
             if (cursor_x > (_lcd->hal().getConfig().width - 6 * size)) {
+                drawTextRun(run_x, run_y, run, str + 1 - run, color, bg, size);
                 cursor_x = x;
                 cursor_y += 8 * size;
+                run = str + 1;
             }
         }
         str++;
+        if (run == str) {
+            run_x = cursor_x;
+            run_y = cursor_y;
+        }
     }
+    drawTextRun(run_x, run_y, run, str - run, color, bg, size);
 }
 
-// Draw image
-void Graphics::drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data) {
-    // Boundary check
-    if (x >= _lcd->hal().getConfig().width || y >= _lcd->hal().getConfig().height)
-        return;
+// Glyph index for a codepoint, unknown characters fall back to '?'
+static uint32_t glyphIndex(const AAFont& font, uint32_t codepoint) {
+    int32_t index = findGlyph(font, codepoint);
+    if (index < 0) {
+        index = findGlyph(font, '?');
+    }
+    return index < 0 ? 0 : index;
+}
+
+// Coverage data of a glyph, from memory or through the font cache
+const uint8_t* Graphics::glyphCoverage(const AAFont& font, uint32_t index) {
+    if (font.bitmap) {
+        return font.bitmap + font.glyphs[index].offset;
+    }
+    if (!_font_cache.isValid() && !_font_cache.begin()) {
+        return nullptr;
+    }
+    return _font_cache.load(font, index);
+}
+
+// 16-entry table of color blended over bg, rebuilt only when the colors change
+const uint16_t* Graphics::blendLut(uint16_t color, uint16_t bg) {
+    if (_lut_valid && color == _lut_color && bg == _lut_bg) {
+        return _blend_lut;
+    }
     
-    // Clip coordinates
-    int16_t x1 = x + w - 1;
-    int16_t y1 = y + h - 1;
+    int16_t fr = color >> 11, fg = (color >> 5) & 0x3F, fb = color & 0x1F;
+    int16_t br = bg >> 11, bgg = (bg >> 5) & 0x3F, bb = bg & 0x1F;
+    for (int16_t i = 0; i < 16; i++) {
+        // Rounded linear blend per channel, level 15 is full coverage
+        int16_t r = br + ((fr - br) * i + (fr >= br ? 7 : -7)) / 15;
+        int16_t g = bgg + ((fg - bgg) * i + (fg >= bgg ? 7 : -7)) / 15;
+        int16_t b = bb + ((fb - bb) * i + (fb >= bb ? 7 : -7)) / 15;
+        _blend_lut[i] = (r << 11) | (g << 5) | b;
+    }
+    
+    _lut_color = color;
+    _lut_bg = bg;
+    _lut_valid = true;
+    return _blend_lut;
+}
+
+// Draw a run of anti-aliased glyphs on one line as a single window burst
+void Graphics::drawAARun(int16_t x, int16_t y, const char* str, size_t len, const AAFont& font, uint16_t color, uint16_t bg) {
+    // 2 bpp levels spread over the 16-entry table
+    static const uint8_t level2[4] = { 0, 5, 10, 15 };
+    const char* end = str + len;
     
-    if (x < 0) {
-        x = 0;
+    while (str < end) {
+        // As many glyphs as fit the text buffer, at least one
+        int16_t height = font.line_height;
+        int16_t width = 0;
+        const char* chunk_end = str;
+        while (chunk_end < end) {
+            const char* next = chunk_end;
+            int16_t advance = font.glyphs[glyphIndex(font, decodeUtf8(next))].advance;
+            if (chunk_end > str && (size_t)(width + advance) * height > TEXT_BUFFER_PIXELS) {
+                break;
+            }
+            width += advance;
+            chunk_end = next;
+        }
+        
+        uint16_t* buf = (width > 0) ? textBuffer((size_t)width * height) : nullptr;
+        if (!buf) {
+            return;
+        }
+        
+        bool transparent = (bg == color);
+        const uint16_t* lut = blendLut(color, bg);
+        if (!transparent) {
+            for (size_t i = 0; i < (size_t)width * height; i++) {
+                buf[i] = bg;
+            }
+        }
+        
+        int16_t pen = 0;
+        while (str < chunk_end) {
+            uint32_t index = glyphIndex(font, decodeUtf8(str));
+            const AAGlyph* g = &font.glyphs[index];
+            const uint8_t* src = glyphCoverage(font, index);
+            int16_t gx = pen + g->x_offset;
+            int16_t gy = font.ascent + g->y_offset;
+            pen += g->advance;
+            if (!src) {
+                continue;
+            }
+            
+            uint32_t i = 0;  // Pixel index inside the glyph
+            for (int16_t row = 0; row < g->height; row++) {
+                int16_t py = gy + row;
+                int16_t run_start = 0;
+                bool in_run = false;
+                for (int16_t col = 0; col < g->width; col++, i++) {
+                    uint8_t level;
+                    if (font.bpp == 4) {
+                        uint8_t byte = src[i >> 1];
+                        level = (i & 1) ? byte & 0x0F : byte >> 4;
+                    } else {
+                        uint8_t byte = src[i >> 2];
+                        level = level2[(byte >> (6 - ((i & 3) << 1))) & 0x03];
+                    }
+                    
+                    int16_t px = gx + col;
+                    if (transparent) {
+                        // No known background, solid part as horizontal runs
+                        bool solid = level >= 8;
+                        if (solid && !in_run) {
+                            run_start = px;
+                            in_run = true;
+                        }
+                        if (in_run && (!solid || col == g->width - 1)) {
+                            // Kept inside the run box like the opaque path
+                            int16_t run_end = solid ? px : px - 1;
+                            run_start = std::max<int16_t>(run_start, 0);
+                            run_end = std::min<int16_t>(run_end, width - 1);
+                            if (py >= 0 && py < height && run_end >= run_start) {
+                                drawFastHLine(x + run_start, y + py, run_end - run_start + 1, color);
+                            }
+                            in_run = false;
+                        }
+                        continue;
+                    }
+                    if (level == 0 || px < 0 || px >= width || py < 0 || py >= height) {
+                        continue;
+                    }
+                    buf[py * width + px] = lut[level];
+                }
+            }
+        }
+        
+        if (!transparent) {
+            drawImage(x, y, width, height, buf);
+        }
+        
+        x += width;
     }
-    if (y < 0) {
-        y = 0;
+}
+
+// Draw anti-aliased string
+void Graphics::drawString(int16_t x, int16_t y, const char* str, const AAFont& font, uint16_t color, uint16_t bg) {
+    int16_t cursor_x = x;
+    int16_t cursor_y = y;
+    int16_t screen_width = _lcd->hal().getConfig().width;
+    
+    // Same run collection as the fixed font, wrapping on the glyph advance
+    const char* run = str;
+    int16_t run_x = cursor_x;
+    int16_t run_y = cursor_y;
+    
+    while (*str) {
+        const char* next = str;
+        uint32_t cp = decodeUtf8(next);
+        if (cp == '\n' || cp == '\r') {
+            drawAARun(run_x, run_y, run, str - run, font, color, bg);
+            cursor_x = x;
+            if (cp == '\n') {
+                cursor_y += font.line_height;
+            }
+            run = next;
+        } else {
+            int16_t advance = font.glyphs[glyphIndex(font, cp)].advance;
+            if (cursor_x + advance > screen_width && cursor_x > x) {
+                drawAARun(run_x, run_y, run, str - run, font, color, bg);
+                cursor_x = x;
+                cursor_y += font.line_height;
+                run = str;
+                run_x = cursor_x;
+                run_y = cursor_y;
+            }
+            cursor_x += advance;
+        }
+        str = next;
+        if (run == str) {
+            run_x = cursor_x;
+            run_y = cursor_y;
+        }
     }
-    if (x1 >= _lcd->hal().getConfig().width) {
-        x1 = _lcd->hal().getConfig().width - 1;
+    drawAARun(run_x, run_y, run, str - run, font, color, bg);
+}
+
+// Width of the widest line in pixels
+int16_t Graphics::textWidth(const char* str, const AAFont& font) const {
+    int16_t width = 0;
+    int16_t line = 0;
+    while (*str) {
+        uint32_t cp = decodeUtf8(str);
+        if (cp == '\n' || cp == '\r') {
+            line = 0;
+            continue;
+        }
+        line += font.glyphs[glyphIndex(font, cp)].advance;
+        if (line > width) {
+            width = line;
+        }
     }
-    if (y1 >= _lcd->hal().getConfig().height) {
-        y1 = _lcd->hal().getConfig().height - 1;
+    return width;
+}
+
+// Area covered by a fixed-font string, following the drawString() layout
+Rect Graphics::textBounds(int16_t x, int16_t y, const char* str, uint8_t size) const {
+    int16_t screen_width = _lcd->hal().getConfig().width;
+    int16_t cursor_x = x;
+    int16_t cursor_y = y;
+    int16_t right = x;
+    int16_t bottom = y;
+    
+    while (*str) {
+        if (*str == '\n') {
+            cursor_x = x;
+            cursor_y += 8 * size;
+        } else if (*str == '\r') {
+            cursor_x = x;
+        } else {
+            cursor_x += 6 * size;
+            right = std::max(right, cursor_x);
+            bottom = std::max<int16_t>(bottom, cursor_y + 8 * size);
+            if (cursor_x > screen_width - 6 * size) {
+                cursor_x = x;
+                cursor_y += 8 * size;
+            }
+        }
+        str++;
     }
+    return Rect(x, y, right - x, bottom - y);
+}
+
+// Area covered by an anti-aliased string, one line_height per line
+Rect Graphics::textBounds(int16_t x, int16_t y, const char* str, const AAFont& font) const {
+    int16_t screen_width = _lcd->hal().getConfig().width;
+    int16_t cursor_x = x;
+    int16_t cursor_y = y;
+    int16_t right = x;
+    int16_t bottom = y;
     
-    w = x1 - x + 1;
-    h = y1 - y + 1;
+    while (*str) {
+        uint32_t cp = decodeUtf8(str);
+        if (cp == '\n' || cp == '\r') {
+            cursor_x = x;
+            if (cp == '\n') {
+                cursor_y += font.line_height;
+            }
+            continue;
+        }
+        int16_t advance = font.glyphs[glyphIndex(font, cp)].advance;
+        if (cursor_x + advance > screen_width && cursor_x > x) {
+            cursor_x = x;
+            cursor_y += font.line_height;
+        }
+        cursor_x += advance;
+        right = std::max(right, cursor_x);
+        bottom = std::max<int16_t>(bottom, cursor_y + font.line_height);
+    }
+    return Rect(x, y, right - x, bottom - y);
+}
+
+// Draw image
+void Graphics::drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data, PixelOrder order) {
+    if (_fb) {
+        // Framebuffer clips against the source stride itself
+        _fb->writePixels(x, y, w, h, data, w, order);
+        return;
+    }
     
-    if (w <= 0 || h <= 0) {
+    // Clip coordinates
+    int16_t cx = x, cy = y, cw = w, ch = h;
+    if (!clipRect(cx, cy, cw, ch)) {
         return;
     }
     
-    // Set drawing window
-    _lcd->setAddrWindow(x, y, x1, y1);
+    // One window per span of memory rows, a single one unless scrolled
+    ST7789::ScrollSpan spans[4];
+    uint8_t count = _lcd->scrollSpans(cy, ch, spans);
+    _lcd->hal().beginTransaction();
+    for (uint8_t i = 0; i < count; i++) {
+        const ST7789::ScrollSpan& span = spans[i];
+        _lcd->setAddrWindow(cx, span.memory_y, cx + cw - 1, span.memory_y + span.rows - 1);
+        
+        // Send image data straight from the source, skipping clipped rows and columns
+        _lcd->hal().writePixels(data + (span.screen_y - y) * w + (cx - x), cw, span.rows, w, order);
+    }
+    _lcd->hal().endTransaction();
+}
+
+// Send a clipped cw x ch window at cx, cy pulled from a stream. A stream
+// that runs out early ends in black.
+void Graphics::drawStream(PixelStream& stream, int16_t cx, int16_t cy, int16_t cw, int16_t ch) {
+    if (_fb) {
+        // Read piece by piece into the framebuffer
+        const size_t batch_size = 64;
+        uint16_t buffer[batch_size];
+        for (int16_t j = 0; j < ch; j++) {
+            for (int16_t i = 0; i < cw; i += batch_size) {
+                int16_t n = (cw - i < (int16_t)batch_size) ? cw - i : batch_size;
+                size_t got = stream.read(buffer, n);
+                memset(buffer + got, 0, (n - got) * sizeof(uint16_t));
+                _fb->writePixels(cx + i, cy + j, n, 1, buffer, n);
+            }
+        }
+        return;
+    }
+    
+    // One window per span of memory rows, the stream runs on across them
+    // and fills each DMA chunk while the previous one is on the wire
+    ST7789::ScrollSpan spans[4];
+    uint8_t count = _lcd->scrollSpans(cy, ch, spans);
+    _lcd->hal().beginTransaction();
+    for (uint8_t i = 0; i < count; i++) {
+        const ST7789::ScrollSpan& span = spans[i];
+        _lcd->setAddrWindow(cx, span.memory_y, cx + cw - 1, span.memory_y + span.rows - 1);
+        _lcd->hal().writeStream(stream, cw, span.rows);
+    }
+    _lcd->hal().endTransaction();
+}
+
+bool Graphics::drawImageCompressed(int16_t x, int16_t y, const uint8_t* data, size_t size) {
+    ImageDecoder image;
+    if (!image.begin(data, size)) {
+        return false;
+    }
     
-    // Send image data
-    _lcd->hal().writeDataBulk((const uint8_t*)data, w * h * 2);
+    int16_t cx = x, cy = y, cw = image.width(), ch = image.height();
+    if (!clipRect(cx, cy, cw, ch)) {
+        return true;
+    }
+    image.setWindow(cx - x, cy - y, cw, ch);
+    drawStream(image, cx, cy, cw, ch);
+    return true;
+}
+
+bool Graphics::drawJpeg(int16_t x, int16_t y, const uint8_t* data, size_t size) {
+    JpegDecoder jpeg;
+    if (!jpeg.begin(data, size)) {
+        return false;
+    }
+    
+    int16_t cx = x, cy = y, cw = jpeg.width(), ch = jpeg.height();
+    if (!clipRect(cx, cy, cw, ch)) {
+        return true;
+    }
+    jpeg.setWindow(cx - x, cy - y, cw, ch);
+    drawStream(jpeg, cx, cy, cw, ch);
+    return !jpeg.hasError();
 }
 
 void Graphics::clearScreen(uint16_t width, uint16_t height, uint16_t color) {
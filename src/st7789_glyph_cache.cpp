@@ -0,0 +1,98 @@
+#include "st7789_glyph_cache.hpp"
+#include <cstdlib>
+#include <cstdio>
+
+namespace st7789 {
+
+GlyphCache::GlyphCache() :
+    _entries(nullptr),
+    _pixels(nullptr),
+    _count(0),
+    _max_size(0),
+    _tick(0),
+    _hits(0),
+    _misses(0) {
+}
+
+GlyphCache::~GlyphCache() {
+    end();
+}
+
+bool GlyphCache::begin(uint8_t entries, uint8_t max_size) {
+    if (entries == 0 || max_size == 0) {
+        return false;
+    }
+    end();
+
+    _max_size = max_size;
+    _entries = (Entry*)malloc(entries * sizeof(Entry));
+    _pixels = (uint16_t*)malloc(entries * cellPixels() * sizeof(uint16_t));
+    if (!_entries || !_pixels) {
+        printf("Failed to allocate glyph cache\n");
+        end();
+        return false;
+    }
+
+    _count = entries;
+    clear();
+    resetStats();
+    return true;
+}
+
+void GlyphCache::end() {
+    if (_entries) {
+        free(_entries);
+        _entries = nullptr;
+    }
+    if (_pixels) {
+        free(_pixels);
+        _pixels = nullptr;
+    }
+    _count = 0;
+    _max_size = 0;
+}
+
+void GlyphCache::clear() {
+    for (uint8_t i = 0; i < _count; i++) {
+        _entries[i].size = 0;
+        _entries[i].last_use = 0;
+    }
+    _tick = 0;
+}
+
+const uint16_t* GlyphCache::find(char c, uint16_t fg, uint16_t bg, uint8_t size) {
+    for (uint8_t i = 0; i < _count; i++) {
+        Entry& e = _entries[i];
+        if (e.size == size && e.c == c && e.fg == fg && e.bg == bg) {
+            e.last_use = ++_tick;
+            _hits++;
+            return _pixels + i * cellPixels();
+        }
+    }
+    _misses++;
+    return nullptr;
+}
+
+uint16_t* GlyphCache::insert(char c, uint16_t fg, uint16_t bg, uint8_t size) {
+    if (_count == 0 || size > _max_size) {
+        return nullptr;
+    }
+
+    // Unused slots have last_use 0 and go first
+    uint8_t victim = 0;
+    for (uint8_t i = 1; i < _count; i++) {
+        if (_entries[i].last_use < _entries[victim].last_use) {
+            victim = i;
+        }
+    }
+
+    Entry& e = _entries[victim];
+    e.c = c;
+    e.fg = fg;
+    e.bg = bg;
+    e.size = size;
+    e.last_use = ++_tick;
+    return _pixels + victim * cellPixels();
+}
+
+} // namespace st7789
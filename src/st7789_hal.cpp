@@ -1,7 +1,10 @@
 #include "st7789_hal.hpp"
+#include "st7789_pixels.hpp"
 #include "hardware/gpio.h"
 #include "hardware/dma.h"
 #include "hardware/irq.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/io_bank0.h"
 #include "pico/stdlib.h"
 #include <cstring>
 #include <cstdio>
@@ -30,7 +33,21 @@ HAL::HAL() :
     _dma_buffer(nullptr),
     _dma_buffer_size(0),
     _dma_enabled(false),
-    _dma_busy(false) {
+    _dma_busy(false),
+    _dma_pending(false),
+    _fill_color(0),
+    _spi_frame_bits(8),
+    _cs_active(false),
+    _transaction_depth(0),
+    _command_count(0),
+    _data_count(0),
+    _chain_blocks(nullptr),
+    _chain_capacity(0),
+    _dma_ctrl_channel(-1),
+    _dma_timer(-1),
+    _chain_sink(0),
+    _chain_active(false),
+    _align_pending(false) {
 }
 
 HAL::~HAL() {
@@ -89,6 +106,9 @@ void HAL::initDma() {
     
     // Allocate DMA buffer
     _dma_buffer_size = _config.dma.buffer_size;
+    if (_dma_buffer_size < 4) {
+        _dma_buffer_size = 4;  // Room for one pixel in each ping-pong half
+    }
     _dma_buffer = (uint16_t*)malloc(_dma_buffer_size);
     if (!_dma_buffer) {
         printf("Failed to allocate DMA buffer\n");
@@ -100,7 +120,8 @@ void HAL::initDma() {
     
     // Configure DMA
     dma_channel_config dma_config = dma_channel_get_default_config(_dma_tx_channel);
-    channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_16);
+    // Byte transfers: the SPI runs 8-bit frames and only shifts out the low byte of each write
+    channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_8);
     channel_config_set_dreq(&dma_config, spi_get_dreq(_config.spi_inst, true));
     
     // Set DMA
@@ -120,9 +141,97 @@ void HAL::initDma() {
     
     _dma_enabled = true;
     printf("DMA initialization successful, channel: %d\n", _dma_tx_channel);
+    
+    if (_config.dma.chain_blocks > 0) {
+        initChain();
+    }
+}
+
+// Control block, the four words land on the TX channel's first register alias
+struct HAL::ChainBlock {
+    const volatile void* read;
+    volatile void* write;
+    uint32_t count;
+    uint32_t ctrl;
+};
+
+void HAL::initChain() {
+    _dma_ctrl_channel = dma_claim_unused_channel(false);
+    _dma_timer = dma_claim_unused_timer(false);
+    _chain_blocks = (ChainBlock*)malloc(sizeof(ChainBlock) * _config.dma.chain_blocks);
+    if (_dma_ctrl_channel < 0 || _dma_timer < 0 || !_chain_blocks) {
+        printf("Failed to set up DMA chains, regions are sent one by one\n");
+        cleanupChain();
+        return;
+    }
+    _chain_capacity = _config.dma.chain_blocks;
+    
+    // One timer tick outlasts a 16-bit frame at the configured baud rate
+    uint32_t baud = spi_get_baudrate(_config.spi_inst);
+    uint32_t cycles = (uint32_t)(((uint64_t)clock_get_hz(clk_sys) * 16 + baud - 1) / baud);
+    if (cycles > 0xFFFF) {
+        cycles = 0xFFFF;
+    }
+    dma_timer_set_fraction(_dma_timer, 1, cycles);
+    
+    // Every block hands over to the control channel without an interrupt
+    dma_channel_config c = dma_channel_get_default_config(_dma_tx_channel);
+    channel_config_set_chain_to(&c, _dma_ctrl_channel);
+    channel_config_set_irq_quiet(&c, true);
+    channel_config_set_dreq(&c, spi_get_dreq(_config.spi_inst, true));
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    _chain_ctrl[CTRL_TX8] = channel_config_get_ctrl_value(&c);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    _chain_ctrl[CTRL_TX16] = channel_config_get_ctrl_value(&c);
+    
+    // Register writes run unpaced
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_dreq(&c, DREQ_FORCE);
+    _chain_ctrl[CTRL_WORD] = channel_config_get_ctrl_value(&c);
+    channel_config_set_write_increment(&c, true);
+    _chain_ctrl[CTRL_PAIR] = channel_config_get_ctrl_value(&c);
+    
+    // Dummy words at the timer's pace while the SPI FIFO empties
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, dma_get_timer_dreq(_dma_timer));
+    _chain_ctrl[CTRL_DELAY] = channel_config_get_ctrl_value(&c);
+    
+    // Control channel copies one block per trigger, the write ring wraps
+    // back onto READ_ADDR after the CTRL_TRIG write starts the TX channel
+    dma_channel_config ctrl = dma_channel_get_default_config(_dma_ctrl_channel);
+    channel_config_set_transfer_data_size(&ctrl, DMA_SIZE_32);
+    channel_config_set_read_increment(&ctrl, true);
+    channel_config_set_write_increment(&ctrl, true);
+    channel_config_set_ring(&ctrl, true, 4);
+    dma_channel_configure(
+        _dma_ctrl_channel,
+        &ctrl,
+        &dma_hw->ch[_dma_tx_channel].read_addr,
+        _chain_blocks,
+        4,
+        false
+    );
+}
+
+void HAL::cleanupChain() {
+    if (_dma_ctrl_channel >= 0) {
+        dma_channel_abort(_dma_ctrl_channel);
+        dma_channel_unclaim(_dma_ctrl_channel);
+        _dma_ctrl_channel = -1;
+    }
+    if (_dma_timer >= 0) {
+        dma_timer_unclaim(_dma_timer);
+        _dma_timer = -1;
+    }
+    free(_chain_blocks);
+    _chain_blocks = nullptr;
+    _chain_capacity = 0;
 }
 
 void HAL::cleanupDma() {
+    cleanupChain();
+    
     if (_dma_tx_channel >= 0) {
         // Stop any ongoing transfer
         dma_channel_abort(_dma_tx_channel);
@@ -145,34 +254,115 @@ void HAL::cleanupDma() {
     _dma_busy = false;
 }
 
+void HAL::setDmaIrqEnabled(bool enabled) {
+    // NVIC enables are per core, the handler follows the core driving the bus
+    if (_dma_enabled) {
+        irq_set_enabled(DMA_IRQ_0, enabled);
+    }
+}
+
+void HAL::select() {
+    if (!_cs_active) {
+        gpio_put(_config.pin_cs, 0);
+        _cs_active = true;
+    }
+}
+
+void HAL::deselect() {
+    // A transaction keeps the chip selected until endTransaction()
+    if (_cs_active && _transaction_depth == 0) {
+        gpio_put(_config.pin_cs, 1);
+        _cs_active = false;
+    }
+}
+
+void HAL::beginTransaction() {
+    if (_transaction_depth++ == 0) {
+        select();
+    }
+}
+
+void HAL::endTransaction() {
+    if (_transaction_depth == 0) return;
+    
+    // An async transfer still on the wire releases CS from waitDmaIdle()
+    if (--_transaction_depth == 0 && !_dma_pending) {
+        deselect();
+    }
+}
+
 void HAL::writeCommand(uint8_t cmd) {
-    gpio_put(_config.pin_cs, 0);  // Selected chip
-    gpio_put(_config.pin_dc, 0);  // Command mode
+    writeCommand(cmd, nullptr, 0);
+}
+
+void HAL::writeCommand(uint8_t cmd, const uint8_t* params, size_t len) {
+    if (_dma_pending) waitDmaIdle();
+    _command_count++;
+    _data_count = len;
+    
+    select();                      // Selected chip
+    gpio_put(_config.pin_dc, 0);   // Command mode
     spi_write_blocking(_config.spi_inst, &cmd, 1);
-    gpio_put(_config.pin_cs, 1);  // Unselected
+    
+    // Parameters go out in one burst, spi_write_blocking returns once the
+    // command byte has shifted out so DC can change
+    if (len > 0) {
+        gpio_put(_config.pin_dc, 1);  // Data mode
+        spi_write_blocking(_config.spi_inst, params, len);
+    }
+    deselect();                    // Unselected
 }
 
 void HAL::writeData(uint8_t data) {
-    gpio_put(_config.pin_cs, 0);  // Selected chip
-    gpio_put(_config.pin_dc, 1);  // Data mode
-    spi_write_blocking(_config.spi_inst, &data, 1);
-    gpio_put(_config.pin_cs, 1);  // Unselected
+    writeDataBulk(&data, 1);
 }
 
 void HAL::writeDataBulk(const uint8_t* data, size_t len) {
     if (len == 0) return;
+    if (_dma_pending) waitDmaIdle();
+    _data_count += len;
     
-    gpio_put(_config.pin_cs, 0);  // Selected chip
-    gpio_put(_config.pin_dc, 1);  // Data mode
+    select();                      // Selected chip
+    gpio_put(_config.pin_dc, 1);   // Data mode
     spi_write_blocking(_config.spi_inst, data, len);
-    gpio_put(_config.pin_cs, 1);  // Unselected
+    deselect();                    // Unselected
 }
 
-bool HAL::writeDataDma(const uint16_t* data, size_t len) {
+// Pixels are converted to the bus format in the DMA buffer, one ping-pong
+// half is packed while the other is on the wire
+bool HAL::writeConverted(const PixelSource& src) {
+    size_t width = src.width;
+    size_t height = src.height;
+    bool rgb444 = (_config.color_mode == COLOR_RGB444);
+    bool odd = rgb444 && ((width * height) & 1);
+    _data_count += pixelBytes(width * height);
+    
+    // RGB444 words go out as 12-bit frames, the SPI packs two in three bytes
+    setFrameSize(rgb444 ? 12 : 8);
+    size_t row = 0;
+    size_t col = 0;
+    
     if (!_dma_enabled || !_dma_buffer || _dma_tx_channel < 0) {
-        // If DMA is not available, fall back to normal method
-        writeDataBulk((const uint8_t*)data, len * 2);
-        return false;
+        // If DMA is not available, fall back to blocking writes
+        const size_t batch_size = 64;
+        uint16_t buffer[batch_size];
+        
+        select();
+        gpio_put(_config.pin_dc, 1);
+        while (row < height) {
+            size_t n = packPixels(buffer, batch_size, src, rgb444, row, col);
+            if (rgb444) {
+                spi_write16_blocking(_config.spi_inst, buffer, n);
+            } else {
+                spi_write_blocking(_config.spi_inst, (const uint8_t*)buffer, n * 2);
+            }
+        }
+        if (odd) {
+            alignFrames();
+        }
+        deselect();
+        setFrameSize(8);
+        return true;
     }
     
     // If DMA is busy, wait for completion
@@ -180,6 +370,7 @@ bool HAL::writeDataDma(const uint16_t* data, size_t len) {
         if (!waitForDmaComplete()) {
             printf("DMA timeout, abort operation\n");
             abortDma();
+            setFrameSize(8);
             return false;
         }
     }
@@ -187,48 +378,396 @@ bool HAL::writeDataDma(const uint16_t* data, size_t len) {
     // Set data/command pin to data mode
     gpio_put(_config.pin_dc, 1);
     // Set chip select pin
-    gpio_put(_config.pin_cs, 0);
+    select();
     
-    // Handle large transfers
-    size_t remaining = len;
-    const uint16_t* src_ptr = data;
+    // Ping-pong halves: chunk N+1 is packed while chunk N is on the wire
+    const size_t chunk_pixels = _dma_buffer_size / 4;
+    uint16_t* chunks[2] = { _dma_buffer, _dma_buffer + chunk_pixels };
+    int current = 0;
     
-    while (remaining > 0) {
-        // Determine transfer size
-        size_t transfer_size = (remaining > _dma_buffer_size/2) ? _dma_buffer_size/2 : remaining;
+    while (row < height) {
+        size_t count = packPixels(chunks[current], chunk_pixels, src, rgb444, row, col);
         
-        // Prepare data (swap bytes for RGB565 format)
-        for (size_t i = 0; i < transfer_size; i++) {
-            uint16_t color = src_ptr[i];
-            // Swap bytes for RGB565 format
-            _dma_buffer[i] = ((color & 0xFF) << 8) | (color >> 8);
+        // Kick this chunk as soon as the previous one is done, the SPI FIFO
+        // covers the few cycles in between
+        if (_dma_busy && !waitForDmaComplete()) {
+            printf("DMA transfer timeout\n");
+            abortDma();
+            deselect(); // Release chip select
+            setFrameSize(8);
+            return false;
         }
         
         // Mark DMA busy
         _dma_busy = true;
         
         // Configure and start DMA transfer
-        dma_channel_set_read_addr(_dma_tx_channel, _dma_buffer, false);
-        dma_channel_set_trans_count(_dma_tx_channel, transfer_size, true); // Start transfer
+        dma_channel_set_read_addr(_dma_tx_channel, chunks[current], false);
+        dma_channel_set_trans_count(_dma_tx_channel, rgb444 ? count : count * 2, true); // Start transfer
         
-        // Wait for transfer to complete
-        if (!waitForDmaComplete()) {
-            printf("DMA transfer timeout\n");
-            abortDma();
-            gpio_put(_config.pin_cs, 1); // Release chip select
-            return false;
+        current ^= 1;
+    }
+    
+    // Wait for the last chunk
+    if (!waitForDmaComplete()) {
+        printf("DMA transfer timeout\n");
+        abortDma();
+        deselect(); // Release chip select
+        setFrameSize(8);
+        return false;
+    }
+    
+    // DMA completes when the FIFO is fed, wait for the last bytes to shift out
+    while (spi_is_busy(_config.spi_inst)) {
+        tight_loop_contents();
+    }
+    if (odd) {
+        alignFrames();
+    }
+    
+    // Release chip select
+    deselect();
+    setFrameSize(8);
+    return true;
+}
+
+bool HAL::writePixels(const uint16_t* data, size_t width, size_t height, size_t stride, PixelOrder order) {
+    if (width == 0 || height == 0) return true;
+    if (_dma_pending) waitDmaIdle();
+    
+    // Only sources already in the bus format are sent in place
+    bool rgb444 = (_config.color_mode == COLOR_RGB444);
+    if (rgb444 != (order == PIXEL_RGB444)) {
+        PixelSource src = { data, width, height, stride, order, nullptr, 0, 0, nullptr };
+        return writeConverted(src);
+    }
+    _data_count += pixelBytes(width * height);
+    
+    // 16-bit frames shift native values out high byte first, no swap needed.
+    // 12-bit frames take the low bits of each RGB444 word.
+    bool words = (order != PIXEL_PANEL);
+    setFrameSize(rgb444 ? 12 : (words ? 16 : 8));
+    
+    // One run for a contiguous source, otherwise one per row
+    size_t run = (stride == width) ? width * height : width;
+    size_t runs = (stride == width) ? 1 : height;
+    bool use_dma = _dma_enabled && _dma_tx_channel >= 0;
+    bool ok = true;
+    
+    gpio_put(_config.pin_dc, 1);
+    select();
+    
+    for (size_t i = 0; i < runs && ok; i++) {
+        const uint16_t* src = data + i * stride;
+        if (use_dma) {
+            _dma_busy = true;
+            dma_channel_set_read_addr(_dma_tx_channel, src, false);
+            dma_channel_set_trans_count(_dma_tx_channel, words ? run : run * 2, true);
+            if (!waitForDmaComplete()) {
+                printf("DMA transfer timeout\n");
+                abortDma();
+                ok = false;
+            }
+        } else if (words) {
+            spi_write16_blocking(_config.spi_inst, src, run);
+        } else {
+            spi_write_blocking(_config.spi_inst, (const uint8_t*)src, run * 2);
+        }
+    }
+    
+    // Wait for the last frames to shift out before releasing CS
+    while (spi_is_busy(_config.spi_inst)) {
+        tight_loop_contents();
+    }
+    if (ok && rgb444 && ((width * height) & 1)) {
+        alignFrames();
+    }
+    deselect();
+    
+    setFrameSize(8);
+    return ok;
+}
+
+bool HAL::writePixelsAsync(const uint16_t* data, size_t len, PixelOrder order) {
+    if (len == 0) return true;
+    if (_dma_pending) waitDmaIdle();
+    
+    bool rgb444 = (_config.color_mode == COLOR_RGB444);
+    if (!_dma_enabled || _dma_tx_channel < 0 || rgb444 != (order == PIXEL_RGB444)) {
+        // If DMA is not available or the pixels need converting, fall back
+        // to a blocking write
+        return writePixels(data, len, 1, len, order);
+    }
+    
+    _data_count += pixelBytes(len);
+    bool words = (order != PIXEL_PANEL);
+    setFrameSize(rgb444 ? 12 : (words ? 16 : 8));
+    
+    gpio_put(_config.pin_dc, 1);
+    select();
+    
+    // Stream straight from the caller's memory, CS stays low until waitDmaIdle()
+    _dma_busy = true;
+    _dma_pending = true;
+    _align_pending = rgb444 && (len & 1);
+    dma_channel_set_read_addr(_dma_tx_channel, data, false);
+    dma_channel_set_trans_count(_dma_tx_channel, words ? len : len * 2, true);
+    return true;
+}
+
+bool HAL::fillPixelsAsync(uint16_t color, size_t count) {
+    if (count == 0) return true;
+    if (_dma_pending) waitDmaIdle();
+    _data_count += pixelBytes(count);
+    
+    // One frame per pixel, 12 bits wide in RGB444 mode
+    bool rgb444 = (_config.color_mode == COLOR_RGB444);
+    bool odd = rgb444 && (count & 1);
+    uint16_t word = rgb444 ? rgb565To444(color) : color;
+    setFrameSize(rgb444 ? 12 : 16);
+    
+    if (!_dma_enabled || _dma_tx_channel < 0) {
+        // If DMA is not available, fall back to blocking writes
+        const size_t batch_size = 64;
+        uint16_t buffer[batch_size];
+        for (size_t i = 0; i < batch_size; i++) {
+            buffer[i] = word;
         }
         
-        // Update pointer and remaining
-        src_ptr += transfer_size;
-        remaining -= transfer_size;
+        gpio_put(_config.pin_dc, 1);
+        select();
+        while (count > 0) {
+            size_t n = (count > batch_size) ? batch_size : count;
+            spi_write16_blocking(_config.spi_inst, buffer, n);
+            count -= n;
+        }
+        if (odd) {
+            alignFrames();
+        }
+        deselect();
+        
+        setFrameSize(8);
+        return true;
     }
     
-    // Release chip select
-    gpio_put(_config.pin_cs, 1);
+    // Same word over and over: the read address stays put. waitDmaIdle()
+    // restores the incrementing configuration.
+    configureDma(_spi_frame_bits, false);
+    _fill_color = word;
+    
+    gpio_put(_config.pin_dc, 1);
+    select();
+    
+    _dma_busy = true;
+    _dma_pending = true;
+    _align_pending = odd;
+    dma_channel_set_read_addr(_dma_tx_channel, &_fill_color, false);
+    dma_channel_set_trans_count(_dma_tx_channel, count, true);
+    return true;
+}
+
+// An odd number of 12-bit frames stops half way into a byte. One 4-bit
+// frame completes it; the panel drops the unfinished pixel.
+void HAL::alignFrames() {
+    static const uint16_t pad = 0;
+    setFrameSize(4);
+    spi_write16_blocking(_config.spi_inst, &pad, 1);
+}
+
+size_t HAL::buildChain(const BusSegment* segments, size_t count, ChainBlock* out) {
+    spi_hw_t* spi = spi_get_hw(_config.spi_inst);
+    volatile void* dc_ctrl = &io_bank0_hw->io[_config.pin_dc].ctrl;
+    size_t n = 0;
+    uint8_t bits = 8;           // State of the bus when the chain starts
+    bool command = false;
+    size_t queued = 0;          // Frames that may still be in the SPI FIFO
+    
+    // With out == nullptr the blocks are only counted
+    auto emit = [&](const volatile void* read, volatile void* write, uint32_t transfers, uint32_t ctrl) {
+        if (out) {
+            out[n].read = read;
+            out[n].write = write;
+            out[n].count = transfers;
+            out[n].ctrl = ctrl;
+        }
+        n++;
+    };
+    
+    // DC and the frame format may only change once the SPI is idle. DMA
+    // completion only means the FIFO was fed, so wait out a full FIFO plus
+    // the shift register and timer phase.
+    auto drain = [&]() {
+        if (queued > 0) {
+            uint32_t ticks = (queued > 8 ? 8 : queued) + 2;
+            emit(&_chain_words[WORD_ZERO], &_chain_sink, ticks, _chain_ctrl[CTRL_DELAY]);
+            queued = 0;
+        }
+    };
+    
+    // Same sequence as spi_set_format(): disable, write CR0, enable
+    auto setBits = [&](uint8_t to) {
+        if (bits == to) return;
+        drain();
+        emit(&_chain_words[WORD_CR1_OFF], &spi->cr1, 1, _chain_ctrl[CTRL_WORD]);
+        emit(&_chain_words[to == 16 ? WORD_CR0_16 : WORD_CR0_8], &spi->cr0, 2, _chain_ctrl[CTRL_PAIR]);
+        bits = to;
+    };
+    
+    // DC is driven through the pad output override, the DMA cannot reach SIO
+    auto setCommand = [&](bool to) {
+        if (command == to) return;
+        drain();
+        emit(&_chain_words[to ? WORD_DC_COMMAND : WORD_DC_DATA], dc_ctrl, 1, _chain_ctrl[CTRL_WORD]);
+        command = to;
+    };
+    
+    for (size_t i = 0; i < count; i++) {
+        const BusSegment& seg = segments[i];
+        if (seg.width == 0) continue;
+        
+        if (seg.kind == BusSegment::PIXELS) {
+            if (seg.height == 0) continue;
+            setCommand(false);
+            setBits(16);
+            
+            // One block for a contiguous source, otherwise one per row
+            const uint16_t* src = (const uint16_t*)seg.data;
+            if (seg.stride == seg.width) {
+                emit(src, &spi->dr, (uint32_t)seg.width * seg.height, _chain_ctrl[CTRL_TX16]);
+            } else {
+                for (uint16_t row = 0; row < seg.height; row++) {
+                    emit(src + (size_t)row * seg.stride, &spi->dr, seg.width, _chain_ctrl[CTRL_TX16]);
+                }
+            }
+            queued = (size_t)seg.width * seg.height;
+        } else {
+            setCommand(seg.kind == BusSegment::COMMAND);
+            setBits(8);
+            emit(seg.data, &spi->dr, seg.width, _chain_ctrl[CTRL_TX8]);
+            queued = seg.width;
+        }
+    }
+    
+    // Hand the bus back in its idle state
+    setBits(8);
+    setCommand(false);
+    
+    // Only the last block raises the completion interrupt and ends the chain
+    if (out && n > 0) {
+        uint32_t& ctrl = out[n - 1].ctrl;
+        ctrl &= ~(DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS | DMA_CH0_CTRL_TRIG_IRQ_QUIET_BITS);
+        ctrl |= (uint32_t)_dma_tx_channel << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB;
+    }
+    return n;
+}
+
+bool HAL::writeChainAsync(const BusSegment* segments, size_t count) {
+    if (count == 0) return true;
+    if (_dma_pending) waitDmaIdle();
+    
+    // Chained pixels go out as they are, RGB444 mode needs them converted
+    bool chain = _chain_blocks && _config.color_mode == COLOR_RGB565;
+    size_t blocks = chain ? buildChain(segments, count, nullptr) : 0;
+    if (blocks == 0 || blocks > _chain_capacity) {
+        // No chain resources or too many blocks, send piece by piece
+        return writeSegments(segments, count);
+    }
+    
+    // Register values the chain writes, taken while the SPI is idle
+    setFrameSize(8);
+    spi_hw_t* spi = spi_get_hw(_config.spi_inst);
+    uint32_t cr0 = spi->cr0 & ~SPI_SSPCR0_DSS_BITS;
+    uint32_t cr1 = spi->cr1 | SPI_SSPCR1_SSE_BITS;
+    uint32_t dc = io_bank0_hw->io[_config.pin_dc].ctrl & ~IO_BANK0_GPIO0_CTRL_OUTOVER_BITS;
+    _chain_words[WORD_ZERO] = 0;
+    _chain_words[WORD_DC_DATA] = dc;
+    _chain_words[WORD_DC_COMMAND] = dc | (IO_BANK0_GPIO0_CTRL_OUTOVER_VALUE_LOW << IO_BANK0_GPIO0_CTRL_OUTOVER_LSB);
+    _chain_words[WORD_CR1_OFF] = cr1 & ~SPI_SSPCR1_SSE_BITS;
+    _chain_words[WORD_CR0_8] = cr0 | (8 - 1);
+    _chain_words[WORD_CR1_ON_8] = cr1;
+    _chain_words[WORD_CR0_16] = cr0 | (16 - 1);
+    _chain_words[WORD_CR1_ON_16] = cr1;
+    buildChain(segments, count, _chain_blocks);
+    
+    // Bus history as if the segments had been sent one by one
+    for (size_t i = 0; i < count; i++) {
+        const BusSegment& seg = segments[i];
+        if (seg.kind == BusSegment::COMMAND) {
+            _command_count += seg.width;
+            _data_count = 0;
+        } else if (seg.kind == BusSegment::DATA) {
+            _data_count += seg.width;
+        } else {
+            _data_count += (size_t)seg.width * seg.height * 2;
+        }
+    }
+    
+    // DC idles high for data, commands pull it low through the override
+    gpio_put(_config.pin_dc, 1);
+    select();
+    
+    _chain_active = true;
+    _dma_busy = true;
+    _dma_pending = true;
+    dma_channel_set_read_addr(_dma_ctrl_channel, _chain_blocks, true);
     return true;
 }
 
+bool HAL::waitDmaIdle() {
+    if (!_dma_pending) return true;
+    
+    bool ok = waitForDmaComplete();
+    if (!ok) {
+        printf("DMA transfer timeout\n");
+        abortDma();
+    }
+    
+    // Wait for the last bytes to shift out before releasing CS
+    while (spi_is_busy(_config.spi_inst)) {
+        tight_loop_contents();
+    }
+    if (_align_pending) {
+        alignFrames();
+        _align_pending = false;
+    }
+    deselect();
+    
+    // The chain left the TX channel with its last block's configuration
+    if (_chain_active) {
+        configureDma(_spi_frame_bits, true);
+        _chain_active = false;
+    }
+    
+    _dma_pending = false;
+    setFrameSize(8);
+    return ok;
+}
+
+void HAL::setFrameSize(uint8_t bits) {
+    if (_spi_frame_bits == bits) return;
+    
+    // Format can only change while the SPI is idle
+    while (spi_is_busy(_config.spi_inst)) {
+        tight_loop_contents();
+    }
+    spi_set_format(_config.spi_inst, bits, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+    
+    // DMA writes must match the frame size
+    configureDma(bits, true);
+    
+    _spi_frame_bits = bits;
+}
+
+void HAL::configureDma(uint8_t bits, bool read_increment) {
+    if (_dma_tx_channel < 0) return;
+    
+    dma_channel_config dma_config = dma_channel_get_default_config(_dma_tx_channel);
+    channel_config_set_transfer_data_size(&dma_config, bits > 8 ? DMA_SIZE_16 : DMA_SIZE_8);
+    channel_config_set_read_increment(&dma_config, read_increment);
+    channel_config_set_dreq(&dma_config, spi_get_dreq(_config.spi_inst, true));
+    dma_channel_set_config(_dma_tx_channel, &dma_config, false);
+}
+
 bool HAL::waitForDmaComplete(uint32_t timeout_ms) {
     uint32_t start = to_ms_since_boot(get_absolute_time());
     while (_dma_busy) {
@@ -243,13 +782,39 @@ bool HAL::waitForDmaComplete(uint32_t timeout_ms) {
 }
 
 void HAL::abortDma() {
+    if (_chain_active) {
+        // Stop loading blocks first, then undo what the chain may have
+        // left behind: DC overridden low and 16-bit frames
+        dma_channel_abort(_dma_ctrl_channel);
+        dma_channel_abort(_dma_tx_channel);
+        io_bank0_hw->io[_config.pin_dc].ctrl = _chain_words[WORD_DC_DATA];
+        spi_get_hw(_config.spi_inst)->cr1 = _chain_words[WORD_CR1_OFF];
+        spi_get_hw(_config.spi_inst)->cr0 = _chain_words[WORD_CR0_8];
+        spi_get_hw(_config.spi_inst)->cr1 = _chain_words[WORD_CR1_ON_8];
+        _spi_frame_bits = 8;
+        configureDma(8, true);
+        _chain_active = false;
+    }
+    
     if (_dma_tx_channel >= 0) {
         dma_channel_abort(_dma_tx_channel);
     }
     _dma_busy = false;
+    _align_pending = false;
+    
+    // Bytes on the wire are unknown, drop cached panel state
+    _command_count++;
+    
+    // Release the bus held by an async transfer
+    if (_dma_pending) {
+        deselect();
+        _dma_pending = false;
+        setFrameSize(8);
+    }
 }
 
 void HAL::reset() {
+    _command_count++;  // Panel state is lost
     // Reset sequence
     gpio_put(_config.pin_reset, 0);  // Reset state
     delay(20);
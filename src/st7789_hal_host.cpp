@@ -0,0 +1,454 @@
+// Host HAL backend - drives the ST7789 emulator instead of SPI/GPIO/DMA.
+// Built instead of st7789_hal.cpp when ST7789_HOST_BUILD is defined; pixel
+// packing comes from st7789_pixels.cpp like on the target.
+
+#include "st7789_hal.hpp"
+#include "st7789_pixels.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace st7789 {
+
+// Interrupt handler has no meaning on the host, kept for the friend declaration
+void dma_complete_handler() {
+}
+
+HAL::HAL() :
+    _initialized(false),
+    _dma_tx_channel(-1),
+    _dma_buffer(nullptr),
+    _dma_buffer_size(0),
+    _dma_enabled(false),
+    _dma_busy(false),
+    _dma_pending(false),
+    _fill_color(0),
+    _spi_frame_bits(8),
+    _cs_active(false),
+    _transaction_depth(0),
+    _command_count(0),
+    _data_count(0) {
+}
+
+HAL::~HAL() {
+    cleanupDma();
+}
+
+bool HAL::init(const Config& config) {
+    _config = config;
+
+    // Initial state
+    _emu.setCs(true);     // Not selected
+    _emu.setDc(true);     // Data mode
+
+    // Reset display
+    reset();
+
+    // Initialize DMA (if enabled)
+    if (_config.dma.enabled) {
+        initDma();
+    }
+
+    _initialized = true;
+    return true;
+}
+
+void HAL::initDma() {
+    // Allocate DMA buffer, same sizing as on the target
+    _dma_buffer_size = _config.dma.buffer_size;
+    if (_dma_buffer_size < 4) {
+        _dma_buffer_size = 4;  // Room for one pixel in each ping-pong half
+    }
+    _dma_buffer = (uint16_t*)malloc(_dma_buffer_size);
+    if (!_dma_buffer) {
+        printf("Failed to allocate DMA buffer\n");
+        _dma_enabled = false;
+        return;
+    }
+
+    _dma_tx_channel = 0;
+    _dma_enabled = true;
+}
+
+void HAL::cleanupDma() {
+    _dma_tx_channel = -1;
+
+    // Release buffer
+    if (_dma_buffer) {
+        free(_dma_buffer);
+        _dma_buffer = nullptr;
+    }
+
+    _dma_enabled = false;
+    _dma_busy = false;
+}
+
+void HAL::setDmaIrqEnabled(bool enabled) {
+    // Emulated transfers complete without an interrupt
+    (void)enabled;
+}
+
+void HAL::select() {
+    if (!_cs_active) {
+        _emu.setCs(false);
+        _cs_active = true;
+    }
+}
+
+void HAL::deselect() {
+    // A transaction keeps the chip selected until endTransaction()
+    if (_cs_active && _transaction_depth == 0) {
+        _emu.setCs(true);
+        _cs_active = false;
+    }
+}
+
+void HAL::beginTransaction() {
+    if (_transaction_depth++ == 0) {
+        select();
+    }
+}
+
+void HAL::endTransaction() {
+    if (_transaction_depth == 0) return;
+
+    // An async transfer still on the wire releases CS from waitDmaIdle()
+    if (--_transaction_depth == 0 && !_dma_pending) {
+        deselect();
+    }
+}
+
+void HAL::writeCommand(uint8_t cmd) {
+    writeCommand(cmd, nullptr, 0);
+}
+
+void HAL::writeCommand(uint8_t cmd, const uint8_t* params, size_t len) {
+    if (_dma_pending) waitDmaIdle();
+    _command_count++;
+    _data_count = len;
+
+    select();            // Selected chip
+    _emu.setDc(false);   // Command mode
+    _emu.write(&cmd, 1);
+
+    if (len > 0) {
+        _emu.setDc(true);   // Data mode
+        _emu.write(params, len);
+    }
+    deselect();          // Unselected
+}
+
+void HAL::writeData(uint8_t data) {
+    writeDataBulk(&data, 1);
+}
+
+void HAL::writeDataBulk(const uint8_t* data, size_t len) {
+    if (len == 0) return;
+    if (_dma_pending) waitDmaIdle();
+    _data_count += len;
+
+    select();            // Selected chip
+    _emu.setDc(true);    // Data mode
+    _emu.write(data, len);
+    deselect();          // Unselected
+}
+
+// 12-bit frames as the SPI shifts them out, two frames make three bytes.
+// finish() stands for the 4-bit pad frame after an odd count.
+class FrameStream {
+private:
+    Emulator& _emu;
+    uint16_t _held;
+    bool _holding;
+
+public:
+    FrameStream(Emulator& emu) : _emu(emu), _held(0), _holding(false) {}
+
+    void put(const uint16_t* frames, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            uint16_t frame = frames[i] & 0x0FFF;
+            if (!_holding) {
+                _held = frame;
+                _holding = true;
+                continue;
+            }
+            uint8_t bytes[3] = {
+                (uint8_t)(_held >> 4),
+                (uint8_t)(((_held & 0x0F) << 4) | (frame >> 8)),
+                (uint8_t)(frame & 0xFF)
+            };
+            _emu.write(bytes, 3);
+            _holding = false;
+        }
+    }
+
+    void finish() {
+        if (_holding) {
+            uint8_t bytes[2] = { (uint8_t)(_held >> 4), (uint8_t)((_held & 0x0F) << 4) };
+            _emu.write(bytes, 2);
+            _holding = false;
+        }
+    }
+};
+
+bool HAL::writeConverted(const PixelSource& src) {
+    size_t width = src.width;
+    size_t height = src.height;
+    bool rgb444 = (_config.color_mode == COLOR_RGB444);
+    _data_count += pixelBytes(width * height);
+    setFrameSize(rgb444 ? 12 : 8);
+
+    // Ping-pong halves, chunked exactly like the target so the traffic matches
+    bool use_dma = _dma_enabled && _dma_buffer;
+    uint16_t batch[64];
+    const size_t chunk_pixels = use_dma ? _dma_buffer_size / 4 : 64;
+    uint16_t* chunks[2] = { batch, batch };
+    if (use_dma) {
+        chunks[0] = _dma_buffer;
+        chunks[1] = _dma_buffer + chunk_pixels;
+    }
+    int current = 0;
+    size_t row = 0;
+    size_t col = 0;
+    FrameStream frames(_emu);
+
+    _emu.setDc(true);
+    select();
+
+    while (row < height) {
+        size_t count = packPixels(chunks[current], chunk_pixels, src, rgb444, row, col);
+
+        if (use_dma) {
+            _emu.stats().dma_transfers++;
+        }
+        if (rgb444) {
+            frames.put(chunks[current], count);
+        } else {
+            _emu.write((const uint8_t*)chunks[current], count * 2);
+        }
+
+        current ^= 1;
+    }
+    frames.finish();
+
+    deselect();
+    setFrameSize(8);
+    return true;
+}
+
+// Feed pixels to the emulator the way the SPI would shift them out
+static void emitPixels(Emulator& emu, const uint16_t* src, size_t count, bool native) {
+    if (!native) {
+        emu.write((const uint8_t*)src, count * 2);
+        return;
+    }
+    // 16-bit frames, high byte first
+    for (size_t i = 0; i < count; i++) {
+        uint8_t frame[2] = { (uint8_t)(src[i] >> 8), (uint8_t)(src[i] & 0xFF) };
+        emu.write(frame, 2);
+    }
+}
+
+bool HAL::writePixels(const uint16_t* data, size_t width, size_t height, size_t stride, PixelOrder order) {
+    if (width == 0 || height == 0) return true;
+    if (_dma_pending) waitDmaIdle();
+
+    // Only sources already in the bus format are sent in place
+    bool rgb444 = (_config.color_mode == COLOR_RGB444);
+    if (rgb444 != (order == PIXEL_RGB444)) {
+        PixelSource src = { data, width, height, stride, order, nullptr, 0, 0, nullptr };
+        return writeConverted(src);
+    }
+    _data_count += pixelBytes(width * height);
+
+    bool native = (order == PIXEL_NATIVE);
+    setFrameSize(rgb444 ? 12 : (native ? 16 : 8));
+
+    // One run for a contiguous source, otherwise one per row
+    size_t run = (stride == width) ? width * height : width;
+    size_t runs = (stride == width) ? 1 : height;
+    FrameStream frames(_emu);
+
+    _emu.setDc(true);
+    select();
+
+    for (size_t i = 0; i < runs; i++) {
+        const uint16_t* src = data + i * stride;
+        if (_dma_enabled) {
+            _emu.stats().dma_transfers++;
+        }
+        if (rgb444) {
+            frames.put(src, run);
+        } else {
+            emitPixels(_emu, src, run, native);
+        }
+    }
+    frames.finish();
+
+    deselect();
+    setFrameSize(8);
+    return true;
+}
+
+bool HAL::writePixelsAsync(const uint16_t* data, size_t len, PixelOrder order) {
+    if (len == 0) return true;
+    if (_dma_pending) waitDmaIdle();
+
+    bool rgb444 = (_config.color_mode == COLOR_RGB444);
+    if (!_dma_enabled || rgb444 != (order == PIXEL_RGB444)) {
+        // If DMA is not available or the pixels need converting, fall back
+        // to a blocking write
+        return writePixels(data, len, 1, len, order);
+    }
+
+    _data_count += pixelBytes(len);
+    setFrameSize(rgb444 ? 12 : (order == PIXEL_NATIVE ? 16 : 8));
+    _emu.setDc(true);
+    select();
+
+    // Delivered immediately, CS stays low until waitDmaIdle() like on the target
+    _emu.stats().dma_transfers++;
+    if (rgb444) {
+        FrameStream frames(_emu);
+        frames.put(data, len);
+        frames.finish();
+    } else {
+        emitPixels(_emu, data, len, order == PIXEL_NATIVE);
+    }
+    _dma_pending = true;
+    return true;
+}
+
+bool HAL::fillPixelsAsync(uint16_t color, size_t count) {
+    if (count == 0) return true;
+    if (_dma_pending) waitDmaIdle();
+    _data_count += pixelBytes(count);
+
+    bool rgb444 = (_config.color_mode == COLOR_RGB444);
+    setFrameSize(rgb444 ? 12 : 16);
+    _fill_color = rgb444 ? rgb565To444(color) : color;
+    _emu.setDc(true);
+    select();
+
+    if (rgb444) {
+        FrameStream frames(_emu);
+        for (size_t i = 0; i < count; i++) {
+            frames.put(&_fill_color, 1);
+        }
+        frames.finish();
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            emitPixels(_emu, &_fill_color, 1, true);
+        }
+    }
+
+    if (!_dma_enabled) {
+        deselect();
+        setFrameSize(8);
+        return true;
+    }
+
+    // One transfer, CS stays low until waitDmaIdle() like on the target
+    _emu.stats().dma_transfers++;
+    _dma_pending = true;
+    return true;
+}
+
+bool HAL::writeChainAsync(const BusSegment* segments, size_t count) {
+    if (count == 0) return true;
+    if (_dma_pending) waitDmaIdle();
+
+    if (!_dma_enabled || _config.dma.chain_blocks == 0 || _config.color_mode != COLOR_RGB565) {
+        // No chain, or pixels that need converting, send piece by piece
+        return writeSegments(segments, count);
+    }
+
+    // The whole chain is one trigger, DC follows each segment like on the target
+    select();
+    for (size_t i = 0; i < count; i++) {
+        const BusSegment& seg = segments[i];
+        if (seg.kind == BusSegment::COMMAND) {
+            _command_count += seg.width;
+            _data_count = 0;
+            _emu.setDc(false);
+            _emu.write((const uint8_t*)seg.data, seg.width);
+        } else if (seg.kind == BusSegment::DATA) {
+            _data_count += seg.width;
+            _emu.setDc(true);
+            _emu.write((const uint8_t*)seg.data, seg.width);
+        } else {
+            _data_count += (size_t)seg.width * seg.height * 2;
+            _emu.setDc(true);
+            for (size_t row = 0; row < seg.height; row++) {
+                emitPixels(_emu, (const uint16_t*)seg.data + row * seg.stride, seg.width, true);
+            }
+        }
+    }
+    _emu.setDc(true);
+
+    // CS stays low until waitDmaIdle() like on the target
+    _emu.stats().dma_transfers++;
+    _dma_pending = true;
+    return true;
+}
+
+bool HAL::waitDmaIdle() {
+    if (!_dma_pending) return true;
+
+    deselect();
+    _dma_pending = false;
+    setFrameSize(8);
+    return true;
+}
+
+void HAL::setFrameSize(uint8_t bits) {
+    // The emulator receives bytes, frames only change how pixels are split
+    _spi_frame_bits = bits;
+}
+
+void HAL::configureDma(uint8_t bits, bool read_increment) {
+    (void)bits;
+    (void)read_increment;
+}
+
+bool HAL::waitForDmaComplete(uint32_t timeout_ms) {
+    // Emulated transfers complete synchronously
+    (void)timeout_ms;
+    return true;
+}
+
+void HAL::abortDma() {
+    _dma_busy = false;
+
+    // Bytes on the wire are unknown, drop cached panel state
+    _command_count++;
+
+    // Release the bus held by an async transfer
+    if (_dma_pending) {
+        deselect();
+        _dma_pending = false;
+        setFrameSize(8);
+    }
+}
+
+void HAL::reset() {
+    _command_count++;  // Panel state is lost
+    _emu.reset();
+    delay(20);
+    delay(120);
+}
+
+void HAL::setBacklight(bool on) {
+    (void)on;
+}
+
+void HAL::setBrightness(uint8_t brightness) {
+    setBacklight(brightness > 0);
+}
+
+void HAL::delay(uint32_t ms) {
+    // No real waiting on the host, only account for it
+    _emu.stats().delay_ms += ms;
+}
+
+} // namespace st7789
@@ -0,0 +1,204 @@
+#include "st7789_image.hpp"
+#include <cstring>
+
+namespace st7789 {
+
+static inline uint16_t qoiHash(uint16_t c) {
+    return ((c >> 11) * 3 + ((c >> 5) & 0x3F) * 5 + (c & 0x1F) * 7) % 64;
+}
+
+ImageDecoder::ImageDecoder() :
+    _data(nullptr),
+    _start(nullptr),
+    _end(nullptr),
+    _codec(0),
+    _width(0),
+    _height(0),
+    _color(0),
+    _count(0),
+    _literal(false),
+    _prev(0),
+    _win_x(0),
+    _win_y(0),
+    _win_w(0),
+    _win_h(0),
+    _col(0),
+    _row(0) {
+}
+
+bool ImageDecoder::begin(const uint8_t* blob, size_t size) {
+    _data = nullptr;
+    _start = nullptr;
+    _end = nullptr;
+    _width = 0;
+    _height = 0;
+    if (!blob || size < HEADER_SIZE || blob[0] != 'S' || blob[1] != 'I' ||
+        (blob[2] != IMAGE_RLE && blob[2] != IMAGE_QOI)) {
+        return false;
+    }
+
+    _codec = blob[2];
+    _width = blob[4] | (blob[5] << 8);
+    _height = blob[6] | (blob[7] << 8);
+    _data = blob + HEADER_SIZE;
+    _end = blob + size;
+    _count = 0;
+    _literal = false;
+    _prev = 0;
+    memset(_index, 0, sizeof(_index));
+    _start = _data;
+    _row = 0;
+    _col = 0;
+    setWindow(0, 0, _width, _height);
+    return _width > 0 && _height > 0;
+}
+
+void ImageDecoder::setWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    // Decoding starts over, the window can move back up the image
+    if (_row != 0 || _col != 0) {
+        _data = _start;
+        _count = 0;
+        _literal = false;
+        _prev = 0;
+        memset(_index, 0, sizeof(_index));
+        _row = 0;
+        _col = 0;
+    }
+    _win_x = x < _width ? x : _width;
+    _win_y = y < _height ? y : _height;
+    _win_w = (w < _width - _win_x) ? w : _width - _win_x;
+    _win_h = (h < _height - _win_y) ? h : _height - _win_y;
+}
+
+// Decode the next op into _color/_count, false at the end of the stream
+bool ImageDecoder::nextOp() {
+    if (_data >= _end) return false;
+    uint8_t op = *_data++;
+
+    if (_codec == IMAGE_RLE) {
+        _count = (op & 0x7F) + 1;
+        _literal = !(op & 0x80);
+        if (!_literal) {
+            if (_end - _data < 2) return false;
+            _color = _data[0] | (_data[1] << 8);
+            _data += 2;
+        }
+        return true;
+    }
+
+    uint16_t c = _prev;
+    _count = 1;
+    switch (op >> 6) {
+        case 0:
+            c = _index[op];
+            break;
+        case 1: {
+            uint16_t r = ((c >> 11) + ((op >> 4) & 3) - 2) & 0x1F;
+            uint16_t g = (((c >> 5) & 0x3F) + ((op >> 2) & 3) - 2) & 0x3F;
+            uint16_t b = ((c & 0x1F) + (op & 3) - 2) & 0x1F;
+            c = (r << 11) | (g << 5) | b;
+            break;
+        }
+        case 2: {
+            if (_data >= _end) return false;
+            uint8_t rb = *_data++;
+            int dg = (op & 0x3F) - 32;
+            uint16_t r = ((c >> 11) + (dg >> 1) + (rb >> 4) - 8) & 0x1F;
+            uint16_t g = (((c >> 5) & 0x3F) + dg) & 0x3F;
+            uint16_t b = ((c & 0x1F) + (dg >> 1) + (rb & 0x0F) - 8) & 0x1F;
+            c = (r << 11) | (g << 5) | b;
+            break;
+        }
+        default:
+            if (op == 0xFE) {
+                if (_end - _data < 2) return false;
+                c = _data[0] | (_data[1] << 8);
+                _data += 2;
+            } else if (op == 0xFF) {
+                return false;
+            } else {
+                _count = (op & 0x3F) + 1;
+            }
+            break;
+    }
+
+    _prev = c;
+    _index[qoiHash(c)] = c;
+    _color = c;
+    _literal = false;
+    return true;
+}
+
+// Next count pixels of the image, dropped when out is null. A truncated
+// stream decodes as black.
+void ImageDecoder::decode(uint16_t* out, size_t count) {
+    while (count > 0) {
+        if (_count == 0 && !nextOp()) {
+            if (out) {
+                memset(out, 0, count * sizeof(uint16_t));
+            }
+            _data = _end;
+            return;
+        }
+
+        size_t n = count < _count ? count : _count;
+        if (_literal) {
+            // RLE literal pixels come straight from the stream
+            if ((size_t)(_end - _data) < n * 2) {
+                _count = 0;
+                _data = _end;
+                continue;
+            }
+            if (out) {
+                for (size_t i = 0; i < n; i++) {
+                    out[i] = _data[i * 2] | (_data[i * 2 + 1] << 8);
+                }
+            }
+            _data += n * 2;
+        } else if (out) {
+            for (size_t i = 0; i < n; i++) {
+                out[i] = _color;
+            }
+        }
+        if (out) {
+            out += n;
+        }
+        _count -= n;
+        count -= n;
+    }
+}
+
+size_t ImageDecoder::read(uint16_t* pixels, size_t max) {
+    size_t done = 0;
+    uint16_t win_x1 = _win_x + _win_w;
+    while (done < max && _row < _win_y + _win_h && _win_w > 0) {
+        // Skip rows above the window and columns left of it
+        if (_row < _win_y) {
+            decode(nullptr, (size_t)(_win_y - _row) * _width - _col);
+            _row = _win_y;
+            _col = 0;
+        }
+        if (_col < _win_x) {
+            decode(nullptr, _win_x - _col);
+            _col = _win_x;
+        }
+
+        size_t n = win_x1 - _col;
+        if (n > max - done) {
+            n = max - done;
+        }
+        decode(pixels + done, n);
+        done += n;
+        _col += n;
+
+        // Right of the window to the end of the row
+        if (_col == win_x1) {
+            decode(nullptr, _width - _col);
+            _col = 0;
+            _row++;
+        }
+    }
+    return done;
+}
+
+} // namespace st7789
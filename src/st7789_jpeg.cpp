@@ -0,0 +1,640 @@
+#include "st7789_jpeg.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace st7789 {
+
+// Natural index of each zigzag position
+static const uint8_t dezigzag[64] = {
+     0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+static inline uint16_t readBE16(const uint8_t* p) {
+    return (p[0] << 8) | p[1];
+}
+
+static inline uint8_t clamp255(int32_t v) {
+    return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+JpegDecoder::JpegDecoder() :
+    _tables(nullptr),
+    _strip(nullptr),
+    _strip_mcu(0),
+    _width(0),
+    _height(0),
+    _comp_count(0),
+    _hmax(1),
+    _vmax(1),
+    _mcu_w(8),
+    _mcu_h(8),
+    _mcus_x(0),
+    _strip_width(0),
+    _pos(nullptr),
+    _end(nullptr),
+    _bits(0),
+    _bit_count(0),
+    _marker(false),
+    _error(false),
+    _restart_interval(0),
+    _restart_left(0),
+    _strip_y(0),
+    _next_strip_y(0),
+    _strip_ready(false),
+    _win_x(0),
+    _win_y(0),
+    _win_w(0),
+    _win_h(0),
+    _col(0),
+    _row(0) {
+    memset(_comp, 0, sizeof(_comp));
+}
+
+JpegDecoder::~JpegDecoder() {
+    end();
+}
+
+bool JpegDecoder::begin(const uint8_t* data, size_t size) {
+    end();
+
+    _tables = (Tables*)malloc(sizeof(Tables));
+    if (!_tables) {
+        printf("Failed to allocate JPEG tables\n");
+        return false;
+    }
+    memset(_tables, 0, sizeof(Tables));
+
+    if (!parseHeaders(data, size)) {
+        end();
+        return false;
+    }
+
+    _bits = 0;
+    _bit_count = 0;
+    _marker = false;
+    _error = false;
+    _restart_left = _restart_interval;
+    _strip_y = 0;
+    _strip_mcu = 0;
+    _strip_width = 0;
+    _next_strip_y = 0;
+    _strip_ready = false;
+    setWindow(0, 0, _width, _height);
+    return true;
+}
+
+void JpegDecoder::end() {
+    free(_tables);
+    free(_strip);
+    _tables = nullptr;
+    _strip = nullptr;
+    _width = 0;
+    _height = 0;
+}
+
+// Markers up to the start of scan, leaves _pos on the entropy-coded data
+bool JpegDecoder::parseHeaders(const uint8_t* data, size_t size) {
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    if (size < 4 || p[0] != 0xFF || p[1] != 0xD8) {
+        return false;
+    }
+    p += 2;
+
+    bool have_frame = false;
+    _restart_interval = 0;
+    while (end - p >= 4) {
+        if (p[0] != 0xFF) {
+            return false;
+        }
+        uint8_t marker = p[1];
+        if (marker == 0xFF) {
+            p++;                // Fill byte
+            continue;
+        }
+        uint16_t len = readBE16(p + 2);
+        const uint8_t* seg = p + 4;
+        const uint8_t* seg_end = p + 2 + len;
+        if (len < 2 || seg_end > end) {
+            return false;
+        }
+
+        switch (marker) {
+            case 0xDB:          // DQT
+                while (seg < seg_end) {
+                    uint8_t precision = seg[0] >> 4;
+                    uint8_t id = seg[0] & 0x0F;
+                    size_t bytes = precision ? 128 : 64;
+                    if (id > 3 || (size_t)(seg_end - seg) < 1 + bytes) return false;
+                    for (int k = 0; k < 64; k++) {
+                        _tables->quant[id][dezigzag[k]] = precision ? readBE16(seg + 1 + k * 2) : seg[1 + k];
+                    }
+                    seg += 1 + bytes;
+                }
+                break;
+
+            case 0xC4:          // DHT
+                while (seg < seg_end) {
+                    if (seg_end - seg < 17) return false;
+                    uint8_t cls = seg[0] >> 4;
+                    uint8_t id = seg[0] & 0x0F;
+                    size_t count = 0;
+                    for (int i = 0; i < 16; i++) {
+                        count += seg[1 + i];
+                    }
+                    if (cls > 1 || id > 1 || count > 256 || (size_t)(seg_end - seg) < 17 + count) return false;
+                    HuffTable& table = cls ? _tables->ac[id] : _tables->dc[id];
+                    if (!buildTable(table, seg + 1, seg + 17)) return false;
+                    seg += 17 + count;
+                }
+                break;
+
+            case 0xDD:          // DRI
+                if (len < 4) return false;
+                _restart_interval = readBE16(seg);
+                break;
+
+            case 0xC0:          // SOF0 baseline
+            case 0xC1: {        // SOF1 extended sequential, Huffman
+                if (len < 8 || seg[0] != 8) return false;
+                _height = readBE16(seg + 1);
+                _width = readBE16(seg + 3);
+                _comp_count = seg[5];
+                if (_width == 0 || _height == 0 || (_comp_count != 1 && _comp_count != 3) ||
+                    len < 8 + 3 * _comp_count) {
+                    return false;
+                }
+                _hmax = 1;
+                _vmax = 1;
+                for (uint8_t i = 0; i < _comp_count; i++) {
+                    Component& c = _comp[i];
+                    c.id = seg[6 + i * 3];
+                    c.h = seg[7 + i * 3] >> 4;
+                    c.v = seg[7 + i * 3] & 0x0F;
+                    c.quant = seg[8 + i * 3] & 3;
+                    if (c.h < 1 || c.h > 2 || c.v < 1 || c.v > 2) return false;
+                }
+                if (_comp_count == 1) {
+                    // A single component is not interleaved, one block per MCU
+                    _comp[0].h = 1;
+                    _comp[0].v = 1;
+                } else {
+                    // Full-resolution luma, chroma at most halved
+                    if (_comp[1].h != 1 || _comp[1].v != 1 || _comp[2].h != 1 || _comp[2].v != 1) return false;
+                    _hmax = _comp[0].h;
+                    _vmax = _comp[0].v;
+                }
+                _mcu_w = 8 * _hmax;
+                _mcu_h = 8 * _vmax;
+                _mcus_x = (_width + _mcu_w - 1) / _mcu_w;
+                have_frame = true;
+                break;
+            }
+
+            case 0xDA: {        // SOS
+                if (!have_frame || len < 6 || seg[0] != _comp_count || len < 6 + 2 * _comp_count) {
+                    return false;
+                }
+                // One interleaved scan in frame order
+                for (uint8_t i = 0; i < _comp_count; i++) {
+                    Component& c = _comp[i];
+                    if (seg[1 + i * 2] != c.id) return false;
+                    c.dc_table = seg[2 + i * 2] >> 4;
+                    c.ac_table = seg[2 + i * 2] & 0x0F;
+                    if (c.dc_table > 1 || c.ac_table > 1 ||
+                        !_tables->dc[c.dc_table].valid || !_tables->ac[c.ac_table].valid) {
+                        return false;
+                    }
+                    c.pred = 0;
+                }
+                _pos = seg_end;
+                _end = end;
+                return true;
+            }
+
+            default:
+                // Progressive, lossless and arithmetic frames are refused,
+                // APPn and COM are skipped
+                if (marker >= 0xC2 && marker <= 0xCF) {
+                    return false;
+                }
+                break;
+        }
+        p = seg_end;
+    }
+    return false;
+}
+
+// Canonical Huffman codes from the counts per length
+bool JpegDecoder::buildTable(HuffTable& table, const uint8_t* counts, const uint8_t* values) {
+    memset(table.lookup, 0, sizeof(table.lookup));
+    table.values = values;
+
+    uint32_t code = 0;
+    uint16_t k = 0;
+    for (int len = 1; len <= 16; len++) {
+        table.mincode[len] = code;
+        table.valptr[len] = k;
+        for (int i = 0; i < counts[len - 1]; i++) {
+            if (len <= 8) {
+                // Every byte starting with this code
+                uint16_t first = code << (8 - len);
+                for (uint16_t j = 0; j < (1u << (8 - len)); j++) {
+                    table.lookup[first + j] = (len << 8) | values[k];
+                }
+            }
+            code++;
+            k++;
+        }
+        if (code > (1u << len)) {
+            return false;
+        }
+        table.maxcode[len] = counts[len - 1] ? (int32_t)code - 1 : -1;
+        code <<= 1;
+    }
+    table.maxcode[17] = INT32_MAX;
+    table.valid = true;
+    return true;
+}
+
+// Keep at least 25 bits buffered, byte stuffing removed. At a marker only
+// zeros come in until restart() moves past it.
+void JpegDecoder::fillBits() {
+    while (_bit_count <= 24) {
+        uint32_t byte = 0;
+        if (!_marker && _pos < _end) {
+            byte = *_pos++;
+            if (byte == 0xFF) {
+                uint8_t next = _pos < _end ? *_pos : 0xD9;
+                if (next == 0x00) {
+                    _pos++;
+                } else {
+                    _marker = true;
+                    _pos--;
+                    byte = 0;
+                }
+            }
+        }
+        _bits |= byte << (24 - _bit_count);
+        _bit_count += 8;
+    }
+}
+
+uint32_t JpegDecoder::getBits(int n) {
+    if (n == 0) return 0;
+    fillBits();
+    uint32_t v = _bits >> (32 - n);
+    _bits <<= n;
+    _bit_count -= n;
+    return v;
+}
+
+int JpegDecoder::decodeSymbol(const HuffTable& table) {
+    fillBits();
+
+    // Short codes in one lookup
+    uint16_t entry = table.lookup[_bits >> 24];
+    if (entry) {
+        int len = entry >> 8;
+        _bits <<= len;
+        _bit_count -= len;
+        return entry & 0xFF;
+    }
+
+    for (int len = 9; len <= 16; len++) {
+        int32_t code = _bits >> (32 - len);
+        if (code <= table.maxcode[len]) {
+            _bits <<= len;
+            _bit_count -= len;
+            return table.values[table.valptr[len] + code - table.mincode[len]];
+        }
+    }
+    _error = true;
+    return 0;
+}
+
+// Skip to the RSTn marker and reset the predictors
+bool JpegDecoder::restart() {
+    _bits = 0;
+    _bit_count = 0;
+    while (_pos + 1 < _end && !(_pos[0] == 0xFF && _pos[1] >= 0xD0 && _pos[1] <= 0xD7)) {
+        _pos++;
+    }
+    if (_pos + 1 >= _end) {
+        return false;
+    }
+    _pos += 2;
+    _marker = false;
+    for (uint8_t i = 0; i < _comp_count; i++) {
+        _comp[i].pred = 0;
+    }
+    _restart_left = _restart_interval;
+    return true;
+}
+
+// Value of an n-bit magnitude category
+static inline int32_t extend(uint32_t v, int n) {
+    return (n == 0 || v >= (1u << (n - 1))) ? (int32_t)v : (int32_t)v - (1 << n) + 1;
+}
+
+// Fixed-point IDCT after the islow method of the IJG library, 13-bit
+// constants and 2 extra bits of precision between the passes
+#define CONST_BITS 13
+#define PASS1_BITS 2
+#define FIX_0_298631336 2446
+#define FIX_0_390180644 3196
+#define FIX_0_541196100 4433
+#define FIX_0_765366865 6270
+#define FIX_0_899976223 7373
+#define FIX_1_175875602 9633
+#define FIX_1_501321110 12299
+#define FIX_1_847759065 15137
+#define FIX_1_961570560 16069
+#define FIX_2_053119869 16819
+#define FIX_2_562915447 20995
+#define FIX_3_072711026 25172
+#define DESCALE(x, n) (((x) + (1 << ((n) - 1))) >> (n))
+
+static void idct(const int32_t* in, int32_t* ws, uint8_t* out) {
+    // Columns
+    for (int c = 0; c < 8; c++) {
+        const int32_t* s = in + c;
+        int32_t* d = ws + c;
+        if (!s[8] && !s[16] && !s[24] && !s[32] && !s[40] && !s[48] && !s[56]) {
+            int32_t dc = s[0] << PASS1_BITS;
+            for (int r = 0; r < 8; r++) {
+                d[r * 8] = dc;
+            }
+            continue;
+        }
+
+        int32_t z2 = s[16], z3 = s[48];
+        int32_t z1 = (z2 + z3) * FIX_0_541196100;
+        int32_t tmp2 = z1 - z3 * FIX_1_847759065;
+        int32_t tmp3 = z1 + z2 * FIX_0_765366865;
+        int32_t tmp0 = (s[0] + s[32]) << CONST_BITS;
+        int32_t tmp1 = (s[0] - s[32]) << CONST_BITS;
+        int32_t tmp10 = tmp0 + tmp3, tmp13 = tmp0 - tmp3;
+        int32_t tmp11 = tmp1 + tmp2, tmp12 = tmp1 - tmp2;
+
+        tmp0 = s[56];
+        tmp1 = s[40];
+        tmp2 = s[24];
+        tmp3 = s[8];
+        z1 = tmp0 + tmp3;
+        z2 = tmp1 + tmp2;
+        z3 = tmp0 + tmp2;
+        int32_t z4 = tmp1 + tmp3;
+        int32_t z5 = (z3 + z4) * FIX_1_175875602;
+        tmp0 *= FIX_0_298631336;
+        tmp1 *= FIX_2_053119869;
+        tmp2 *= FIX_3_072711026;
+        tmp3 *= FIX_1_501321110;
+        z1 *= -FIX_0_899976223;
+        z2 *= -FIX_2_562915447;
+        z3 = z3 * -FIX_1_961570560 + z5;
+        z4 = z4 * -FIX_0_390180644 + z5;
+        tmp0 += z1 + z3;
+        tmp1 += z2 + z4;
+        tmp2 += z2 + z3;
+        tmp3 += z1 + z4;
+
+        const int shift = CONST_BITS - PASS1_BITS;
+        d[0] = DESCALE(tmp10 + tmp3, shift);
+        d[56] = DESCALE(tmp10 - tmp3, shift);
+        d[8] = DESCALE(tmp11 + tmp2, shift);
+        d[48] = DESCALE(tmp11 - tmp2, shift);
+        d[16] = DESCALE(tmp12 + tmp1, shift);
+        d[40] = DESCALE(tmp12 - tmp1, shift);
+        d[24] = DESCALE(tmp13 + tmp0, shift);
+        d[32] = DESCALE(tmp13 - tmp0, shift);
+    }
+
+    // Rows, level shifted back to 0..255
+    const int shift = CONST_BITS + PASS1_BITS + 3;
+    const int32_t bias = 128 << shift;
+    for (int r = 0; r < 8; r++) {
+        const int32_t* s = ws + r * 8;
+        uint8_t* d = out + r * 8;
+
+        int32_t z2 = s[2], z3 = s[6];
+        int32_t z1 = (z2 + z3) * FIX_0_541196100;
+        int32_t tmp2 = z1 - z3 * FIX_1_847759065;
+        int32_t tmp3 = z1 + z2 * FIX_0_765366865;
+        int32_t tmp0 = ((s[0] + s[4]) << CONST_BITS) + bias;
+        int32_t tmp1 = ((s[0] - s[4]) << CONST_BITS) + bias;
+        int32_t tmp10 = tmp0 + tmp3, tmp13 = tmp0 - tmp3;
+        int32_t tmp11 = tmp1 + tmp2, tmp12 = tmp1 - tmp2;
+
+        tmp0 = s[7];
+        tmp1 = s[5];
+        tmp2 = s[3];
+        tmp3 = s[1];
+        z1 = tmp0 + tmp3;
+        z2 = tmp1 + tmp2;
+        z3 = tmp0 + tmp2;
+        int32_t z4 = tmp1 + tmp3;
+        int32_t z5 = (z3 + z4) * FIX_1_175875602;
+        tmp0 *= FIX_0_298631336;
+        tmp1 *= FIX_2_053119869;
+        tmp2 *= FIX_3_072711026;
+        tmp3 *= FIX_1_501321110;
+        z1 *= -FIX_0_899976223;
+        z2 *= -FIX_2_562915447;
+        z3 = z3 * -FIX_1_961570560 + z5;
+        z4 = z4 * -FIX_0_390180644 + z5;
+        tmp0 += z1 + z3;
+        tmp1 += z2 + z4;
+        tmp2 += z2 + z3;
+        tmp3 += z1 + z4;
+
+        d[0] = clamp255(DESCALE(tmp10 + tmp3, shift));
+        d[7] = clamp255(DESCALE(tmp10 - tmp3, shift));
+        d[1] = clamp255(DESCALE(tmp11 + tmp2, shift));
+        d[6] = clamp255(DESCALE(tmp11 - tmp2, shift));
+        d[2] = clamp255(DESCALE(tmp12 + tmp1, shift));
+        d[5] = clamp255(DESCALE(tmp12 - tmp1, shift));
+        d[3] = clamp255(DESCALE(tmp13 + tmp0, shift));
+        d[4] = clamp255(DESCALE(tmp13 - tmp0, shift));
+    }
+}
+
+// Huffman decode one block, then dequantize and transform it unless the
+// samples are not needed
+bool JpegDecoder::decodeBlock(Component& comp, uint8_t* out, bool transform) {
+    int32_t* coef = _tables->coef;
+    const uint16_t* q = _tables->quant[comp.quant];
+    const HuffTable& dc = _tables->dc[comp.dc_table];
+    const HuffTable& ac = _tables->ac[comp.ac_table];
+    if (transform) {
+        memset(coef, 0, sizeof(_tables->coef));
+    }
+
+    int s = decodeSymbol(dc);
+    if (s > 11) {
+        _error = true;
+        return false;
+    }
+    comp.pred += extend(getBits(s), s);
+    coef[0] = comp.pred * q[0];
+
+    for (int k = 1; k < 64;) {
+        int rs = decodeSymbol(ac);
+        int r = rs >> 4;
+        s = rs & 0x0F;
+        if (s == 0) {
+            if (r != 15) break;     // End of block
+            k += 16;
+            continue;
+        }
+        k += r;
+        if (k > 63) {
+            _error = true;
+            break;
+        }
+        int32_t v = extend(getBits(s), s);
+        if (transform) {
+            coef[dezigzag[k]] = v * q[dezigzag[k]];
+        }
+        k++;
+    }
+    if (_error) {
+        return false;
+    }
+
+    if (transform) {
+        idct(coef, _tables->work, out);
+    }
+    return true;
+}
+
+// Fixed-point YCbCr to RGB565, 16 fractional bits
+#define CR_R 91881      // 1.402
+#define CB_G 22554      // 0.344136
+#define CR_G 46802      // 0.714136
+#define CB_B 116130     // 1.772
+
+void JpegDecoder::convertMcu(uint16_t* dst) {
+    const uint8_t (*blocks)[64] = _tables->blocks;
+    for (uint16_t y = 0; y < _mcu_h; y++) {
+        uint16_t* line = dst + y * _strip_width;
+        for (uint16_t x = 0; x < _mcu_w; x++) {
+            // Luma block of this pixel, blocks are stored left to right, top to bottom
+            const uint8_t* yb = blocks[(y >> 3) * _hmax + (x >> 3)];
+            int32_t luma = yb[(y & 7) * 8 + (x & 7)];
+            if (_comp_count == 1) {
+                line[x] = ((luma & 0xF8) << 8) | ((luma & 0xFC) << 3) | (luma >> 3);
+                continue;
+            }
+
+            // Chroma sample covering this pixel
+            int ci = (y >> (_vmax - 1)) * 8 + (x >> (_hmax - 1));
+            int32_t cb = blocks[_hmax * _vmax][ci] - 128;
+            int32_t cr = blocks[_hmax * _vmax + 1][ci] - 128;
+            luma <<= 16;
+            uint8_t r = clamp255((luma + CR_R * cr + 32768) >> 16);
+            uint8_t g = clamp255((luma - CB_G * cb - CR_G * cr + 32768) >> 16);
+            uint8_t b = clamp255((luma + CB_B * cb + 32768) >> 16);
+            line[x] = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+        }
+    }
+}
+
+// Decode the next MCU row into the strip. MCUs outside the window
+// columns, or every MCU when output is false, are only entropy decoded.
+bool JpegDecoder::decodeStrip(bool output) {
+    if (_error || _next_strip_y >= _height) {
+        return false;
+    }
+
+    uint16_t first_mcu = _win_x / _mcu_w;
+    uint16_t last_mcu = (_win_x + _win_w - 1) / _mcu_w;
+    for (uint16_t mx = 0; mx < _mcus_x; mx++) {
+        if (_restart_interval) {
+            if (_restart_left == 0 && !restart()) {
+                _error = true;
+                return false;
+            }
+            _restart_left--;
+        }
+
+        bool transform = output && mx >= first_mcu && mx <= last_mcu;
+        uint8_t block = 0;
+        for (uint8_t i = 0; i < _comp_count; i++) {
+            Component& c = _comp[i];
+            for (uint8_t n = 0; n < c.h * c.v; n++) {
+                if (!decodeBlock(c, _tables->blocks[block++], transform)) {
+                    return false;
+                }
+            }
+        }
+        if (transform) {
+            convertMcu(_strip + (mx - _strip_mcu) * _mcu_w);
+        }
+    }
+
+    _strip_y = _next_strip_y;
+    _next_strip_y += _mcu_h;
+    _strip_ready = output;
+    return true;
+}
+
+void JpegDecoder::setWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    // The strip is sized to the window columns once reading starts
+    if (_strip) return;
+    _win_x = x < _width ? x : _width;
+    _win_y = y < _height ? y : _height;
+    _win_w = (w < _width - _win_x) ? w : _width - _win_x;
+    _win_h = (h < _height - _win_y) ? h : _height - _win_y;
+    _col = _win_x;
+    _row = _win_y;
+}
+
+size_t JpegDecoder::read(uint16_t* pixels, size_t max) {
+    if (!_tables || _error || _win_w == 0) {
+        return 0;
+    }
+
+    if (!_strip) {
+        // Whole MCUs covering the window columns, cropped on output
+        _strip_mcu = _win_x / _mcu_w;
+        _strip_width = ((_win_x + _win_w - 1) / _mcu_w - _strip_mcu + 1) * _mcu_w;
+        _strip = (uint16_t*)malloc((size_t)_strip_width * _mcu_h * sizeof(uint16_t));
+        if (!_strip) {
+            printf("Failed to allocate JPEG strip\n");
+            _error = true;
+            return 0;
+        }
+    }
+
+    size_t done = 0;
+    while (done < max && _row < _win_y + _win_h) {
+        // Decode up to the strip holding the next row
+        while (!_strip_ready || _row >= _strip_y + _mcu_h) {
+            bool visible = _next_strip_y + _mcu_h > _row;
+            if (!decodeStrip(visible)) {
+                return done;
+            }
+        }
+
+        size_t n = _win_x + _win_w - _col;
+        if (n > max - done) {
+            n = max - done;
+        }
+        size_t offset = (size_t)(_row - _strip_y) * _strip_width + (_col - _strip_mcu * _mcu_w);
+        memcpy(pixels + done, _strip + offset, n * sizeof(uint16_t));
+        done += n;
+        _col += n;
+        if (_col == _win_x + _win_w) {
+            _col = _win_x;
+            _row++;
+        }
+    }
+    return done;
+}
+
+} // namespace st7789
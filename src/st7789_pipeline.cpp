@@ -0,0 +1,376 @@
+#include "st7789_pipeline.hpp"
+#include "st7789.hpp"
+#include "st7789_core.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace st7789 {
+
+RenderPipeline::RenderPipeline(ST7789& lcd) :
+    _lcd(&lcd),
+    _slots(nullptr),
+    _capacity(0),
+    _head(0),
+    _tail(0),
+    _executed(0),
+    _running(false),
+    _text(nullptr),
+    _text_size(0),
+    _text_len(0),
+    _pushed(0),
+    _stalls(0),
+    _max_depth(0) {
+}
+
+RenderPipeline::~RenderPipeline() {
+    end();
+}
+
+bool RenderPipeline::begin(uint16_t depth) {
+    end();
+    if (depth == 0 || depth == UINT16_MAX) {
+        return false;
+    }
+
+    _slots = (PipelineCommand*)malloc(sizeof(PipelineCommand) * (depth + 1));
+    if (!_slots) {
+        printf("Failed to allocate pipeline queue\n");
+        return false;
+    }
+    _capacity = depth + 1;
+    _head.store(0, std::memory_order_relaxed);
+    _tail.store(0, std::memory_order_relaxed);
+    _executed.store(0, std::memory_order_relaxed);
+    _text_len = 0;
+    _pushed = 0;
+    resetStats();
+    return true;
+}
+
+void RenderPipeline::end() {
+    stop();
+    free(_slots);
+    free(_text);
+    _slots = nullptr;
+    _text = nullptr;
+    _text_size = 0;
+    _capacity = 0;
+}
+
+bool RenderPipeline::start() {
+    if (!_slots) {
+        return false;
+    }
+    if (isRunning()) {
+        return true;
+    }
+
+    // DMA completions are taken on the core waiting for them
+    _lcd->hal().setDmaIrqEnabled(false);
+    _running.store(true, std::memory_order_release);
+    if (!SecondCore::launch(consumerEntry, this)) {
+        printf("Core 1 is already in use\n");
+        _running.store(false, std::memory_order_release);
+        _lcd->hal().setDmaIrqEnabled(true);
+        return false;
+    }
+    return true;
+}
+
+void RenderPipeline::stop() {
+    if (!isRunning()) {
+        return;
+    }
+
+    // Everything queued before is executed first
+    PipelineCommand cmd = {};
+    cmd.type = CMD_STOP;
+    push(cmd);
+
+    SecondCore::join();
+    _lcd->hal().setDmaIrqEnabled(true);
+}
+
+void RenderPipeline::consumerEntry(void* user) {
+    RenderPipeline* pipe = (RenderPipeline*)user;
+    pipe->_lcd->hal().setDmaIrqEnabled(true);
+    pipe->run();
+    pipe->_lcd->hal().setDmaIrqEnabled(false);
+}
+
+// Producer side, only ever called from core 0
+bool RenderPipeline::push(PipelineCommand& cmd) {
+    if (!isRunning()) {
+        return false;
+    }
+
+    uint16_t head = _head.load(std::memory_order_relaxed);
+    uint16_t next = (head + 1 == _capacity) ? 0 : head + 1;
+
+    // Ring full, wait for the render core to free a slot
+    if (next == _tail.load(std::memory_order_acquire)) {
+        _stalls++;
+        while (next == _tail.load(std::memory_order_acquire)) {
+            SecondCore::wait();
+        }
+    }
+
+    _slots[head] = cmd;
+    _head.store(next, std::memory_order_release);
+    SecondCore::signal();
+    _pushed++;
+
+    uint16_t used = depth();
+    if (used > _max_depth) {
+        _max_depth = used;
+    }
+    return true;
+}
+
+uint16_t RenderPipeline::depth() const {
+    if (_capacity == 0) {
+        return 0;
+    }
+    uint16_t head = _head.load(std::memory_order_acquire);
+    uint16_t tail = _tail.load(std::memory_order_acquire);
+    return (head >= tail) ? head - tail : head + _capacity - tail;
+}
+
+// Consumer loop, runs on core 1 until a stop command
+void RenderPipeline::run() {
+    HAL& hal = _lcd->hal();
+    while (true) {
+        uint16_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) {
+            SecondCore::wait();
+            continue;
+        }
+
+        // Copy out so the slot can be reused as soon as tail moves
+        PipelineCommand cmd = _slots[tail];
+        _tail.store((tail + 1 == _capacity) ? 0 : tail + 1, std::memory_order_release);
+        SecondCore::signal();
+
+        if (cmd.type == CMD_STOP) {
+            hal.waitDmaIdle();
+            _executed.fetch_add(1, std::memory_order_release);
+            break;
+        }
+        execute(cmd);
+
+        // Release the bus once the queue runs dry so sync() means sent
+        if (_tail.load(std::memory_order_relaxed) == _head.load(std::memory_order_acquire)) {
+            hal.waitDmaIdle();
+        }
+        _executed.fetch_add(1, std::memory_order_release);
+        SecondCore::signal();
+    }
+
+    _running.store(false, std::memory_order_release);
+    SecondCore::signal();
+}
+
+void RenderPipeline::execute(const PipelineCommand& cmd) {
+    ST7789& lcd = *_lcd;
+    const int16_t* a = cmd.args;
+    switch (cmd.type) {
+        case CMD_FILL_RECT:
+            lcd.fillRect(a[0], a[1], a[2], a[3], cmd.color);
+            break;
+        case CMD_PIXEL:
+            lcd.drawPixel(a[0], a[1], cmd.color);
+            break;
+        case CMD_LINE:
+            lcd.drawLine(a[0], a[1], a[2], a[3], cmd.color);
+            break;
+        case CMD_RECT:
+            lcd.drawRect(a[0], a[1], a[2], a[3], cmd.color);
+            break;
+        case CMD_CIRCLE:
+            lcd.drawCircle(a[0], a[1], a[2], cmd.color);
+            break;
+        case CMD_FILL_CIRCLE:
+            lcd.fillCircle(a[0], a[1], a[2], cmd.color);
+            break;
+        case CMD_FILL_TRIANGLE:
+            lcd.fillTriangle(a[0], a[1], a[2], a[3], a[4], a[5], cmd.color);
+            break;
+        case CMD_TEXT_PART:
+            memcpy(_text + _text_len, cmd.text, PipelineCommand::TEXT_MAX);
+            _text_len += PipelineCommand::TEXT_MAX;
+            break;
+        case CMD_TEXT:
+        case CMD_TEXT_AA: {
+            // The last part completes a joined string
+            const char* text = cmd.text;
+            if (_text_len > 0) {
+                strcpy(_text + _text_len, cmd.text);
+                _text_len = 0;
+                text = _text;
+            }
+            if (cmd.type == CMD_TEXT) {
+                lcd.drawString(a[0], a[1], text, cmd.color, cmd.bg, cmd.size);
+            } else {
+                lcd.drawString(a[0], a[1], text, *cmd.font, cmd.color, cmd.bg);
+            }
+            break;
+        }
+        case CMD_IMAGE:
+            lcd.drawImage(a[0], a[1], a[2], a[3], (const uint16_t*)cmd.data, (PixelOrder)cmd.size);
+            break;
+        case CMD_FLUSH:
+            lcd.flush();
+            break;
+        case CMD_CALL:
+            cmd.func(lcd, cmd.user);
+            break;
+        default:
+            break;
+    }
+}
+
+void RenderPipeline::sync() {
+    while (isRunning() && _executed.load(std::memory_order_acquire) != _pushed) {
+        SecondCore::wait();
+    }
+}
+
+// Command with type, color and the first n coordinates set
+static void setCommand(PipelineCommand& cmd, uint8_t type, uint16_t color,
+                       int16_t a0 = 0, int16_t a1 = 0, int16_t a2 = 0,
+                       int16_t a3 = 0, int16_t a4 = 0, int16_t a5 = 0) {
+    cmd.type = type;
+    cmd.color = color;
+    cmd.args[0] = a0;
+    cmd.args[1] = a1;
+    cmd.args[2] = a2;
+    cmd.args[3] = a3;
+    cmd.args[4] = a4;
+    cmd.args[5] = a5;
+}
+
+bool RenderPipeline::fillScreen(uint16_t color) {
+    const Config& config = _lcd->hal().getConfig();
+    return fillRect(0, 0, config.width, config.height, color);
+}
+
+bool RenderPipeline::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    PipelineCommand cmd = {};
+    setCommand(cmd, CMD_FILL_RECT, color, x, y, w, h);
+    return push(cmd);
+}
+
+bool RenderPipeline::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    PipelineCommand cmd = {};
+    setCommand(cmd, CMD_PIXEL, color, x, y);
+    return push(cmd);
+}
+
+bool RenderPipeline::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    PipelineCommand cmd = {};
+    setCommand(cmd, CMD_LINE, color, x0, y0, x1, y1);
+    return push(cmd);
+}
+
+bool RenderPipeline::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    PipelineCommand cmd = {};
+    setCommand(cmd, CMD_RECT, color, x, y, w, h);
+    return push(cmd);
+}
+
+bool RenderPipeline::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    PipelineCommand cmd = {};
+    setCommand(cmd, CMD_CIRCLE, color, x0, y0, r);
+    return push(cmd);
+}
+
+bool RenderPipeline::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    PipelineCommand cmd = {};
+    setCommand(cmd, CMD_FILL_CIRCLE, color, x0, y0, r);
+    return push(cmd);
+}
+
+bool RenderPipeline::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    PipelineCommand cmd = {};
+    setCommand(cmd, CMD_FILL_TRIANGLE, color, x0, y0, x1, y1, x2, y2);
+    return push(cmd);
+}
+
+// Queue str with the text command cmd. A long string goes out in parts of
+// TEXT_MAX bytes, each in its own slot, that the render core joins before
+// cmd arrives with the rest.
+bool RenderPipeline::pushText(PipelineCommand& cmd, const char* str) {
+    if (!isRunning()) {
+        return false;
+    }
+
+    size_t len = strlen(str);
+    if (len > PipelineCommand::TEXT_MAX && len >= _text_size) {
+        // The render core only touches the buffer while parts are queued
+        sync();
+        char* text = (char*)realloc(_text, len + 1);
+        if (!text) {
+            printf("Failed to allocate pipeline text\n");
+            return false;
+        }
+        _text = text;
+        _text_size = len + 1;
+    }
+
+    while (len > PipelineCommand::TEXT_MAX) {
+        PipelineCommand part = {};
+        part.type = CMD_TEXT_PART;
+        memcpy(part.text, str, PipelineCommand::TEXT_MAX);
+        if (!push(part)) {
+            return false;
+        }
+        str += PipelineCommand::TEXT_MAX;
+        len -= PipelineCommand::TEXT_MAX;
+    }
+    memcpy(cmd.text, str, len + 1);
+    return push(cmd);
+}
+
+bool RenderPipeline::drawString(int16_t x, int16_t y, const char* str, uint16_t color, uint16_t bg, uint8_t size) {
+    PipelineCommand cmd = {};
+    setCommand(cmd, CMD_TEXT, color, x, y);
+    cmd.bg = bg;
+    cmd.size = size;
+    return pushText(cmd, str);
+}
+
+bool RenderPipeline::drawString(int16_t x, int16_t y, const char* str, const AAFont& font, uint16_t color, uint16_t bg) {
+    PipelineCommand cmd = {};
+    setCommand(cmd, CMD_TEXT_AA, color, x, y);
+    cmd.bg = bg;
+    cmd.font = &font;
+    return pushText(cmd, str);
+}
+
+bool RenderPipeline::drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* data, PixelOrder order) {
+    PipelineCommand cmd = {};
+    setCommand(cmd, CMD_IMAGE, 0, x, y, w, h);
+    cmd.data = data;
+    cmd.size = order;
+    return push(cmd);
+}
+
+bool RenderPipeline::flush() {
+    PipelineCommand cmd = {};
+    setCommand(cmd, CMD_FLUSH, 0);
+    return push(cmd);
+}
+
+bool RenderPipeline::call(PipelineFunc func, void* user) {
+    if (!func) {
+        return false;
+    }
+    PipelineCommand cmd = {};
+    setCommand(cmd, CMD_CALL, 0);
+    cmd.func = func;
+    cmd.user = user;
+    return push(cmd);
+}
+
+} // namespace st7789
@@ -0,0 +1,175 @@
+// Backend-independent half of the HAL - pixel packing, palette tables and
+// the segment fallback. Built into both the Pico and the host library; the
+// backends only move the packed chunks over the bus.
+
+#include "st7789_pixels.hpp"
+#include <cstring>
+
+namespace st7789 {
+
+// Source pixels in the two bus formats
+static inline uint16_t sourceRgb565(uint16_t v, PixelOrder order) {
+    if (order == PIXEL_PANEL) return (v << 8) | (v >> 8);
+    if (order == PIXEL_RGB444) return rgb444To565(v);
+    return v;
+}
+
+static inline uint16_t sourceRgb444(uint16_t v, PixelOrder order) {
+    if (order == PIXEL_RGB444) return v;
+    if (order == PIXEL_PANEL) v = (v << 8) | (v >> 8);
+    return rgb565To444(v);
+}
+
+size_t packPixels(uint16_t* chunk, size_t max_pixels, const PixelSource& src,
+                  bool rgb444, size_t& row, size_t& col) {
+    size_t count = 0;
+    while (count < max_pixels && row < src.height) {
+        size_t run = src.width - col;
+        if (run > max_pixels - count) {
+            run = max_pixels - count;
+        }
+
+        if (src.stream) {
+            // Decoded into the chunk, then converted in place
+            uint16_t* dst = &chunk[count];
+            size_t n = src.stream->read(dst, run);
+            if (n < run) {
+                memset(dst + n, 0, (run - n) * sizeof(uint16_t));
+            }
+            if (rgb444) {
+                for (size_t i = 0; i < run; i++) {
+                    dst[i] = rgb565To444(dst[i]);
+                }
+            } else {
+                uint8_t* bytes = (uint8_t*)dst;
+                for (size_t i = 0; i < run; i++) {
+                    uint16_t c = dst[i];
+                    bytes[i * 2] = c >> 8;
+                    bytes[i * 2 + 1] = c & 0xFF;
+                }
+            }
+        } else if (src.lut) {
+            // Palette indices, the table already holds the chunk words
+            const uint8_t bpp = src.bpp;
+            const uint8_t mask = (1 << bpp) - 1;
+            size_t bit = (src.first + col) * bpp;
+            const uint8_t* in = (const uint8_t*)src.data + row * src.stride + (bit >> 3);
+            int shift = 8 - bpp - (int)(bit & 7);
+            uint16_t* dst = &chunk[count];
+            for (size_t i = 0; i < run; i++) {
+                dst[i] = src.lut[(*in >> shift) & mask];
+                shift -= bpp;
+                if (shift < 0) {
+                    shift = 8 - bpp;
+                    in++;
+                }
+            }
+        } else if (rgb444) {
+            const uint16_t* src_ptr = (const uint16_t*)src.data + row * src.stride + col;
+            uint16_t* dst = &chunk[count];
+            for (size_t i = 0; i < run; i++) {
+                dst[i] = sourceRgb444(src_ptr[i], src.order);
+            }
+        } else {
+            // RGB565 is sent high byte first
+            const uint16_t* src_ptr = (const uint16_t*)src.data + row * src.stride + col;
+            uint8_t* dst = (uint8_t*)&chunk[count];
+            for (size_t i = 0; i < run; i++) {
+                uint16_t c = sourceRgb565(src_ptr[i], src.order);
+                dst[i * 2] = c >> 8;
+                dst[i * 2 + 1] = c & 0xFF;
+            }
+        }
+
+        count += run;
+        col += run;
+        if (col == src.width) {
+            col = 0;
+            row++;
+        }
+    }
+    return count;
+}
+
+void HAL::writePixel(uint16_t color) {
+    uint8_t data[2];
+    if (_config.color_mode == COLOR_RGB444) {
+        // One 12-bit frame and the pad nibble
+        uint16_t c = rgb565To444(color);
+        data[0] = c >> 4;
+        data[1] = (c & 0x0F) << 4;
+    } else {
+        data[0] = color >> 8;
+        data[1] = color & 0xFF;
+    }
+    writeDataBulk(data, 2);
+}
+
+bool HAL::writeDataDma(const uint16_t* data, size_t len) {
+    return writeDataDma(data, len, 1, len);
+}
+
+bool HAL::writeDataDma(const uint16_t* data, size_t width, size_t height, size_t stride) {
+    if (width == 0 || height == 0) return true;
+    if (_dma_pending) waitDmaIdle();
+
+    PixelSource src = { data, width, height, stride, PIXEL_NATIVE, nullptr, 0, 0, nullptr };
+    bool ok = writeConverted(src);
+    return ok && _dma_enabled && _dma_buffer && _dma_tx_channel >= 0;
+}
+
+bool HAL::writeIndexed(const uint8_t* data, size_t first, size_t width, size_t height, size_t stride,
+                       uint8_t bpp, const uint16_t* palette) {
+    if (width == 0 || height == 0) return true;
+    if (bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8) return false;
+    if (_dma_pending) waitDmaIdle();
+
+    // Palette as chunk words: RGB444 frames, or RGB565 swapped so the
+    // little-endian word puts the high byte first on the wire
+    bool rgb444 = (_config.color_mode == COLOR_RGB444);
+    uint16_t lut[256];
+    for (size_t i = 0; i < ((size_t)1 << bpp); i++) {
+        uint16_t c = palette[i];
+        lut[i] = rgb444 ? rgb565To444(c) : (uint16_t)((c << 8) | (c >> 8));
+    }
+
+    PixelSource src = { data, width, height, stride, PIXEL_NATIVE, lut, bpp, first, nullptr };
+    return writeConverted(src);
+}
+
+bool HAL::writeStream(PixelStream& stream, size_t width, size_t height) {
+    if (width == 0 || height == 0) return true;
+    if (_dma_pending) waitDmaIdle();
+
+    PixelSource src = { nullptr, width, height, width, PIXEL_NATIVE, nullptr, 0, 0, &stream };
+    return writeConverted(src);
+}
+
+// Blocking path of writeChainAsync()
+bool HAL::writeSegments(const BusSegment* segments, size_t count) {
+    bool ok = true;
+    beginTransaction();
+    for (size_t i = 0; i < count; i++) {
+        const BusSegment& seg = segments[i];
+        const uint8_t* bytes = (const uint8_t*)seg.data;
+        switch (seg.kind) {
+            case BusSegment::COMMAND:
+                for (size_t j = 0; j < seg.width; j++) {
+                    writeCommand(bytes[j]);
+                }
+                break;
+            case BusSegment::DATA:
+                writeDataBulk(bytes, seg.width);
+                break;
+            case BusSegment::PIXELS:
+                if (!writePixels((const uint16_t*)seg.data, seg.width, seg.height, seg.stride)) {
+                    ok = false;
+                }
+                break;
+        }
+    }
+    endTransaction();
+    return ok;
+}
+
+} // namespace st7789
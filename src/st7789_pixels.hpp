@@ -0,0 +1,18 @@
+#pragma once
+
+// Internal to the HAL backends - pixel packing shared by st7789_hal.cpp and
+// st7789_hal_host.cpp, so the host build runs the conversion code that ships.
+
+#include <cstdint>
+#include <cstddef>
+#include "st7789_hal.hpp"
+
+namespace st7789 {
+
+// Pack pixels of a strided source into a DMA chunk in the bus format:
+// RGB565 bytes in panel order, or one word per 12-bit RGB444 frame.
+// Advances row/col and returns the number of pixels packed.
+size_t packPixels(uint16_t* chunk, size_t max_pixels, const PixelSource& src,
+                  bool rgb444, size_t& row, size_t& col);
+
+} // namespace st7789
@@ -0,0 +1,295 @@
+#include "st7789_sprite.hpp"
+#include "st7789.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace st7789 {
+
+SpriteLayer::SpriteLayer(ST7789& lcd) :
+    _lcd(&lcd),
+    _sprites(nullptr),
+    _max_sprites(0),
+    _count(0),
+    _buffer(nullptr),
+    _buffer_pixels(0),
+    _bg_type(BG_SOLID),
+    _bg_color(BLACK),
+    _bg_image(nullptr),
+    _bg_width(0),
+    _bg_height(0),
+    _bg_func(nullptr),
+    _bg_user(nullptr),
+    _pixels_drawn(0),
+    _windows(0) {
+}
+
+SpriteLayer::~SpriteLayer() {
+    end();
+}
+
+bool SpriteLayer::begin(uint8_t max_sprites, size_t buffer_pixels) {
+    end();
+    if (max_sprites == 0) {
+        return false;
+    }
+
+    // A band is at least one row in either orientation
+    const Config& config = _lcd->hal().getConfig();
+    size_t row = config.width > config.height ? config.width : config.height;
+    if (buffer_pixels < row) {
+        buffer_pixels = row;
+    }
+
+    _sprites = (Sprite*)malloc(max_sprites * sizeof(Sprite));
+    _buffer = (uint16_t*)malloc(buffer_pixels * sizeof(uint16_t));
+    if (!_sprites || !_buffer) {
+        printf("Failed to allocate sprite layer\n");
+        end();
+        return false;
+    }
+    _max_sprites = max_sprites;
+    _buffer_pixels = buffer_pixels;
+    _count = 0;
+    return true;
+}
+
+void SpriteLayer::end() {
+    free(_sprites);
+    free(_buffer);
+    _sprites = nullptr;
+    _buffer = nullptr;
+    _max_sprites = 0;
+    _buffer_pixels = 0;
+    _count = 0;
+}
+
+void SpriteLayer::setBackground(uint16_t color) {
+    _bg_type = BG_SOLID;
+    _bg_color = color;
+}
+
+void SpriteLayer::setBackground(const uint16_t* image, uint16_t w, uint16_t h, uint16_t color) {
+    _bg_type = image ? BG_IMAGE : BG_SOLID;
+    _bg_image = image;
+    _bg_width = w;
+    _bg_height = h;
+    _bg_color = color;
+}
+
+void SpriteLayer::setBackground(SpriteBackgroundFunc func, void* user) {
+    _bg_type = func ? BG_CALLBACK : BG_SOLID;
+    _bg_func = func;
+    _bg_user = user;
+}
+
+SpriteLayer::Sprite* SpriteLayer::sprite(int8_t id) {
+    return (id >= 0 && id < _count) ? &_sprites[id] : nullptr;
+}
+
+int8_t SpriteLayer::addSprite(const uint16_t* image, uint16_t w, uint16_t h) {
+    if (!_sprites || _count >= _max_sprites || _count >= 127) {
+        return -1;
+    }
+
+    Sprite& s = _sprites[_count];
+    s.image = image;
+    s.mask = nullptr;
+    s.width = w;
+    s.height = h;
+    s.x = 0;
+    s.y = 0;
+    s.key = 0;
+    s.use_key = false;
+    s.visible = false;
+    s.dirty = false;
+    s.drawn = Rect();
+    return _count++;
+}
+
+void SpriteLayer::markDirty(Sprite& s) {
+    // A hidden sprite has nothing on screen to refresh
+    if (s.visible || !s.drawn.isEmpty()) {
+        s.dirty = true;
+    }
+}
+
+void SpriteLayer::setImage(int8_t id, const uint16_t* image, uint16_t w, uint16_t h) {
+    Sprite* s = sprite(id);
+    if (!s) return;
+    s->image = image;
+    s->width = w;
+    s->height = h;
+    markDirty(*s);
+}
+
+void SpriteLayer::setColorKey(int8_t id, uint16_t key) {
+    Sprite* s = sprite(id);
+    if (!s) return;
+    s->key = key;
+    s->use_key = true;
+    s->mask = nullptr;
+    markDirty(*s);
+}
+
+void SpriteLayer::setMask(int8_t id, const uint8_t* mask) {
+    Sprite* s = sprite(id);
+    if (!s) return;
+    s->mask = mask;
+    s->use_key = false;
+    markDirty(*s);
+}
+
+void SpriteLayer::clearTransparency(int8_t id) {
+    Sprite* s = sprite(id);
+    if (!s) return;
+    s->mask = nullptr;
+    s->use_key = false;
+    markDirty(*s);
+}
+
+void SpriteLayer::moveTo(int8_t id, int16_t x, int16_t y) {
+    Sprite* s = sprite(id);
+    if (!s || (s->x == x && s->y == y)) return;
+    s->x = x;
+    s->y = y;
+    markDirty(*s);
+}
+
+void SpriteLayer::show(int8_t id, bool visible) {
+    Sprite* s = sprite(id);
+    if (!s || s->visible == visible) return;
+    s->visible = visible;
+    s->dirty = true;
+}
+
+int16_t SpriteLayer::spriteX(int8_t id) const {
+    return (id >= 0 && id < _count) ? _sprites[id].x : 0;
+}
+
+int16_t SpriteLayer::spriteY(int8_t id) const {
+    return (id >= 0 && id < _count) ? _sprites[id].y : 0;
+}
+
+// Visible part of a sprite on screen, empty if hidden
+Rect SpriteLayer::spriteBounds(const Sprite& s) const {
+    if (!s.visible || !s.image) {
+        return Rect();
+    }
+    const Config& config = _lcd->hal().getConfig();
+    Rect screen(0, 0, config.width, config.height);
+    return Rect(s.x, s.y, s.width, s.height).intersect(screen);
+}
+
+// Background and all sprites overlapping r, row-major into dst
+void SpriteLayer::composite(const Rect& r, uint16_t* dst) {
+    Rect bg_area(0, 0, _bg_width, _bg_height);
+    for (int16_t j = 0; j < r.h; j++) {
+        uint16_t* row = dst + (size_t)j * r.w;
+        int16_t y = r.y + j;
+
+        if (_bg_type == BG_CALLBACK) {
+            _bg_func(r.x, y, r.w, row, _bg_user);
+            continue;
+        }
+        for (int16_t i = 0; i < r.w; i++) {
+            row[i] = _bg_color;
+        }
+        if (_bg_type == BG_IMAGE) {
+            Rect part = Rect(r.x, y, r.w, 1).intersect(bg_area);
+            if (!part.isEmpty()) {
+                memcpy(row + (part.x - r.x), _bg_image + (size_t)y * _bg_width + part.x,
+                       part.w * sizeof(uint16_t));
+            }
+        }
+    }
+
+    for (uint8_t n = 0; n < _count; n++) {
+        const Sprite& s = _sprites[n];
+        if (!s.visible || !s.image) continue;
+        Rect part = Rect(s.x, s.y, s.width, s.height).intersect(r);
+        if (part.isEmpty()) continue;
+
+        int16_t sx = part.x - s.x;
+        size_t mask_stride = (s.width + 7) / 8;
+        for (int16_t j = 0; j < part.h; j++) {
+            int16_t sy = part.y - s.y + j;
+            const uint16_t* src = s.image + (size_t)sy * s.width + sx;
+            uint16_t* out = dst + (size_t)(part.y - r.y + j) * r.w + (part.x - r.x);
+
+            if (s.mask) {
+                const uint8_t* bits = s.mask + (size_t)sy * mask_stride;
+                for (int16_t i = 0; i < part.w; i++) {
+                    int16_t b = sx + i;
+                    if (bits[b >> 3] & (0x80 >> (b & 7))) {
+                        out[i] = src[i];
+                    }
+                }
+            } else if (s.use_key) {
+                for (int16_t i = 0; i < part.w; i++) {
+                    if (src[i] != s.key) {
+                        out[i] = src[i];
+                    }
+                }
+            } else {
+                memcpy(out, src, part.w * sizeof(uint16_t));
+            }
+        }
+    }
+}
+
+// Composite and send r, one window per band of rows that fits the buffer
+void SpriteLayer::drawArea(const Rect& r) {
+    if (r.isEmpty()) return;
+
+    int16_t band = _buffer_pixels / r.w;
+    for (int16_t y = r.y; y < r.y + r.h; y += band) {
+        int16_t h = (r.y + r.h - y < band) ? r.y + r.h - y : band;
+        Rect part(r.x, y, r.w, h);
+        composite(part, _buffer);
+        _lcd->drawImage(part.x, part.y, part.w, part.h, _buffer);
+        _pixels_drawn += (uint32_t)part.w * part.h;
+        _windows++;
+    }
+}
+
+void SpriteLayer::update() {
+    if (!_buffer) return;
+
+    _lcd->hal().beginTransaction();
+    for (uint8_t n = 0; n < _count; n++) {
+        Sprite& s = _sprites[n];
+        if (!s.dirty) continue;
+        s.dirty = false;
+
+        // Where it was and where it is now. Sprites drawn later in this
+        // loop are already composited at their new place.
+        Rect old = s.drawn;
+        s.drawn = spriteBounds(s);
+        Rect area = old.unite(s.drawn);
+        if (area.area() > old.area() + s.drawn.area()) {
+            // Far apart, the union would mostly resend background
+            drawArea(old);
+            drawArea(s.drawn);
+        } else {
+            drawArea(area);
+        }
+    }
+    _lcd->hal().endTransaction();
+}
+
+void SpriteLayer::redraw() {
+    if (!_buffer) return;
+
+    const Config& config = _lcd->hal().getConfig();
+    _lcd->hal().beginTransaction();
+    drawArea(Rect(0, 0, config.width, config.height));
+    _lcd->hal().endTransaction();
+
+    for (uint8_t n = 0; n < _count; n++) {
+        _sprites[n].dirty = false;
+        _sprites[n].drawn = spriteBounds(_sprites[n]);
+    }
+}
+
+} // namespace st7789
@@ -0,0 +1,293 @@
+#include "st7789_terminal.hpp"
+#include "st7789.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdarg>
+
+namespace st7789 {
+
+// RGB565 values of the default palette
+static const uint16_t default_palette[Terminal::PALETTE_SIZE] = {
+    0x0000, 0xA800, 0x0540, 0xAD40, 0x0015, 0xA815, 0x0555, 0xAD55,
+    0x52AA, 0xFAAA, 0x57EA, 0xFFEA, 0x52BF, 0xFABF, 0x57FF, 0xFFFF
+};
+
+Terminal::Terminal(ST7789& lcd) :
+    _lcd(&lcd),
+    _cells(nullptr),
+    _dirty(nullptr),
+    _run(nullptr),
+    _cols(0),
+    _rows(0),
+    _first_row(0),
+    _size(1),
+    _top(0),
+    _cursor_col(0),
+    _cursor_row(0),
+    _attr(TERM_WHITE),
+    _hw_scroll(false),
+    _pending_scroll(0),
+    _cells_drawn(0),
+    _windows(0) {
+    memcpy(_palette, default_palette, sizeof(_palette));
+}
+
+Terminal::~Terminal() {
+    end();
+}
+
+bool Terminal::begin(uint8_t size, int16_t top, int16_t height) {
+    end();
+
+    const Config& config = _lcd->hal().getConfig();
+    if (size == 0 || top < 0 || top >= config.height) {
+        return false;
+    }
+    if (height <= 0 || top + height > config.height) {
+        height = config.height - top;
+    }
+
+    _size = size;
+    _top = top;
+    _cols = config.width / (6 * size);
+    _rows = height / (8 * size);
+    if (_cols == 0 || _rows == 0) {
+        return false;
+    }
+
+    size_t cells = (size_t)_cols * _rows;
+    _cells = (Cell*)malloc(cells * sizeof(Cell));
+    _dirty = (uint8_t*)calloc((cells + 7) / 8, 1);
+    _run = (char*)malloc(_cols + 1);
+    if (!_cells || !_dirty || !_run) {
+        ::printf("Failed to allocate terminal cells\n");
+        end();
+        return false;
+    }
+
+    _first_row = 0;
+    _cursor_col = 0;
+    _cursor_row = 0;
+    _pending_scroll = 0;
+    for (size_t i = 0; i < cells; i++) {
+        _cells[i].ch = ' ';
+        _cells[i].attr = _attr;
+    }
+
+    // The scroll area spans the full width, the console rows scroll and
+    // everything else stays fixed. A framebuffer is sent by memory rows,
+    // so it falls back to repainting.
+    int16_t area = _rows * 8 * size;
+    _hw_scroll = !_lcd->isFrameBufferEnabled() &&
+                 _lcd->setScrollArea(top, config.height - top - area);
+
+    // Start from a blank area, the grid already matches it
+    _lcd->fillRect(0, top, config.width, area, _palette[_attr >> 4]);
+    return true;
+}
+
+void Terminal::end() {
+    if (_hw_scroll) {
+        _lcd->resetScroll();
+        _hw_scroll = false;
+    }
+    free(_cells);
+    free(_dirty);
+    free(_run);
+    _cells = nullptr;
+    _dirty = nullptr;
+    _run = nullptr;
+    _cols = 0;
+    _rows = 0;
+}
+
+size_t Terminal::cellIndex(uint16_t col, uint16_t row) const {
+    uint16_t ring_row = _first_row + row;
+    if (ring_row >= _rows) {
+        ring_row -= _rows;
+    }
+    return (size_t)ring_row * _cols + col;
+}
+
+void Terminal::setCell(uint16_t col, uint16_t row, char c, uint8_t attr, bool force) {
+    size_t i = cellIndex(col, row);
+    Cell& cell = _cells[i];
+
+    // Rewriting what is already shown costs nothing
+    if (!force && cell.ch == c && cell.attr == attr) {
+        return;
+    }
+    cell.ch = c;
+    cell.attr = attr;
+    _dirty[i >> 3] |= 1 << (i & 7);
+}
+
+void Terminal::putChar(char c) {
+    if (!_cells) return;
+
+    switch (c) {
+        case '\n':
+            newLine();
+            return;
+        case '\r':
+            _cursor_col = 0;
+            return;
+        case '\b':
+            if (_cursor_col > 0) {
+                _cursor_col--;
+            }
+            return;
+        case '\t':
+            do {
+                putChar(' ');
+            } while (_cursor_col % 8 != 0 && _cursor_col < _cols);
+            return;
+        default:
+            break;
+    }
+
+    // Wrap before writing so a full line does not leave an empty one below
+    if (_cursor_col >= _cols) {
+        newLine();
+    }
+    setCell(_cursor_col, _cursor_row, c, _attr, false);
+    _cursor_col++;
+}
+
+void Terminal::print(const char* str) {
+    while (*str) {
+        putChar(*str++);
+    }
+}
+
+void Terminal::printf(const char* format, ...) {
+    char buffer[128];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    print(buffer);
+}
+
+void Terminal::newLine() {
+    _cursor_col = 0;
+    if (_cursor_row + 1 < _rows) {
+        _cursor_row++;
+    } else {
+        scrollUp();
+    }
+}
+
+void Terminal::scrollUp() {
+    // The ring moves by one row, the old top row becomes the new bottom one
+    _first_row = (_first_row + 1 == _rows) ? 0 : _first_row + 1;
+
+    if (_hw_scroll) {
+        // The panel moves the other lines, only the new one is drawn
+        _pending_scroll++;
+    } else {
+        // Every line moved on screen
+        memset(_dirty, 0xFF, ((size_t)_cols * _rows + 7) / 8);
+    }
+
+    // Whatever the panel shows in the new line is stale
+    for (uint16_t col = 0; col < _cols; col++) {
+        setCell(col, _rows - 1, ' ', _attr, true);
+    }
+}
+
+void Terminal::clear() {
+    if (!_cells) return;
+    for (uint16_t row = 0; row < _rows; row++) {
+        for (uint16_t col = 0; col < _cols; col++) {
+            setCell(col, row, ' ', _attr, false);
+        }
+    }
+    _cursor_col = 0;
+    _cursor_row = 0;
+}
+
+void Terminal::setCursor(uint16_t col, uint16_t row) {
+    _cursor_col = (col < _cols) ? col : _cols;
+    _cursor_row = (row < _rows) ? row : _rows - 1;
+}
+
+void Terminal::setColor(uint8_t fg, uint8_t bg) {
+    _attr = (fg & 0x0F) | ((bg & 0x0F) << 4);
+}
+
+void Terminal::setPalette(uint8_t index, uint16_t color) {
+    if (index >= PALETTE_SIZE || _palette[index] == color) return;
+    _palette[index] = color;
+
+    // Cells in that color are redrawn on the next update
+    for (uint16_t row = 0; row < _rows; row++) {
+        for (uint16_t col = 0; col < _cols; col++) {
+            const Cell& cell = _cells[cellIndex(col, row)];
+            if ((cell.attr & 0x0F) == index || (cell.attr >> 4) == index) {
+                setCell(col, row, cell.ch, cell.attr, true);
+            }
+        }
+    }
+}
+
+void Terminal::update() {
+    if (!_cells) return;
+
+    const int16_t cell_w = 6 * _size;
+    const int16_t cell_h = 8 * _size;
+    _lcd->hal().beginTransaction();
+
+    // One scroll command for all lines added since the last update
+    if (_pending_scroll > 0) {
+        _lcd->scroll((_pending_scroll % _rows) * cell_h);
+        _pending_scroll = 0;
+    }
+
+    for (uint16_t row = 0; row < _rows; row++) {
+        size_t base = cellIndex(0, row);
+        uint16_t col = 0;
+        while (col < _cols) {
+            size_t i = base + col;
+            if (!(_dirty[i >> 3] & (1 << (i & 7)))) {
+                col++;
+                continue;
+            }
+
+            // Run of dirty cells sharing the colors, one window
+            uint8_t attr = _cells[i].attr;
+            uint16_t start = col;
+            bool blank = true;
+            while (col < _cols) {
+                i = base + col;
+                if (!(_dirty[i >> 3] & (1 << (i & 7))) || _cells[i].attr != attr) {
+                    break;
+                }
+                _dirty[i >> 3] &= ~(1 << (i & 7));
+                _run[col - start] = _cells[i].ch;
+                if (_cells[i].ch != ' ') {
+                    blank = false;
+                }
+                col++;
+            }
+            _run[col - start] = '\0';
+
+            uint16_t fg = _palette[attr & 0x0F];
+            uint16_t bg = _palette[attr >> 4];
+            int16_t x = start * cell_w;
+            int16_t y = _top + row * cell_h;
+            if (blank || fg == bg) {
+                _lcd->fillRect(x, y, (col - start) * cell_w, cell_h, bg);
+            } else {
+                _lcd->drawString(x, y, _run, fg, bg, _size);
+            }
+            _cells_drawn += col - start;
+            _windows++;
+        }
+    }
+
+    _lcd->hal().endTransaction();
+}
+
+} // namespace st7789
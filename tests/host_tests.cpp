@@ -0,0 +1,1023 @@
+// Host pixel checks - draws through the library and compares what the
+// emulated panel shows against a reference. Exits non-zero on a mismatch.
+//
+// Usage: host_tests
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include "st7789.hpp"
+
+struct TestCase {
+    const char* name;
+    bool (*run)();
+};
+
+static const int16_t WIDTH = 240;
+static const int16_t HEIGHT = 320;
+
+// Expected screen contents, row-major
+static uint16_t reference[WIDTH * HEIGHT];
+
+static bool beginDisplay(st7789::ST7789& lcd) {
+    st7789::Config config;
+    config.width = WIDTH;
+    config.height = HEIGHT;
+    config.dma.enabled = true;
+    return lcd.begin(config);
+}
+
+// Pixels of the panel that differ from the reference in the bits of mask,
+// the first few are printed
+static int compareReference(st7789::ST7789& lcd, const char* what, uint16_t mask = 0xFFFF) {
+    st7789::Emulator& emu = lcd.hal().emulator();
+    int bad = 0;
+    for (int16_t y = 0; y < HEIGHT; y++) {
+        for (int16_t x = 0; x < WIDTH; x++) {
+            uint16_t got = emu.displayPixel(x, y);
+            uint16_t want = reference[y * WIDTH + x];
+            if ((got & mask) != (want & mask) && bad++ < 5) {
+                printf("  %s: pixel %d,%d is %04X, expected %04X\n", what, x, y, got, want);
+            }
+        }
+    }
+    return bad;
+}
+
+// Pixels that differ between two panels
+static int compareDisplays(st7789::ST7789& a, st7789::ST7789& b, const char* what, uint16_t mask = 0xFFFF) {
+    for (int16_t y = 0; y < HEIGHT; y++) {
+        for (int16_t x = 0; x < WIDTH; x++) {
+            reference[y * WIDTH + x] = b.hal().emulator().displayPixel(x, y);
+        }
+    }
+    return compareReference(a, what, mask);
+}
+
+// Per-pixel Bresenham the span rasterizer replaced, clipped to the screen
+static void referenceLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+    if (x0 > x1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+
+    int16_t dx = x1 - x0;
+    int16_t dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    int16_t ystep = (y0 < y1) ? 1 : -1;
+    for (; x0 <= x1; x0++) {
+        int16_t px = steep ? y0 : x0;
+        int16_t py = steep ? x0 : y0;
+        if (px >= 0 && px < WIDTH && py >= 0 && py < HEIGHT) {
+            reference[py * WIDTH + px] = color;
+        }
+        err -= dy;
+        if (err < 0) {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+// 3000 random lines, many with endpoints off screen, on the panel and
+// into a framebuffer
+static bool testLines() {
+    static st7789::ST7789 lcd;
+    if (!beginDisplay(lcd)) {
+        return false;
+    }
+
+    int bad = 0;
+    for (int target = 0; target < 2; target++) {
+        if (target == 1) {
+            lcd.enableFrameBuffer();
+        }
+        lcd.fillScreen(st7789::BLACK);
+        for (int i = 0; i < WIDTH * HEIGHT; i++) {
+            reference[i] = st7789::BLACK;
+        }
+
+        srand(1234);
+        for (int i = 0; i < 3000; i++) {
+            int16_t x0 = rand() % 440 - 100;
+            int16_t y0 = rand() % 520 - 100;
+            int16_t x1 = rand() % 440 - 100;
+            int16_t y1 = rand() % 520 - 100;
+            uint16_t color = (uint16_t)rand() | 1;
+            lcd.drawLine(x0, y0, x1, y1, color);
+            referenceLine(x0, y0, x1, y1, color);
+
+            if (i % 100 == 99) {
+                if (target == 1) {
+                    lcd.flush();
+                }
+                bad += compareReference(lcd, target ? "framebuffer lines" : "panel lines");
+            }
+        }
+        lcd.disableFrameBuffer();
+    }
+    return bad == 0;
+}
+
+// Gauge cluster, raster heavy with text and images
+static const uint16_t test_image[16 * 16] = {
+#define ROW(c) c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c
+    ROW(0xF800), ROW(0xF800), ROW(0xF800), ROW(0xF800),
+    ROW(0x07E0), ROW(0x07E0), ROW(0x07E0), ROW(0x07E0),
+    ROW(0x001F), ROW(0x001F), ROW(0x001F), ROW(0x001F),
+    ROW(0xFFFF), ROW(0xFFFF), ROW(0xFFFF), ROW(0xFFFF)
+#undef ROW
+};
+
+template <typename Target>
+static void drawGauges(Target& t, int frame) {
+    char text[24];
+    t.fillScreen(0x0008);
+    for (int i = 0; i < 6; i++) {
+        int16_t cx = 60 + (i % 2) * 120;
+        int16_t cy = 55 + (i / 2) * 105;
+        t.fillCircle(cx, cy, 50, 0x2104);
+        t.fillCircle(cx, cy, 42, 0x0008);
+        t.fillTriangle(cx, cy - 40, cx - 4 + frame, cy, cx + 4 + frame, cy, st7789::RED);
+        t.drawLine(cx - 45, cy + 30, cx + 45, cy + 20 - frame, st7789::YELLOW);
+        snprintf(text, sizeof(text), "%d.%d km/h", 80 + frame, i);
+        t.drawString(cx - 30, cy + 8, text, st7789::font_sans_14, st7789::WHITE, 0x0008);
+        t.drawString(cx - 18, cy - 24, "RPM", st7789::WHITE, 0x0008, 2);
+        t.drawImage(cx - 8 + frame, cy + 30, 16, 16, test_image);
+    }
+}
+
+// Every primitive at odd positions and widths, images clipped at each
+// screen edge. Only uses calls Graphics has, so bands can replay it.
+template <typename Target>
+static void drawMixed(Target& t) {
+    static const uint16_t colors[4] = { st7789::RED, st7789::GREEN, 0x7BEF, st7789::CYAN };
+    t.fillRect(0, 0, WIDTH, HEIGHT, 0x0841);
+    for (int i = 0; i < 8; i++) {
+        t.fillRect(3 + i * 29, 5 + i, 1 + i * 4, 17, colors[i % 4]);
+        t.drawPixel(7 + i * 31, 27, st7789::WHITE);
+        t.drawFastHLine(1 + i * 3, 31 + i, 2 * i + 1, st7789::YELLOW);
+    }
+    t.fillCircle(61, 90, 33, 0xA145);
+    t.drawCircle(171, 95, 41, st7789::MAGENTA);
+    t.fillTriangle(11, 151, 117, 131, 63, 201, 0x3A9F);
+    t.drawTriangle(131, 149, 229, 171, 151, 213, st7789::WHITE);
+    t.drawLine(-20, 300, 259, 140, st7789::YELLOW);
+    t.drawRect(121, 31, 37, 23, st7789::GREEN);
+    t.drawString(5, 215, "Odd 13579", st7789::WHITE, 0x0010, 1);
+    t.drawString(73, 223, "x3", st7789::BLACK, st7789::YELLOW, 3);
+    t.drawString(9, 251, "AA text, 42%", st7789::font_sans_14, st7789::WHITE, 0x0841);
+    t.drawImage(-5, 230, 16, 16, test_image);
+    t.drawImage(WIDTH - 9, 250, 16, 16, test_image);
+    t.drawImage(101, 240, 15, 17, test_image);
+    t.drawImage(151, -7, 16, 16, test_image);
+    t.drawImage(181, HEIGHT - 7, 16, 16, test_image);
+}
+
+static void drawMixedBand(st7789::Graphics& gfx, void* user) {
+    (void)user;
+    drawMixed(gfx);
+}
+
+// Display list tiles, serial and on both cores, against direct drawing
+static bool testDisplayList() {
+    static st7789::ST7789 lcd;
+    static st7789::ST7789 direct;
+    if (!beginDisplay(lcd) || !beginDisplay(direct)) {
+        return false;
+    }
+
+    int bad = 0;
+    for (int parallel = 0; parallel < 2; parallel++) {
+        st7789::DisplayList list(lcd);
+        list.begin(128, 512);
+        if (parallel) {
+            list.enableParallel(4);
+        }
+        for (int frame = 0; frame < 8; frame++) {
+            list.clear();
+            drawGauges(list, frame);
+            if (!list.render() || list.overflowed()) {
+                printf("  render failed\n");
+                return false;
+            }
+            drawGauges(direct, frame);
+            bad += compareDisplays(lcd, direct, parallel ? "parallel tiles" : "serial tiles");
+        }
+        if (parallel && list.tilesRasterized(1) == 0) {
+            printf("  note: core 1 rasterized no tiles\n");
+        }
+    }
+    return bad == 0;
+}
+
+// Scene drawn into a scrolled area against the same scene unscrolled, in
+// both rotations that can scroll
+static bool testScroll() {
+    static st7789::ST7789 lcd;
+    static st7789::ST7789 direct;
+    if (!beginDisplay(lcd) || !beginDisplay(direct)) {
+        return false;
+    }
+
+    int bad = 0;
+    const st7789::Rotation rotations[] = { st7789::ROTATION_0, st7789::ROTATION_180 };
+    for (st7789::Rotation rotation : rotations) {
+        // begin() leaves the panel at ROTATION_0
+        lcd.setRotation(rotation);
+        direct.setRotation(rotation);
+        if (!lcd.setScrollArea(20, 40)) {
+            printf("  setScrollArea failed\n");
+            return false;
+        }
+        lcd.scroll(37);
+        for (int frame = 0; frame < 2; frame++) {
+            drawGauges(lcd, frame);
+            drawGauges(direct, frame);
+            bad += compareDisplays(lcd, direct, rotation == st7789::ROTATION_0 ? "scroll 0" : "scroll 180");
+            lcd.scroll(-101);
+        }
+        lcd.resetScroll();
+    }
+    return bad == 0;
+}
+
+// Blobs made by tools/image_encode.py from pattern.png, which holds
+// patternPixel(); regenerate with
+//   image_encode.py tests/pattern.png pattern_qoi --codec qoi -o tests/pattern_qoi.cpp
+extern const uint8_t pattern_qoi[];
+extern const size_t pattern_qoi_size;
+extern const uint8_t pattern_rle[];
+extern const size_t pattern_rle_size;
+
+static const int16_t PATTERN_WIDTH = 24;
+static const int16_t PATTERN_HEIGHT = 16;
+
+// Runs, small and large deltas, repeated colors and noise in bands of
+// four rows, so every QOI op occurs
+static uint16_t patternPixel(int16_t x, int16_t y) {
+    static const uint16_t palette[4] = { 0xF800, 0x07E0, 0x001F, 0xFFE0 };
+    switch (y / 4) {
+        case 0:
+            return 0x2104;
+        case 1:
+            return ((x / 2) << 11) | ((x / 2 + y) << 5) | 10;
+        case 2:
+            return (x << 11) | ((x * 2 + y) << 5) | (31 - x);
+        default:
+            if ((x + y) % 3 == 0) {
+                return (uint16_t)(x * 40503 * (y + 1));
+            }
+            return palette[(x + y) % 4];
+    }
+}
+
+// Pixels of a window read through the decoder that differ from the pattern
+static int checkDecoder(const uint8_t* blob, size_t size, int16_t x, int16_t y, int16_t w, int16_t h) {
+    st7789::ImageDecoder decoder;
+    if (!decoder.begin(blob, size) || decoder.width() != PATTERN_WIDTH ||
+        decoder.height() != PATTERN_HEIGHT) {
+        printf("  bad image header\n");
+        return 1;
+    }
+    decoder.setWindow(x, y, w, h);
+
+    uint16_t pixels[PATTERN_WIDTH * PATTERN_HEIGHT];
+    size_t count = decoder.read(pixels, sizeof(pixels) / sizeof(pixels[0]));
+    if (count != (size_t)w * h) {
+        printf("  read %u pixels of a %dx%d window\n", (unsigned)count, w, h);
+        return 1;
+    }
+    int bad = 0;
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            uint16_t want = patternPixel(x + i, y + j);
+            if (pixels[j * w + i] != want && bad++ < 5) {
+                printf("  window pixel %d,%d is %04X, expected %04X\n",
+                       x + i, y + j, pixels[j * w + i], want);
+            }
+        }
+    }
+    return bad;
+}
+
+// Encoder and decoder agree on both codecs, for the whole image, a window
+// and an image clipped by the screen edge
+static bool testCompressedImages() {
+    static st7789::ST7789 lcd;
+    if (!beginDisplay(lcd)) {
+        return false;
+    }
+
+    struct Blob {
+        const uint8_t* data;
+        size_t size;
+    };
+    const Blob blobs[] = {
+        { pattern_qoi, pattern_qoi_size },
+        { pattern_rle, pattern_rle_size },
+    };
+
+    int bad = 0;
+    for (const Blob& blob : blobs) {
+        bad += checkDecoder(blob.data, blob.size, 0, 0, PATTERN_WIDTH, PATTERN_HEIGHT);
+        bad += checkDecoder(blob.data, blob.size, 5, 3, 13, 11);
+
+        lcd.fillScreen(st7789::BLACK);
+        for (int i = 0; i < WIDTH * HEIGHT; i++) {
+            reference[i] = st7789::BLACK;
+        }
+        const int16_t xs[] = { 10, WIDTH - 7 };
+        const int16_t ys[] = { 20, -5 };
+        for (int n = 0; n < 2; n++) {
+            if (!lcd.drawImageCompressed(xs[n], ys[n], blob.data, blob.size)) {
+                printf("  drawImageCompressed failed\n");
+                return false;
+            }
+            for (int16_t y = 0; y < PATTERN_HEIGHT; y++) {
+                for (int16_t x = 0; x < PATTERN_WIDTH; x++) {
+                    int16_t px = xs[n] + x;
+                    int16_t py = ys[n] + y;
+                    if (px >= 0 && px < WIDTH && py >= 0 && py < HEIGHT) {
+                        reference[py * WIDTH + px] = patternPixel(x, y);
+                    }
+                }
+            }
+        }
+        bad += compareReference(lcd, blob.data[2] == st7789::IMAGE_QOI ? "qoi image" : "rle image");
+    }
+    return bad == 0;
+}
+
+// RGB444 shows the RGB565 scene with the low bit of each channel dropped,
+// drawn directly, flushed from a framebuffer with odd-sized dirty areas
+// and rendered in bands
+static bool testRgb444() {
+    static st7789::ST7789 lcd;
+    static st7789::ST7789 direct;
+    if (!beginDisplay(lcd) || !beginDisplay(direct)) {
+        return false;
+    }
+    lcd.setColorMode(st7789::COLOR_RGB444);
+
+    const uint16_t mask = 0xF79E;
+    int bad = 0;
+    drawMixed(lcd);
+    drawMixed(direct);
+    bad += compareDisplays(lcd, direct, "rgb444 direct", mask);
+
+    lcd.fillScreen(st7789::BLACK);
+    if (!lcd.enableFrameBuffer()) {
+        return false;
+    }
+    drawMixed(lcd);
+    lcd.flush();
+    for (int i = 0; i < 5; i++) {
+        lcd.fillRect(17 + i * 41, 61 + i * 7, 3 + i * 2, 5 + i, 0xFC1F);
+        direct.fillRect(17 + i * 41, 61 + i * 7, 3 + i * 2, 5 + i, 0xFC1F);
+    }
+    lcd.drawImage(203, 33, 13, 7, test_image);
+    direct.drawImage(203, 33, 13, 7, test_image);
+    lcd.flush();
+    lcd.disableFrameBuffer();
+    bad += compareDisplays(lcd, direct, "rgb444 framebuffer", mask);
+
+    lcd.fillScreen(st7789::BLACK);
+    direct.fillScreen(st7789::BLACK);
+    st7789::BandRenderer bands(lcd);
+    if (!bands.begin(16) || !bands.render(drawMixedBand)) {
+        printf("  band render failed\n");
+        return false;
+    }
+    drawMixed(direct);
+    bad += compareDisplays(lcd, direct, "rgb444 bands", mask);
+    return bad == 0;
+}
+
+// Scene in palette colors only, each changed by jitter. Odd positions and
+// widths start and end spans in the middle of index bytes.
+template <typename Target>
+static void drawPalette(Target& t, const uint16_t* palette, int colors, uint16_t jitter, int stage) {
+    auto color = [&](int i) { return (uint16_t)(palette[i % colors] ^ jitter); };
+    static uint16_t image[13 * 11];
+    for (int i = 0; i < 13 * 11; i++) {
+        image[i] = color(i / 5 + 1);
+    }
+
+    if (stage == 0) {
+        t.fillRect(0, 0, WIDTH, HEIGHT, color(0));
+        for (int i = 0; i < 12; i++) {
+            t.fillRect(1 + i * 19, 3 + i * 5, 1 + i, 9, color(i + 1));
+        }
+        t.fillCircle(73, 121, 31, color(3));
+        t.drawCircle(163, 117, 37, color(5));
+        t.fillTriangle(9, 181, 107, 167, 51, 233, color(6));
+        t.drawLine(3, 301, 237, 189, color(7));
+        t.drawString(7, 251, "Palette 4bpp", color(1), color(0), 1);
+        t.drawString(33, 271, "x2", color(2), color(9), 2);
+        t.drawImage(-3, 141, 13, 11, image);
+        t.drawImage(WIDTH - 5, 289, 13, 11, image);
+        t.drawImage(119, 211, 13, 11, image);
+    } else {
+        // Small dirty areas for a second flush
+        t.fillRect(131, 7, 3, 5, color(4));
+        t.drawPixel(201, 77, color(1));
+        t.drawImage(187, 241, 13, 11, image);
+        t.drawFastHLine(17, 313, 7, color(2));
+    }
+}
+
+// Palette colors drawn into 4-bit and 1-bit framebuffers with their low
+// bits changed, mapped back to the palette and expanded on flush, against
+// the exact colors drawn directly
+static bool testIndexed() {
+    static st7789::ST7789 lcd;
+    static st7789::ST7789 direct;
+    if (!beginDisplay(lcd) || !beginDisplay(direct)) {
+        return false;
+    }
+
+    static const uint16_t palette16[16] = {
+        0x0000, 0xF800, 0x07E0, 0x001F, 0xFFE0, 0x07FF, 0xF81F, 0xFFFF,
+        0x8410, 0x4208, 0xFD20, 0x0010, 0x0400, 0x8000, 0xC618, 0x2104
+    };
+    static const uint16_t palette2[2] = { 0x0010, 0xFFE0 };
+    struct Format {
+        uint8_t bpp;
+        const uint16_t* palette;
+        const char* name;
+    };
+    const Format formats[] = {
+        { 4, palette16, "indexed 4bpp" },
+        { 1, palette2, "indexed 1bpp" },
+    };
+
+    int bad = 0;
+    for (const Format& f : formats) {
+        if (!lcd.enableIndexedFrameBuffer(f.bpp, f.palette)) {
+            printf("  %s: no framebuffer\n", f.name);
+            return false;
+        }
+        for (int stage = 0; stage < 2; stage++) {
+            drawPalette(lcd, f.palette, 1 << f.bpp, 0x0821, stage);
+            lcd.flush();
+            drawPalette(direct, f.palette, 1 << f.bpp, 0, stage);
+            bad += compareDisplays(lcd, direct, f.name);
+        }
+        lcd.disableFrameBuffer();
+    }
+    return bad == 0;
+}
+
+// Small primitive number k in cell x, y of a 4 by 5 grid. Items of a row
+// start on the same line with different heights, so consecutive windows
+// share some of their edges. Images in the outer columns and rows hang
+// over the screen edge.
+template <typename Target>
+static void drawCellItem(Target& t, int k, int16_t col, int16_t row, uint16_t color) {
+    int16_t x = col * 60 + 9 + k % 3;
+    int16_t y = row * 64 + 11 + (k / 20) % 3;
+    switch (k % 7) {
+        case 0:
+            t.fillRect(x, y, 7 + k % 4, 5 + k % 3, color);
+            break;
+        case 1:
+            t.fillCircle(x + 12, y + 12, 9, color);
+            break;
+        case 2:
+            t.fillTriangle(x, y, x + 23, y + 5, x + 7, y + 19, color);
+            break;
+        case 3:
+            t.drawString(x, y, "FB", color, st7789::BLACK, 2);
+            break;
+        case 4:
+            t.drawString(x, y, "aa", st7789::font_sans_14, color, 0x0008);
+            break;
+        case 5:
+            x = (col == 0) ? -7 : (col == 3) ? WIDTH - 9 : x;
+            y = (row == 0) ? -5 : (row == 4) ? HEIGHT - 6 : y;
+            t.drawImage(x, y, 16, 16, test_image);
+            break;
+        default:
+            t.drawLine(x, y, x + 31, y + 13, color);
+            break;
+    }
+}
+
+// Framebuffer flushed through the DMA chain: a full frame, 20 separate
+// dirty areas, more areas than the dirty list holds and an async flush,
+// each against the same drawing done directly
+static bool testFrameBuffer() {
+    static st7789::ST7789 lcd;
+    static st7789::ST7789 direct;
+    if (!beginDisplay(lcd) || !beginDisplay(direct)) {
+        return false;
+    }
+    if (!lcd.enableFrameBuffer()) {
+        return false;
+    }
+
+    int bad = 0;
+    drawMixed(lcd);
+    lcd.flush();
+    drawMixed(direct);
+    bad += compareDisplays(lcd, direct, "framebuffer frame");
+
+    const int counts[] = { 20, 20 * 3, 11 };
+    for (int stage = 0; stage < 3; stage++) {
+        for (int k = 0; k < counts[stage]; k++) {
+            int cell = k % 20;
+            uint16_t color = (uint16_t)(0x18E3 * (k + stage * 7 + 1));
+            drawCellItem(lcd, k + stage, cell % 4, cell / 4, color);
+            drawCellItem(direct, k + stage, cell % 4, cell / 4, color);
+        }
+        if (stage == 2) {
+            lcd.flushAsync();
+            lcd.hal().waitDmaIdle();
+        } else {
+            lcd.flush();
+        }
+        bad += compareDisplays(lcd, direct, "framebuffer areas");
+    }
+    lcd.disableFrameBuffer();
+    return bad == 0;
+}
+
+// Mixed scene plus images and text straddling every 16th line
+static void drawBandScene(st7789::Graphics& gfx, void* user) {
+    (void)user;
+    drawMixed(gfx);
+    for (int16_t y = 9; y < HEIGHT; y += 32) {
+        gfx.drawImage(207 + (y / 32) % 3, y, 16, 16, test_image);
+        gfx.drawString(185, y + 16, "B", st7789::WHITE, st7789::BLACK, 2);
+    }
+}
+
+// Sparse items over the band background
+static void drawBandItems(st7789::Graphics& gfx, void* user) {
+    (void)user;
+    for (int k = 0; k < 20; k++) {
+        drawCellItem(gfx, k, k % 4, k / 4, (uint16_t)(0x2945 * (k + 1)));
+    }
+}
+
+// Frames replayed through bands of 16 lines and of 13, which leaves a
+// short last band, against direct drawing
+static bool testBands() {
+    static st7789::ST7789 lcd;
+    static st7789::ST7789 direct;
+    if (!beginDisplay(lcd) || !beginDisplay(direct)) {
+        return false;
+    }
+
+    int bad = 0;
+    const uint16_t heights[] = { 16, 13 };
+    for (uint16_t height : heights) {
+        st7789::BandRenderer bands(lcd);
+        if (!bands.begin(height)) {
+            return false;
+        }
+
+        lcd.fillScreen(st7789::BLACK);
+        if (!bands.render(drawBandScene)) {
+            printf("  band render failed\n");
+            return false;
+        }
+        drawBandScene(direct.graphics(), nullptr);
+        bad += compareDisplays(lcd, direct, "band scene");
+
+        if (!bands.render(drawBandItems, nullptr, 0x0008)) {
+            printf("  band render failed\n");
+            return false;
+        }
+        direct.fillScreen(0x0008);
+        drawBandItems(direct.graphics(), nullptr);
+        bad += compareDisplays(lcd, direct, "band items");
+    }
+    return bad == 0;
+}
+
+// Checkered gradient behind the sprites
+static void spriteBackground(int16_t x, int16_t y, int16_t w, uint16_t* pixels, void* user) {
+    (void)user;
+    for (int16_t i = 0; i < w; i++) {
+        int16_t px = x + i;
+        pixels[i] = ((px ^ y) & 8) ? (uint16_t)(0x0010 + (y / 10)) : (uint16_t)(0x2104 + (px / 8));
+    }
+}
+
+// Same sprites and changes on two layers; one sends only what changed, the
+// other repaints everything. Both panels must agree after every update.
+static bool testSprites() {
+    static st7789::ST7789 lcd;
+    static st7789::ST7789 full;
+    if (!beginDisplay(lcd) || !beginDisplay(full)) {
+        return false;
+    }
+
+    // Disc on a magenta key, a ring as a mask, an opaque block and a
+    // second keyed image to switch to
+    static uint16_t disc[16 * 16];
+    static uint16_t wide[24 * 18];
+    static uint8_t ring[20 * 3];
+    static uint16_t ring_image[20 * 20];
+    for (int i = 0; i < 16 * 16; i++) {
+        int dx = i % 16 - 8, dy = i / 16 - 8;
+        disc[i] = (dx * dx + dy * dy < 49) ? st7789::YELLOW : st7789::MAGENTA;
+    }
+    for (int i = 0; i < 24 * 18; i++) {
+        wide[i] = (i % 24 < 4 || i / 24 > 14) ? (uint16_t)st7789::MAGENTA : (uint16_t)(0x8000 + i * 37);
+    }
+    for (int y = 0; y < 20; y++) {
+        for (int x = 0; x < 20; x++) {
+            int dx = x - 10, dy = y - 10;
+            bool set = dx * dx + dy * dy < 90 && dx * dx + dy * dy > 30;
+            if (set) {
+                ring[y * 3 + x / 8] |= 0x80 >> (x % 8);
+            }
+            ring_image[y * 20 + x] = (uint16_t)(0x07E0 + x * 2048 + y);
+        }
+    }
+
+    st7789::SpriteLayer a(lcd);
+    st7789::SpriteLayer b(full);
+    st7789::SpriteLayer* layers[2] = { &a, &b };
+    for (st7789::SpriteLayer* layer : layers) {
+        if (!layer->begin(4, 1000)) {
+            return false;
+        }
+        layer->setBackground(spriteBackground);
+        layer->addSprite(disc, 16, 16);
+        layer->setColorKey(0, st7789::MAGENTA);
+        layer->addSprite(ring_image, 20, 20);
+        layer->setMask(1, ring);
+        layer->addSprite(test_image, 16, 16);
+        layer->addSprite(wide, 24, 18);
+        layer->setColorKey(3, st7789::MAGENTA);
+        for (int8_t id = 0; id < 4; id++) {
+            layer->moveTo(id, 30 + id * 50, 40 + id * 60);
+            layer->show(id);
+        }
+        layer->redraw();
+    }
+
+    int bad = 0;
+    srand(99);
+    for (int step = 0; step < 300; step++) {
+        int8_t id = rand() % 4;
+        int op = rand() % 10;
+        int16_t x = rand() % 280 - 20;
+        int16_t y = rand() % 360 - 20;
+        int16_t dx = rand() % 13 - 6;
+        int16_t dy = rand() % 13 - 6;
+        bool visible = rand() % 2 == 0;
+        for (st7789::SpriteLayer* layer : layers) {
+            if (op < 6) {
+                // Mostly short steps, sometimes a jump
+                layer->moveTo(id, layer->spriteX(id) + dx, layer->spriteY(id) + dy);
+            } else if (op < 7) {
+                layer->moveTo(id, x, y);
+            } else if (op < 8) {
+                layer->show(id, visible);
+            } else if (id == 3) {
+                bool small = (step % 2) == 0;
+                layer->setImage(3, small ? disc : wide, small ? 16 : 24, small ? 16 : 18);
+            } else {
+                layer->moveTo(id, layer->spriteX(id) - dy, layer->spriteY(id) + dx);
+            }
+        }
+        if (step % 3 == 2) {
+            a.update();
+            b.redraw();
+            bad += compareDisplays(lcd, full, "sprites");
+        }
+    }
+    return bad == 0;
+}
+
+// Colored lines of varying length, some wrapping, with tabs, carriage
+// returns and backspaces
+static void printLogLine(st7789::Terminal& term, int n) {
+    term.setColor(n % 16, (n / 16) % 3 == 0 ? st7789::Terminal::TERM_BLUE : st7789::Terminal::TERM_BLACK);
+    term.printf("%03d ", n);
+    term.setColor((n * 7 + 3) % 16);
+    for (int i = 0; i < (n * 13) % 57; i++) {
+        term.putChar('a' + (n + i) % 26);
+    }
+    if (n % 5 == 0) {
+        term.print("\tx\by");
+    }
+    if (n % 11 == 0) {
+        term.print("\rR");
+    }
+    term.putChar('\n');
+}
+
+// A console under hardware scroll against the same output through the
+// framebuffer, which repaints instead. Updates come after 1 to 60 lines,
+// more than the console holds in the long gaps.
+static bool testTerminal() {
+    static st7789::ST7789 lcd;
+    static st7789::ST7789 repaint;
+    if (!beginDisplay(lcd) || !beginDisplay(repaint)) {
+        return false;
+    }
+
+    struct Layout {
+        uint8_t size;
+        int16_t top;
+        int16_t height;
+    };
+    const Layout layouts[] = {
+        { 1, 0, 0 },
+        { 2, 24, 200 },
+    };
+
+    int bad = 0;
+    for (const Layout& l : layouts) {
+        lcd.fillScreen(st7789::BLACK);
+        repaint.fillScreen(st7789::BLACK);
+        if (!repaint.enableFrameBuffer()) {
+            return false;
+        }
+
+        st7789::Terminal scrolled(lcd);
+        st7789::Terminal painted(repaint);
+        if (!scrolled.begin(l.size, l.top, l.height) || !painted.begin(l.size, l.top, l.height)) {
+            return false;
+        }
+        if (!scrolled.usesHardwareScroll() || painted.usesHardwareScroll()) {
+            printf("  unexpected scroll mode\n");
+            return false;
+        }
+
+        srand(7);
+        int n = 0;
+        while (n < 400) {
+            int lines = 1 + rand() % ((n % 3 == 0) ? 60 : 6);
+            for (int i = 0; i < lines; i++, n++) {
+                printLogLine(scrolled, n);
+                printLogLine(painted, n);
+            }
+            scrolled.update();
+            painted.update();
+            repaint.flush();
+            bad += compareDisplays(lcd, repaint, l.size == 1 ? "terminal" : "terminal size 2");
+        }
+        scrolled.end();
+        painted.end();
+        repaint.disableFrameBuffer();
+    }
+    return bad == 0;
+}
+
+// Channel of fg over bg at coverage level of max, rounded to nearest
+static uint16_t referenceBlend(uint16_t fg, uint16_t bg, int level, int max) {
+    uint16_t out = 0;
+    const int shifts[3] = { 11, 5, 0 };
+    const int masks[3] = { 0x1F, 0x3F, 0x1F };
+    for (int c = 0; c < 3; c++) {
+        int f = (fg >> shifts[c]) & masks[c];
+        int b = (bg >> shifts[c]) & masks[c];
+        out |= (uint16_t)lround(b + (double)(f - b) * level / max) << shifts[c];
+    }
+    return out;
+}
+
+// Opaque AA text into the reference, glyph by glyph from the coverage data
+static void referenceText(int16_t x, int16_t y, const char* str, const st7789::AAFont& font,
+                          uint16_t fg, uint16_t bg) {
+    int16_t width = 0;
+    for (const char* p = str; *p; p++) {
+        width += font.glyphs[*p - font.first].advance;
+    }
+    for (int16_t j = 0; j < font.line_height; j++) {
+        for (int16_t i = 0; i < width; i++) {
+            reference[(y + j) * WIDTH + x + i] = bg;
+        }
+    }
+
+    int16_t pen = 0;
+    const int max = (1 << font.bpp) - 1;
+    for (const char* p = str; *p; p++) {
+        const st7789::AAGlyph& g = font.glyphs[*p - font.first];
+        for (int row = 0; row < g.height; row++) {
+            for (int col = 0; col < g.width; col++) {
+                size_t bit = ((size_t)row * g.width + col) * font.bpp;
+                int level = (font.bitmap[g.offset + bit / 8] >> (8 - font.bpp - bit % 8)) & max;
+                int16_t px = pen + g.x_offset + col;
+                int16_t py = font.ascent + g.y_offset + row;
+                if (level > 0 && px >= 0 && px < width && py >= 0 && py < font.line_height) {
+                    reference[(y + py) * WIDTH + x + px] = referenceBlend(fg, bg, level, max);
+                }
+            }
+        }
+        pen += g.advance;
+    }
+}
+
+// Two rows of every 2-bit coverage level
+static const uint8_t levels_2bpp_bitmap[] = { 0x1B, 0xE4, 0x55, 0xFF };
+static const st7789::AAGlyph levels_2bpp_glyphs[] = { { 0, 8, 2, 10, 1, -2 } };
+static const st7789::AAFont levels_2bpp = {
+    levels_2bpp_bitmap, levels_2bpp_glyphs, 'A', 'A', 2, 4, 3, nullptr, 1, nullptr, nullptr
+};
+
+// Glyphs drawn through the blend table against a per-pixel blend of their
+// coverage, for 4-bit and 2-bit fonts and channels rising and falling
+static bool testAABlend() {
+    static st7789::ST7789 lcd;
+    if (!beginDisplay(lcd)) {
+        return false;
+    }
+
+    struct Pair {
+        uint16_t fg;
+        uint16_t bg;
+    };
+    const Pair pairs[] = {
+        { st7789::WHITE, 0x0841 },
+        { 0x3A9F, st7789::YELLOW },
+        { st7789::RED, st7789::BLUE },
+        { 0x0010, 0xC618 },
+    };
+
+    int bad = 0;
+    for (const Pair& p : pairs) {
+        lcd.fillScreen(st7789::BLACK);
+        for (int i = 0; i < WIDTH * HEIGHT; i++) {
+            reference[i] = st7789::BLACK;
+        }
+        lcd.drawString(11, 20, "Wg@&%", st7789::font_sans_14, p.fg, p.bg);
+        referenceText(11, 20, "Wg@&%", st7789::font_sans_14, p.fg, p.bg);
+        lcd.drawString(11, 60, "AA", levels_2bpp, p.fg, p.bg);
+        referenceText(11, 60, "AA", levels_2bpp, p.fg, p.bg);
+        bad += compareReference(lcd, "aa blend");
+    }
+    return bad == 0;
+}
+
+// Well-formed, malformed and truncated sequences: the codepoint and the
+// bytes consumed. A truncated sequence stops before the byte that broke it.
+static bool testUtf8() {
+    struct Case {
+        const char* str;
+        uint32_t cp;
+        int bytes;
+    };
+    const Case cases[] = {
+        { "A", 0x41, 1 },
+        { "\xC3\xA9", 0xE9, 2 },
+        { "\xE4\xB8\xAD", 0x4E2D, 3 },
+        { "\xF0\x9F\x98\x80", 0x1F600, 4 },
+        { "\xF4\x8F\xBF\xBF", 0x10FFFF, 4 },
+        { "\x80" "A", 0xFFFD, 1 },          // Lone continuation byte
+        { "\xFF" "A", 0xFFFD, 1 },          // Never a lead byte
+        { "\xC3" "A", 0xFFFD, 1 },          // Continuation missing
+        { "\xE4\xB8", 0xFFFD, 2 },          // Truncated by the end of the string
+        { "\xF0\x9F\x98", 0xFFFD, 3 },
+        { "\xC0\xAF", 0xFFFD, 2 },          // Overlong '/'
+        { "\xE0\x80\xAF", 0xFFFD, 3 },
+        { "\xF0\x80\x80\xAF", 0xFFFD, 4 },
+        { "\xED\xA0\x80", 0xFFFD, 3 },      // Surrogate
+        { "\xF4\x90\x80\x80", 0xFFFD, 4 },  // Past U+10FFFF
+    };
+
+    int bad = 0;
+    for (const Case& c : cases) {
+        const char* p = c.str;
+        uint32_t cp = st7789::decodeUtf8(p);
+        if (cp != c.cp || p - c.str != c.bytes) {
+            printf("  utf8 case %d: U+%04X after %d bytes, expected U+%04X after %d\n",
+                   (int)(&c - cases), (unsigned)cp, (int)(p - c.str), (unsigned)c.cp, c.bytes);
+            bad++;
+        }
+    }
+    return bad == 0;
+}
+
+// Index lookup of a sparse font and of a range font, hits and misses on
+// both sides of every entry
+static bool testFindGlyph() {
+    static const uint32_t codepoints[] = { 0x21, 0x41, 0x4E2D, 0x6587, 0xFF01, 0x1F600 };
+    const uint32_t count = sizeof(codepoints) / sizeof(codepoints[0]);
+    st7789::AAFont font = st7789::font_sans_14;
+    font.codepoints = codepoints;
+    font.glyph_count = count;
+
+    int bad = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (st7789::findGlyph(font, codepoints[i]) != (int32_t)i) {
+            printf("  U+%04X not found at %u\n", (unsigned)codepoints[i], (unsigned)i);
+            bad++;
+        }
+        const uint32_t misses[2] = { codepoints[i] - 1, codepoints[i] + 1 };
+        for (uint32_t miss : misses) {
+            bool listed = false;
+            for (uint32_t j = 0; j < count; j++) {
+                listed = listed || codepoints[j] == miss;
+            }
+            if (!listed && st7789::findGlyph(font, miss) != -1) {
+                printf("  U+%04X found but not in the font\n", (unsigned)miss);
+                bad++;
+            }
+        }
+    }
+    if (st7789::findGlyph(font, 0) != -1 || st7789::findGlyph(font, 0x10FFFF) != -1) {
+        printf("  codepoint outside the index found\n");
+        bad++;
+    }
+    font.glyph_count = 0;
+    if (st7789::findGlyph(font, 0x41) != -1) {
+        printf("  glyph found in an empty index\n");
+        bad++;
+    }
+
+    const st7789::AAFont& range = st7789::font_sans_14;
+    if (st7789::findGlyph(range, range.first) != 0 ||
+        st7789::findGlyph(range, range.last) != range.last - range.first ||
+        st7789::findGlyph(range, range.first - 1) != -1 ||
+        st7789::findGlyph(range, range.last + 1) != -1) {
+        printf("  range font lookup wrong\n");
+        bad++;
+    }
+    return bad == 0;
+}
+
+// Strings longer than one queued command, drawn through the pipeline against
+// direct drawing
+template <typename Target>
+static void drawLongText(Target& t) {
+    static const char* lines[] = {
+        "Status: 23.5C  48%RH  1013hPa  batt 87%",
+        "short",
+        "Wrapping text that runs past the right edge of the panel and on\nafter a newline",
+        "\xC3\xA9t\xC3\xA9 \xE4\xB8\xAD\xE6\x96\x87 caf\xC3\xA9 na\xC3\xAFve r\xC3\xA9sum\xC3\xA9 \xC3\xBC\xC3\xB6",
+    };
+    t.fillScreen(st7789::BLACK);
+    for (int i = 0; i < 4; i++) {
+        int16_t y = i * 40;
+        t.drawString(0, y, lines[i], st7789::WHITE, st7789::BLUE, 1);
+        t.drawString(0, y + 170, lines[i], st7789::font_sans_14, st7789::YELLOW, st7789::BLACK);
+    }
+    t.drawString(8, 300, lines[0], st7789::GREEN, st7789::BLACK, 2);
+}
+
+static bool testPipelineText() {
+    static st7789::ST7789 lcd;
+    static st7789::ST7789 direct;
+    if (!beginDisplay(lcd) || !beginDisplay(direct)) {
+        return false;
+    }
+
+    // A shallow ring makes the parts of one string wait for each other
+    st7789::RenderPipeline pipe(lcd);
+    if (!pipe.begin(2) || !pipe.start()) {
+        printf("  pipeline start failed\n");
+        return false;
+    }
+    drawLongText(pipe);
+    pipe.sync();
+    pipe.stop();
+    drawLongText(direct);
+    return compareDisplays(lcd, direct, "pipeline text") == 0;
+}
+
+static const TestCase tests[] = {
+    { "lines",        testLines },
+    { "display_list", testDisplayList },
+    { "scroll",       testScroll },
+    { "compressed",   testCompressedImages },
+    { "rgb444",       testRgb444 },
+    { "indexed",      testIndexed },
+    { "framebuffer",  testFrameBuffer },
+    { "bands",        testBands },
+    { "sprites",      testSprites },
+    { "terminal",     testTerminal },
+    { "aa_blend",     testAABlend },
+    { "utf8",         testUtf8 },
+    { "find_glyph",   testFindGlyph },
+    { "pipeline_text", testPipelineText },
+};
+
+int main() {
+    int failures = 0;
+    for (const TestCase& t : tests) {
+        bool ok = t.run();
+        printf("%-14s %s\n", t.name, ok ? "ok" : "FAIL");
+        if (!ok) {
+            failures++;
+        }
+    }
+    if (failures > 0) {
+        printf("%d test(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,39 @@
+// Generated by tools/image_encode.py from pattern.png, 24x16, QOI, 465 bytes (raw 768)
+
+#include <cstddef>
+#include <cstdint>
+
+extern const uint8_t pattern_qoi[] = {
+    0x53, 0x49, 0x02, 0x00, 0x18, 0x00, 0x10, 0x00, 0xA8, 0x88, 0xFD, 0xE0, 0xFE, 0x8A, 0x00, 0xC0,
+    0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0,
+    0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x96, 0x2D, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E,
+    0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x96,
+    0x2D, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0,
+    0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x96, 0x2D, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E,
+    0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E, 0xC0, 0x7E,
+    0xC0, 0x96, 0x22, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2,
+    0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2,
+    0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2,
+    0x86, 0xFE, 0x3F, 0x01, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86,
+    0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86,
+    0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86,
+    0xA2, 0x86, 0xFE, 0x5F, 0x01, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2,
+    0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2,
+    0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2,
+    0x86, 0xA2, 0x86, 0xFE, 0x7F, 0x01, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86,
+    0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86,
+    0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86, 0xA2, 0x86,
+    0xA2, 0x86, 0xA2, 0x86, 0xFE, 0x00, 0x00, 0x66, 0x6D, 0xB3, 0x21, 0xFE, 0x00, 0xF8, 0x3B, 0xFE,
+    0xC2, 0x34, 0xFE, 0xE0, 0xFF, 0x1D, 0xFE, 0x23, 0x4F, 0x19, 0x18, 0xFE, 0x84, 0x69, 0x3B, 0x19,
+    0xFE, 0xE5, 0x83, 0x1D, 0x3B, 0xFE, 0x46, 0x9E, 0x18, 0x6E, 0xFE, 0xA7, 0xB8, 0x19, 0x18, 0x3B,
+    0x19, 0xFE, 0x04, 0x4E, 0x1D, 0x3B, 0xB9, 0x46, 0x18, 0x1D, 0xFE, 0x10, 0x38, 0x19, 0x18, 0xFE,
+    0x16, 0x2D, 0x3B, 0x19, 0xFE, 0x1C, 0x22, 0x1D, 0x3B, 0x9A, 0xDD, 0x18, 0x1D, 0xFE, 0x28, 0x0C,
+    0x19, 0x18, 0xFE, 0x2E, 0x01, 0x19, 0xFE, 0x39, 0x45, 0x1D, 0x3B, 0xFE, 0xE4, 0x14, 0x18, 0x1D,
+    0xFE, 0x8F, 0xE4, 0x19, 0x18, 0xFE, 0x3A, 0xB4, 0x3B, 0x19, 0x2E, 0xFE, 0x00, 0xF8, 0x3B, 0xFE,
+    0x90, 0x53, 0x18, 0x1D, 0xFE, 0x3B, 0x23, 0x19, 0x18, 0xFE, 0xE6, 0xF2, 0x3B, 0x00, 0x1D, 0x3B,
+    0xFE, 0x50, 0xAA, 0x18, 0x1D, 0xFE, 0xA0, 0x54, 0x19, 0x18, 0xFE, 0xF0, 0xFE, 0x3B, 0x19, 0xFE,
+    0x40, 0xA9, 0x1D, 0x3B, 0x1A, 0x18, 0x1D, 0xFE, 0xE0, 0xFD, 0x19, 0x18, 0xFE, 0x30, 0xA8, 0x3B,
+    0x19,
+};
+
+extern const size_t pattern_qoi_size = sizeof(pattern_qoi);
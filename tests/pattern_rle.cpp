@@ -0,0 +1,43 @@
+// Generated by tools/image_encode.py from pattern.png, 24x16, RLE, 541 bytes (raw 768)
+
+#include <cstddef>
+#include <cstdint>
+
+extern const uint8_t pattern_rle[] = {
+    0x53, 0x49, 0x01, 0x00, 0x18, 0x00, 0x10, 0x00, 0xDF, 0x04, 0x21, 0x81, 0x8A, 0x00, 0x81, 0xAA,
+    0x08, 0x81, 0xCA, 0x10, 0x81, 0xEA, 0x18, 0x81, 0x0A, 0x21, 0x81, 0x2A, 0x29, 0x81, 0x4A, 0x31,
+    0x81, 0x6A, 0x39, 0x81, 0x8A, 0x41, 0x81, 0xAA, 0x49, 0x81, 0xCA, 0x51, 0x81, 0xEA, 0x59, 0x81,
+    0xAA, 0x00, 0x81, 0xCA, 0x08, 0x81, 0xEA, 0x10, 0x81, 0x0A, 0x19, 0x81, 0x2A, 0x21, 0x81, 0x4A,
+    0x29, 0x81, 0x6A, 0x31, 0x81, 0x8A, 0x39, 0x81, 0xAA, 0x41, 0x81, 0xCA, 0x49, 0x81, 0xEA, 0x51,
+    0x81, 0x0A, 0x5A, 0x81, 0xCA, 0x00, 0x81, 0xEA, 0x08, 0x81, 0x0A, 0x11, 0x81, 0x2A, 0x19, 0x81,
+    0x4A, 0x21, 0x81, 0x6A, 0x29, 0x81, 0x8A, 0x31, 0x81, 0xAA, 0x39, 0x81, 0xCA, 0x41, 0x81, 0xEA,
+    0x49, 0x81, 0x0A, 0x52, 0x81, 0x2A, 0x5A, 0x81, 0xEA, 0x00, 0x81, 0x0A, 0x09, 0x81, 0x2A, 0x11,
+    0x81, 0x4A, 0x19, 0x81, 0x6A, 0x21, 0x81, 0x8A, 0x29, 0x81, 0xAA, 0x31, 0x81, 0xCA, 0x39, 0x81,
+    0xEA, 0x41, 0x81, 0x0A, 0x4A, 0x81, 0x2A, 0x52, 0x81, 0x4A, 0x5A, 0x7F, 0x1F, 0x01, 0x5E, 0x09,
+    0x9D, 0x11, 0xDC, 0x19, 0x1B, 0x22, 0x5A, 0x2A, 0x99, 0x32, 0xD8, 0x3A, 0x17, 0x43, 0x56, 0x4B,
+    0x95, 0x53, 0xD4, 0x5B, 0x13, 0x64, 0x52, 0x6C, 0x91, 0x74, 0xD0, 0x7C, 0x0F, 0x85, 0x4E, 0x8D,
+    0x8D, 0x95, 0xCC, 0x9D, 0x0B, 0xA6, 0x4A, 0xAE, 0x89, 0xB6, 0xC8, 0xBE, 0x3F, 0x01, 0x7E, 0x09,
+    0xBD, 0x11, 0xFC, 0x19, 0x3B, 0x22, 0x7A, 0x2A, 0xB9, 0x32, 0xF8, 0x3A, 0x37, 0x43, 0x76, 0x4B,
+    0xB5, 0x53, 0xF4, 0x5B, 0x33, 0x64, 0x72, 0x6C, 0xB1, 0x74, 0xF0, 0x7C, 0x2F, 0x85, 0x6E, 0x8D,
+    0xAD, 0x95, 0xEC, 0x9D, 0x2B, 0xA6, 0x6A, 0xAE, 0xA9, 0xB6, 0xE8, 0xBE, 0x5F, 0x01, 0x9E, 0x09,
+    0xDD, 0x11, 0x1C, 0x1A, 0x5B, 0x22, 0x9A, 0x2A, 0xD9, 0x32, 0x18, 0x3B, 0x57, 0x43, 0x96, 0x4B,
+    0xD5, 0x53, 0x14, 0x5C, 0x53, 0x64, 0x92, 0x6C, 0xD1, 0x74, 0x10, 0x7D, 0x4F, 0x85, 0x8E, 0x8D,
+    0xCD, 0x95, 0x0C, 0x9E, 0x4B, 0xA6, 0x8A, 0xAE, 0xC9, 0xB6, 0x08, 0xBF, 0x7F, 0x01, 0xBE, 0x09,
+    0xFD, 0x11, 0x3C, 0x1A, 0x7B, 0x22, 0xBA, 0x2A, 0xF9, 0x32, 0x38, 0x3B, 0x77, 0x43, 0xB6, 0x4B,
+    0xF5, 0x53, 0x34, 0x5C, 0x73, 0x64, 0xB2, 0x6C, 0xF1, 0x74, 0x30, 0x7D, 0x6F, 0x85, 0xAE, 0x8D,
+    0xED, 0x95, 0x2C, 0x9E, 0x6B, 0xA6, 0xAA, 0xAE, 0xE9, 0xB6, 0x28, 0xBF, 0x00, 0x00, 0xE0, 0x07,
+    0x1F, 0x00, 0x61, 0x1A, 0x00, 0xF8, 0xE0, 0x07, 0xC2, 0x34, 0xE0, 0xFF, 0x00, 0xF8, 0x23, 0x4F,
+    0x1F, 0x00, 0xE0, 0xFF, 0x84, 0x69, 0xE0, 0x07, 0x1F, 0x00, 0xE5, 0x83, 0x00, 0xF8, 0xE0, 0x07,
+    0x46, 0x9E, 0xE0, 0xFF, 0x00, 0xF8, 0xA7, 0xB8, 0x1F, 0x00, 0xE0, 0xFF, 0xE0, 0x07, 0x1F, 0x00,
+    0x04, 0x4E, 0x00, 0xF8, 0xE0, 0x07, 0x0A, 0x43, 0xE0, 0xFF, 0x00, 0xF8, 0x3F, 0x10, 0x38, 0x1F,
+    0x00, 0xE0, 0xFF, 0x16, 0x2D, 0xE0, 0x07, 0x1F, 0x00, 0x1C, 0x22, 0x00, 0xF8, 0xE0, 0x07, 0x22,
+    0x17, 0xE0, 0xFF, 0x00, 0xF8, 0x28, 0x0C, 0x1F, 0x00, 0xE0, 0xFF, 0x2E, 0x01, 0x1F, 0x00, 0x39,
+    0x45, 0x00, 0xF8, 0xE0, 0x07, 0xE4, 0x14, 0xE0, 0xFF, 0x00, 0xF8, 0x8F, 0xE4, 0x1F, 0x00, 0xE0,
+    0xFF, 0x3A, 0xB4, 0xE0, 0x07, 0x1F, 0x00, 0xE5, 0x83, 0x00, 0xF8, 0xE0, 0x07, 0x90, 0x53, 0xE0,
+    0xFF, 0x00, 0xF8, 0x3B, 0x23, 0x1F, 0x00, 0xE0, 0xFF, 0xE6, 0xF2, 0xE0, 0x07, 0x00, 0x00, 0x00,
+    0xF8, 0xE0, 0x07, 0x50, 0xAA, 0xE0, 0xFF, 0x00, 0xF8, 0xA0, 0x54, 0x1F, 0x00, 0xE0, 0xFF, 0xF0,
+    0xFE, 0xE0, 0x07, 0x1F, 0x00, 0x40, 0xA9, 0x00, 0xF8, 0xE0, 0x07, 0x90, 0x53, 0xE0, 0xFF, 0x00,
+    0xF8, 0xE0, 0xFD, 0x1F, 0x00, 0xE0, 0xFF, 0x30, 0xA8, 0xE0, 0x07, 0x1F, 0x00,
+};
+
+extern const size_t pattern_rle_size = sizeof(pattern_rle);
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""Convert a TrueType/OpenType font to an anti-aliased st7789::AAFont.
+
+Glyphs are rendered with Pillow at the requested pixel size, cropped to
+their bounding box and quantized to 2 or 4 bits of coverage per pixel.
+The output is a C++ source file defining a `const st7789::AAFont`; declare
+it elsewhere with `extern const st7789::AAFont <name>;`.
+
+A contiguous character set becomes a range font. Any other set, e.g. the
+characters of a CJK text file, gets a sorted codepoint index. With
+--bitmap-out the coverage data goes to a separate binary file for external
+storage; such fonts are generated non-const and need their read function
+set before drawing.
+
+Usage:
+    font_convert.py FONT.ttf SIZE NAME [--bpp 4] [--first 32] [--last 126]
+                    [--text STR] [--text-file FILE] [--bitmap-out FILE.bin]
+                    [--notice TEXT] [-o out.cpp]
+"""
+
+import argparse
+import sys
+
+from PIL import Image, ImageDraw, ImageFont
+
+
+def render_glyph(font, ch, ascent, bpp):
+    """Return (width, height, advance, x_offset, y_offset, levels) for one glyph."""
+    advance = int(round(font.getlength(ch)))
+    x0, y0, x1, y1 = font.getbbox(ch)
+    if x1 <= x0 or y1 <= y0:
+        return 0, 0, advance, 0, 0, []
+
+    img = Image.new("L", (x1 - x0, y1 - y0), 0)
+    ImageDraw.Draw(img).text((-x0, -y0), ch, font=font, fill=255)
+
+    # Trim rows and columns without coverage
+    bbox = img.getbbox()
+    if bbox is None:
+        return 0, 0, advance, 0, 0, []
+    img = img.crop(bbox)
+    x0 += bbox[0]
+    y0 += bbox[1]
+
+    top = (1 << bpp) - 1
+    levels = [(p * top + 127) // 255 for p in img.tobytes()]
+    # Offsets relative to the pen position on the baseline
+    return img.width, img.height, advance, x0, y0 - ascent, levels
+
+
+def pack(levels, bpp):
+    """Pack coverage values MSB first, glyph rows back to back."""
+    out = bytearray()
+    per_byte = 8 // bpp
+    for i in range(0, len(levels), per_byte):
+        byte = 0
+        chunk = levels[i:i + per_byte]
+        for j in range(per_byte):
+            value = chunk[j] if j < len(chunk) else 0
+            byte |= value << (8 - bpp * (j + 1))
+        out.append(byte)
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("font")
+    parser.add_argument("size", type=int, help="pixel size")
+    parser.add_argument("name", help="C++ identifier of the generated font")
+    parser.add_argument("--bpp", type=int, choices=(2, 4), default=4)
+    parser.add_argument("--first", type=int, default=32)
+    parser.add_argument("--last", type=int, default=126)
+    parser.add_argument("--text", default="", help="also include the characters of this string")
+    parser.add_argument("--text-file", help="also include the characters of this UTF-8 file")
+    parser.add_argument("--bitmap-out", help="write coverage data to this file instead of the source")
+    parser.add_argument("--notice", action="append", default=[],
+                        help="copyright/license line copied into the output, may repeat")
+    parser.add_argument("-o", "--output", help="output file, stdout if omitted")
+    args = parser.parse_args()
+
+    font = ImageFont.truetype(args.font, args.size)
+    ascent, descent = font.getmetrics()
+
+    chars = set(range(args.first, args.last + 1))
+    extra = args.text
+    if args.text_file:
+        with open(args.text_file, encoding="utf-8") as f:
+            extra += f.read()
+    chars |= {ord(ch) for ch in extra if ch.isprintable()}
+    codes = sorted(chars)
+    indexed = codes[-1] - codes[0] + 1 != len(codes)
+
+    glyphs = []
+    bitmap = bytearray()
+    for code in codes:
+        w, h, adv, xo, yo, levels = render_glyph(font, chr(code), ascent, args.bpp)
+        if not (0 <= w < 256 and 0 <= h < 256 and adv < 256 and -128 <= xo < 128 and -128 <= yo < 128):
+            sys.exit("glyph U+%04X does not fit the format" % code)
+        glyphs.append((len(bitmap), w, h, adv, xo, yo, code))
+        bitmap += pack(levels, args.bpp)
+
+    lines = []
+    lines.append("// Generated by tools/font_convert.py from %s, %dpx, %d bpp"
+                 % (args.font.replace("\\", "/").split("/")[-1], args.size, args.bpp))
+    for notice in args.notice:
+        lines.append("// " + notice)
+    lines.append("")
+    lines.append('#include "st7789_aa_font.hpp"')
+    lines.append("")
+    lines.append("namespace st7789 {")
+    lines.append("")
+    if args.bitmap_out:
+        with open(args.bitmap_out, "wb") as f:
+            f.write(bitmap)
+        lines.append("// Coverage data (%d bytes) is in %s" % (len(bitmap), args.bitmap_out.replace("\\", "/").split("/")[-1]))
+        lines.append("")
+    else:
+        lines.append("static const uint8_t %s_bitmap[] = {" % args.name)
+        for i in range(0, len(bitmap), 16):
+            lines.append("    " + ", ".join("0x%02X" % b for b in bitmap[i:i + 16]) + ",")
+        lines.append("};")
+        lines.append("")
+    lines.append("static const AAGlyph %s_glyphs[] = {" % args.name)
+    for offset, w, h, adv, xo, yo, code in glyphs:
+        if code < 0x80:
+            label = "'%s'" % chr(code) if chr(code) != "\\" else "backslash"
+        else:
+            label = "U+%04X" % code
+        lines.append("    { %5d, %2d, %2d, %2d, %3d, %3d },  // %s" % (offset, w, h, adv, xo, yo, label))
+    lines.append("};")
+    lines.append("")
+    if indexed:
+        lines.append("static const uint32_t %s_codepoints[] = {" % args.name)
+        for i in range(0, len(codes), 8):
+            lines.append("    " + ", ".join("0x%04X" % c for c in codes[i:i + 8]) + ",")
+        lines.append("};")
+        lines.append("")
+    # External bitmap fonts stay writable so the read function can be set
+    lines.append("%sAAFont %s = {" % ("" if args.bitmap_out else "extern const ", args.name))
+    lines.append("    %s," % ("nullptr" if args.bitmap_out else args.name + "_bitmap"))
+    lines.append("    %s_glyphs," % args.name)
+    if indexed:
+        lines.append("    0, 0,        // first, last (indexed)")
+    else:
+        lines.append("    0x%02X, 0x%02X,  // first, last" % (codes[0], codes[-1]))
+    lines.append("    %d,           // bpp" % args.bpp)
+    lines.append("    %d,          // line_height" % (ascent + descent))
+    lines.append("    %d,          // ascent" % ascent)
+    if indexed:
+        lines.append("    %s_codepoints," % args.name)
+    else:
+        lines.append("    nullptr,     // codepoints")
+    lines.append("    %d,          // glyph_count" % len(codes))
+    lines.append("    nullptr,     // read%s" % (", set before drawing" if args.bitmap_out else ""))
+    lines.append("    nullptr      // read_user")
+    lines.append("};")
+    lines.append("")
+    lines.append("} // namespace st7789")
+
+    text = "\n".join(lines) + "\n"
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+"""Convert an image to a compressed blob for Graphics::drawImageCompressed().
+
+The image is loaded with Pillow, reduced to RGB565 and encoded as RLE or
+QOI-style ops; the stream formats are described in st7789_image.hpp. With
+--codec auto the smaller of the two is kept. The output is a C++ source
+file defining `const uint8_t <name>[]` and `const size_t <name>_size`;
+declare them elsewhere with `extern`. With --bin the raw blob is written
+instead, e.g. for external flash.
+
+Usage:
+    image_encode.py IMAGE NAME [--codec auto|rle|qoi] [--bin] [-o out.cpp]
+"""
+
+import argparse
+import struct
+import sys
+
+from PIL import Image
+
+CODEC_RLE = 1
+CODEC_QOI = 2
+
+
+def to_rgb565(img):
+    """Return the pixels of img as RGB565 values in row order."""
+    rgb = img.convert("RGB").tobytes()
+    return [((rgb[i] >> 3) << 11) | ((rgb[i + 1] >> 2) << 5) | (rgb[i + 2] >> 3)
+            for i in range(0, len(rgb), 3)]
+
+
+def encode_rle(pixels):
+    """Runs of a repeated pixel and spans of literal pixels, 1..128 each."""
+    out = bytearray()
+    i = 0
+    n = len(pixels)
+    while i < n:
+        run = 1
+        while i + run < n and run < 128 and pixels[i + run] == pixels[i]:
+            run += 1
+        if run >= 2:
+            out.append(0x80 | (run - 1))
+            out += struct.pack("<H", pixels[i])
+            i += run
+            continue
+
+        # Literals up to the next run of three
+        start = i
+        while i < n and i - start < 128:
+            if i + 2 < n and pixels[i] == pixels[i + 1] == pixels[i + 2]:
+                break
+            i += 1
+        out.append(i - start - 1)
+        for p in pixels[start:i]:
+            out += struct.pack("<H", p)
+    return out
+
+
+def qoi_hash(p):
+    return ((p >> 11) * 3 + ((p >> 5) & 0x3F) * 5 + (p & 0x1F) * 7) % 64
+
+
+def encode_qoi(pixels):
+    """QOI ops adapted to 5/6/5-bit channels."""
+    out = bytearray()
+    index = [0] * 64
+    prev = 0
+    run = 0
+
+    def flush_run():
+        nonlocal run
+        if run:
+            out.append(0xC0 | (run - 1))
+            index[qoi_hash(prev)] = prev
+            run = 0
+
+    for p in pixels:
+        if p == prev:
+            run += 1
+            if run == 62:
+                flush_run()
+            continue
+        flush_run()
+
+        h = qoi_hash(p)
+        if index[h] == p:
+            out.append(h)
+        else:
+            # Channel differences, wrapped to signed
+            dr = (((p >> 11) - (prev >> 11) + 16) & 0x1F) - 16
+            dg = ((((p >> 5) & 0x3F) - ((prev >> 5) & 0x3F) + 32) & 0x3F) - 32
+            db = (((p & 0x1F) - (prev & 0x1F) + 16) & 0x1F) - 16
+            dr_dg = dr - (dg >> 1)
+            db_dg = db - (dg >> 1)
+            if -2 <= dr <= 1 and -2 <= dg <= 1 and -2 <= db <= 1:
+                out.append(0x40 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2))
+            elif -8 <= dr_dg <= 7 and -8 <= db_dg <= 7:
+                out.append(0x80 | (dg + 32))
+                out.append(((dr_dg + 8) << 4) | (db_dg + 8))
+            else:
+                out.append(0xFE)
+                out += struct.pack("<H", p)
+        index[h] = p
+        prev = p
+    flush_run()
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("image")
+    parser.add_argument("name", help="C++ identifier of the generated blob")
+    parser.add_argument("--codec", choices=("auto", "rle", "qoi"), default="auto")
+    parser.add_argument("--bin", action="store_true", help="write the raw blob instead of C++ source")
+    parser.add_argument("-o", "--output", help="output file, stdout if omitted")
+    args = parser.parse_args()
+
+    img = Image.open(args.image)
+    width, height = img.size
+    if not (0 < width < 65536 and 0 < height < 65536):
+        sys.exit("image size does not fit the format")
+    pixels = to_rgb565(img)
+
+    streams = {}
+    if args.codec in ("auto", "rle"):
+        streams[CODEC_RLE] = encode_rle(pixels)
+    if args.codec in ("auto", "qoi"):
+        streams[CODEC_QOI] = encode_qoi(pixels)
+    codec = min(streams, key=lambda c: len(streams[c]))
+    blob = b"SI" + bytes((codec, 0)) + struct.pack("<HH", width, height) + streams[codec]
+
+    if args.bin:
+        if not args.output:
+            sys.exit("--bin needs an output file")
+        with open(args.output, "wb") as f:
+            f.write(blob)
+        return
+
+    lines = []
+    lines.append("// Generated by tools/image_encode.py from %s, %dx%d, %s, %d bytes (raw %d)"
+                 % (args.image.replace("\\", "/").split("/")[-1], width, height,
+                    "RLE" if codec == CODEC_RLE else "QOI", len(blob), width * height * 2))
+    lines.append("")
+    lines.append("#include <cstddef>")
+    lines.append("#include <cstdint>")
+    lines.append("")
+    lines.append("extern const uint8_t %s[] = {" % args.name)
+    for i in range(0, len(blob), 16):
+        lines.append("    " + ", ".join("0x%02X" % b for b in blob[i:i + 16]) + ",")
+    lines.append("};")
+    lines.append("")
+    lines.append("extern const size_t %s_size = sizeof(%s);" % (args.name, args.name))
+
+    text = "\n".join(lines) + "\n"
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()